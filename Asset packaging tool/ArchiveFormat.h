@@ -5,28 +5,89 @@
 #pragma pack(push,1)
 struct PakHeader {
     char     magic[8];      // "PIXPAK\0"
-    uint32_t version;       // 1 or 2
+    uint32_t version;       // 1, 2 or 3
     uint32_t fileCount;
     uint64_t tocOffset;
     uint32_t flags;         // 0
     uint32_t alignment;     // 16 / 4096 Ȃ
-    uint8_t  reserved[32];  // 0
+    uint64_t dictOffset;    // AssetFlag_Dictionary : L̈ʒu (wb_)
+    uint32_t dictSize;      //   V oCg (kLZ4DictMaxSize ȉ)
+    uint32_t dictCrc32;     //   V CRC32
+    uint8_t  reserved[16];  // 0
 };
+static_assert(sizeof(PakHeader) == 64, "PakHeader size");
 #pragma pack(pop)
 
 // k
 enum class AssetCompression : uint16_t {
     None = 0,
     LZ4 = 1,
+    LZ4Dict = 2, // A[JCuL̎QƂ LZ4  1 ubN (t@Cp, `Nł͂Ȃ)
 };
 
+// LZ4 Gg̃yC[h̓`N:
+//   [uint32 header][data] ... (originalSize ɒB܂)
+//   header ̉ 31bit = data ̃oCg, ŏ bit = 񈳏k`N
+//   e`N͓WJ kLZ4ChunkSize oCg (Ō̃`N̂ݒ[)
+constexpr uint32_t kLZ4ChunkSize = 256 * 1024;
+constexpr uint32_t kLZ4ChunkRawFlag = 0x80000000u;
+
+// LZ4Dict ̎̏ (LZ4 ̃}b` 64KB O͎QƂłȂ)B
+// LZ4Dict Gg̓WJTCY kLZ4ChunkSize ȉ
+constexpr uint32_t kLZ4DictMaxSize = 64 * 1024;
+
 // tO
 enum AssetFlags : uint16_t {
     AssetFlag_None = 0,
     AssetFlag_Encrypted = 1 << 0,
     AssetFlag_Streamable = 1 << 1,
     AssetFlag_PatchData = 1 << 2,
+    AssetFlag_StdSHA256 = 1 << 3,  // TOC  sha256 W SHA-256 (ȑO͔W̒l)
+    AssetFlag_Dictionary = 1 << 4, // wb_ dictOffset / dictSize  LZ4Dict p̋L
 };
 inline bool HasFlag(uint16_t f, AssetFlags bit) {
     return (f & static_cast<uint16_t>(bit)) != 0;
-}
\ No newline at end of file
+}
+
+// ---- TOC v3 ----
+// tocOffset (8 oCgE) :
+//   PakTocHeaderV3
+//   PakTocEntryV3 * entryCount   (pathHash , nbV͖O)
+//   v[                 (eGg nameOffset / nameLen ŎQ, I[ '\0' )
+// Œ蒷Ȃ̂Ń}bv܂ܓ񕪒TłA}Eg̃p[XmۂvȂ
+struct PakTocHeaderV3 {
+    uint32_t entryCount;
+    uint32_t entryStride;       // sizeof(PakTocEntryV3)
+    uint64_t stringPoolOffset;  // tocOffset ̑Έʒu
+    uint64_t stringPoolSize;
+    uint64_t reserved;
+};
+static_assert(sizeof(PakTocHeaderV3) == 32, "PakTocHeaderV3 size");
+
+struct PakTocEntryV3 {
+    uint64_t pathHash;          // PakPathHash(path)
+    uint32_t nameOffset;        // v[̈ʒu
+    uint16_t nameLen;
+    uint8_t  compression;       // AssetCompression
+    uint8_t  flags;             // 0 (\)
+    uint32_t crc32;
+    uint32_t reserved;
+    uint64_t originalSize;
+    uint64_t storedSize;
+    uint64_t offset;
+    uint8_t  sha256[32];
+};
+static_assert(sizeof(PakTocEntryV3) == 80, "PakTocEntryV3 size");
+
+// pX  64bit nbV (FNV-1a)B'\\'  '/'  ASCII Kpɑ΂ČvZ
+constexpr uint64_t PakPathHash(const char* s, size_t n) {
+    uint64_t h = 14695981039346656037ull;
+    for (size_t i = 0; i < n; ++i) {
+        char c = s[i];
+        if (c == '\\') c = '/';
+        else if (c >= 'A' && c <= 'Z') c = (char)(c - 'A' + 'a');
+        h ^= (uint8_t)c;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
@@ -0,0 +1,113 @@
+#include "DictBench.h"
+#include "DictTrainer.h"
+#include "LZ4Util.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+struct MethodResult {
+    const char* name = "";
+    uint64_t stored = 0;
+    uint64_t decodeNs = 0; // 全周回の合計
+    bool ok = true;
+};
+
+uint64_t NowNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+int RunDictBench(const std::vector<std::vector<uint8_t>>& files,
+    const std::vector<std::vector<uint8_t>>& samples, const DictBenchOptions& opt) {
+    if (files.empty()) {
+        std::cout << "対象 (" << opt.maxFileSize << " bytes 以下) のファイルがありません\n";
+        return 1;
+    }
+    uint64_t original = 0;
+    size_t maxLen = 0;
+    for (const auto& f : files) {
+        original += f.size();
+        maxLen = std::max(maxLen, f.size());
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<uint8_t> dict = TrainDictionary(samples, opt.dictSize);
+    double trainMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+    // 各方式で格納データを作る (パック時と同じく縮まなければ元データのまま格納する)
+    std::vector<std::vector<uint8_t>> lz4(files.size()), dicted(files.size());
+    std::vector<bool> lz4Raw(files.size(), false), dictRaw(files.size(), false);
+    std::vector<uint8_t> block(LZ4Util::CompressBound(maxLen));
+    for (size_t i = 0; i < files.size(); ++i) {
+        const auto& f = files[i];
+        LZ4Util::CompressChunked(f.data(), f.size(), lz4[i]);
+        size_t c = LZ4Util::CompressBlockDict(dict.data(), dict.size(), f.data(), f.size(), block.data(), block.size());
+        if (c == 0 || c >= f.size()) dictRaw[i] = true;
+        else dicted[i].assign(block.begin(), block.begin() + c);
+        if (lz4[i].size() >= f.size()) lz4Raw[i] = true;
+    }
+
+    MethodResult none{ "None" }, plain{ "LZ4" }, withDict{ "LZ4Dict" };
+    for (size_t i = 0; i < files.size(); ++i) {
+        none.stored += files[i].size();
+        plain.stored += lz4Raw[i] ? files[i].size() : lz4[i].size();
+        withDict.stored += dictRaw[i] ? files[i].size() : dicted[i].size();
+    }
+
+    // 展開結果を先に確かめておき、計測の周回では比較しない
+    std::vector<uint8_t> out(maxLen);
+    for (size_t i = 0; i < files.size(); ++i) {
+        const auto& f = files[i];
+        if (!lz4Raw[i] && (!LZ4Util::DecompressChunked(lz4[i].data(), lz4[i].size(), out.data(), f.size()) ||
+            memcmp(out.data(), f.data(), f.size()) != 0)) plain.ok = false;
+        if (!dictRaw[i] && (!LZ4Util::DecompressBlockDict(dict.data(), dict.size(), dicted[i].data(), dicted[i].size(),
+            out.data(), f.size()) || memcmp(out.data(), f.data(), f.size()) != 0)) withDict.ok = false;
+    }
+
+    // 展開速度 (None は展開先へのコピー)
+    for (int r = 0; r < opt.rounds; ++r) {
+        uint64_t a = NowNs();
+        for (const auto& f : files) memcpy(out.data(), f.data(), f.size());
+        uint64_t b = NowNs();
+        for (size_t i = 0; i < files.size(); ++i) {
+            const auto& f = files[i];
+            if (lz4Raw[i]) memcpy(out.data(), f.data(), f.size());
+            else LZ4Util::DecompressChunked(lz4[i].data(), lz4[i].size(), out.data(), f.size());
+        }
+        uint64_t c = NowNs();
+        for (size_t i = 0; i < files.size(); ++i) {
+            const auto& f = files[i];
+            if (dictRaw[i]) memcpy(out.data(), f.data(), f.size());
+            else LZ4Util::DecompressBlockDict(dict.data(), dict.size(), dicted[i].data(), dicted[i].size(),
+                out.data(), f.size());
+        }
+        uint64_t d = NowNs();
+        none.decodeNs += b - a;
+        plain.decodeNs += c - b;
+        withDict.decodeNs += d - c;
+    }
+
+    std::cout << "対象: " << files.size() << " files (<= " << opt.maxFileSize << " bytes), " << original << " bytes\n";
+    std::cout << "辞書: " << dict.size() << " bytes (" << samples.size() << " samples, " << std::fixed
+        << std::setprecision(1) << trainMs << " ms)\n";
+    std::cout << "  " << std::left << std::setw(9) << "method" << std::right << std::setw(12) << "stored"
+        << std::setw(9) << "ratio" << std::setw(12) << "+dict" << std::setw(12) << "decode MB/s"
+        << std::setw(12) << "ns/file" << "\n";
+    for (const MethodResult* m : { &none, &plain, &withDict }) {
+        // 辞書はアーカイブに 1 つだけ置くが、格納サイズの比較には含める
+        uint64_t withHeader = m->stored + (m == &withDict ? dict.size() : 0);
+        double sec = m->decodeNs / 1e9;
+        std::cout << "  " << std::left << std::setw(9) << m->name << std::right << std::setw(12) << m->stored
+            << std::setw(8) << std::setprecision(1) << (double)m->stored / original * 100.0 << "%"
+            << std::setw(12) << withHeader
+            << std::setw(12) << std::setprecision(0) << (sec > 0 ? original * (double)opt.rounds / (1024.0 * 1024.0) / sec : 0.0)
+            << std::setw(12) << std::setprecision(0) << (double)m->decodeNs / opt.rounds / files.size()
+            << (m->ok ? "" : "  (展開失敗)") << "\n";
+    }
+    return (plain.ok && withDict.ok) ? 0 : 1;
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+struct DictBenchOptions {
+    size_t dictSize = 64 * 1024;      // 学習する辞書のバイト数
+    uint64_t maxFileSize = 16 * 1024; // 対象にするファイルの上限サイズ
+    int rounds = 20;                  // 展開速度を測る周回数
+};
+
+// 小さいファイル群を None / LZ4 (チャンク列) / LZ4Dict (共有辞書付き 1 ブロック) で格納した場合の
+// 格納サイズと展開速度を表示する。辞書は samples から学習する。戻り値は終了コード
+int RunDictBench(const std::vector<std::vector<uint8_t>>& files,
+    const std::vector<std::vector<uint8_t>>& samples, const DictBenchOptions& opt);
@@ -0,0 +1,106 @@
+#include "DictTrainer.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+    constexpr size_t kDmer = 8;          // 一致を数える単位 (LZ4 の最小マッチ 4 バイトより長めに取る)
+    constexpr int kTableLog = 20;
+    constexpr size_t kSegment = 1024;    // 辞書へ入れる区間の長さ
+    constexpr uint32_t kNoHash = 0xFFFFFFFFu;
+
+    uint32_t DmerHash(const uint8_t* p) {
+        uint64_t v;
+        memcpy(&v, p, 8);
+        return (uint32_t)((v * 0x9E3779B97F4A7C15ull) >> (64 - kTableLog));
+    }
+
+    struct Segment {
+        size_t begin = 0;
+        uint64_t score = 0;
+    };
+
+} // namespace
+
+std::vector<uint8_t> TrainDictionary(const std::vector<std::vector<uint8_t>>& samples, size_t dictSize) {
+    std::vector<uint8_t> data;
+    size_t total = 0;
+    for (const auto& s : samples) total += s.size();
+    data.reserve(total);
+    for (const auto& s : samples) data.insert(data.end(), s.begin(), s.end());
+    if (data.size() <= dictSize) return data;
+
+    // 位置毎の dmer ハッシュ (サンプルを跨ぐ位置は kNoHash) と、各ハッシュを含むサンプル数
+    const size_t tableSize = (size_t)1 << kTableLog;
+    std::vector<uint32_t> hashes(data.size(), kNoHash);
+    std::vector<uint32_t> freq(tableSize, 0);
+    std::vector<uint32_t> lastSample(tableSize, kNoHash);
+    size_t pos = 0;
+    for (size_t si = 0; si < samples.size(); ++si) {
+        const size_t n = samples[si].size();
+        for (size_t i = 0; i + kDmer <= n; ++i) {
+            uint32_t h = DmerHash(data.data() + pos + i);
+            hashes[pos + i] = h;
+            // 1 つのファイル内の繰り返しは LZ4 自身が拾うので、含むファイル数で数える
+            if (lastSample[h] != (uint32_t)si) {
+                lastSample[h] = (uint32_t)si;
+                ++freq[h];
+            }
+        }
+        pos += n;
+    }
+
+    // サンプル全体を区間数と同じ数のエポックに分け、各エポックから最もスコアの高い区間を 1 つ選ぶ。
+    // 選んだ区間の dmer は以後のスコアに数えない (同じ内容を何度も辞書へ入れない)
+    const size_t segment = std::min(kSegment, dictSize);
+    const size_t window = segment - kDmer + 1;
+    size_t epochs = std::max<size_t>(1, dictSize / segment);
+    epochs = std::min(epochs, std::max<size_t>(1, data.size() / segment));
+    const size_t epochSize = data.size() / epochs;
+
+    std::vector<uint16_t> active(tableSize, 0);
+    std::vector<Segment> chosen;
+    for (size_t e = 0; e < epochs; ++e) {
+        const size_t begin = e * epochSize;
+        const size_t end = (e + 1 == epochs) ? data.size() : begin + epochSize;
+        if (end - begin < segment) continue;
+
+        Segment best;
+        uint64_t score = 0;
+        auto add = [&](size_t p) {
+            uint32_t h = hashes[p];
+            if (h != kNoHash && active[h]++ == 0) score += freq[h];
+        };
+        auto remove = [&](size_t p) {
+            uint32_t h = hashes[p];
+            if (h != kNoHash && --active[h] == 0) score -= freq[h];
+        };
+        for (size_t p = begin; p < begin + window; ++p) add(p);
+        best = Segment{ begin, score };
+        for (size_t s = begin + 1; s + segment <= end; ++s) {
+            remove(s - 1);
+            add(s + window - 1);
+            if (score > best.score) best = Segment{ s, score };
+        }
+        // 窓に残った分を戻す
+        for (size_t p = end - segment; p < end - segment + window; ++p) remove(p);
+
+        if (best.score == 0) continue;
+        chosen.push_back(best);
+        for (size_t p = best.begin; p < best.begin + window; ++p) {
+            if (hashes[p] != kNoHash) freq[hashes[p]] = 0;
+        }
+    }
+
+    // スコアの低い区間から並べ、高い区間を末尾に置く
+    std::sort(chosen.begin(), chosen.end(), [](const Segment& a, const Segment& b) {
+        return a.score != b.score ? a.score < b.score : a.begin < b.begin;
+    });
+    std::vector<uint8_t> dict;
+    dict.reserve(dictSize);
+    size_t skip = chosen.size() * segment > dictSize ? (chosen.size() * segment - dictSize + segment - 1) / segment : 0;
+    for (size_t i = skip; i < chosen.size(); ++i) {
+        dict.insert(dict.end(), data.begin() + chosen[i].begin, data.begin() + chosen[i].begin + segment);
+    }
+    return dict;
+}
@@ -0,0 +1,9 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// LZ4Dict 用の共有辞書を小さいファイルのサンプルから作る (zstd の COVER と同じ考え方)。
+// 多くのサンプルに共通して現れる 8 バイト列を多く含む区間を選んで並べる。
+// 出力は最大 dictSize バイトで、スコアの高い区間ほど末尾 (圧縮対象の直前で距離が近い側) に置く
+std::vector<uint8_t> TrainDictionary(const std::vector<std::vector<uint8_t>>& samples, size_t dictSize);
@@ -1,35 +1,242 @@
 #include "HashUtill.h"
 #include <cstring>
+#include <cstdio>
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+#if defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#include <immintrin.h>
+#define HASHUTIL_X86 1
+#endif
 
 namespace HashUtil {
 
+    // ---- CPU 機能 ----
+    // 起動時に一度だけ調べる。SetHashAcceleration(false) でスカラー実装に固定できる
+    struct CpuFeatures {
+        bool clmul = false;  // PCLMULQDQ + SSE4.1
+        bool sha = false;    // SHA-NI + SSSE3 + SSE4.1
+    };
+    static CpuFeatures DetectCpu() {
+        CpuFeatures f;
+#if HASHUTIL_X86
+        int r[4] = {};
+        __cpuid(r, 0);
+        int maxLeaf = r[0];
+        __cpuid(r, 1);
+        bool ssse3 = (r[2] & (1 << 9)) != 0;
+        bool sse41 = (r[2] & (1 << 19)) != 0;
+        bool pclmul = (r[2] & (1 << 1)) != 0;
+        f.clmul = pclmul && sse41;
+        if (maxLeaf >= 7) {
+            __cpuidex(r, 7, 0);
+            f.sha = (r[1] & (1 << 29)) != 0 && ssse3 && sse41;
+        }
+#endif
+        return f;
+    }
+    static const CpuFeatures& Cpu() {
+        static const CpuFeatures f = DetectCpu();
+        return f;
+    }
+    static bool g_accel = true;
+
+    void SetHashAcceleration(bool enable) { g_accel = enable; }
+    static bool UseClmul() { return g_accel && Cpu().clmul; }
+    static bool UseShaNi() { return g_accel && Cpu().sha; }
+
+    const char* GetCRC32ImplName() { return UseClmul() ? "PCLMUL" : "slice-by-8"; }
+    const char* GetSHA256ImplName() { return UseShaNi() ? "SHA-NI" : "scalar"; }
+
     // ---- CRC32 ----
-    static uint32_t CRC32Table[256];
+    // CRC32Table[0] が従来のバイト単位テーブル。[1]..[7] は slice-by-8 用
+    static uint32_t CRC32Table[8][256];
     void InitCRC32() {
-        static bool inited = false;
-        if (inited) return;
-        inited = true;
-        uint32_t poly = 0xEDB88320u;
-        for (uint32_t i = 0; i < 256; ++i) {
-            uint32_t r = i;
-            for (int j = 0; j < 8; ++j) {
-                if (r & 1) r = (r >> 1) ^ poly;
-                else r >>= 1;
+        static const bool inited = [] {
+            uint32_t poly = 0xEDB88320u;
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t r = i;
+                for (int j = 0; j < 8; ++j) {
+                    if (r & 1) r = (r >> 1) ^ poly;
+                    else r >>= 1;
+                }
+                CRC32Table[0][i] = r;
             }
-            CRC32Table[i] = r;
+            for (uint32_t i = 0; i < 256; ++i) {
+                for (int k = 1; k < 8; ++k) {
+                    uint32_t prev = CRC32Table[k - 1][i];
+                    CRC32Table[k][i] = (prev >> 8) ^ CRC32Table[0][prev & 0xFFu];
+                }
+            }
+            Cpu();
+            return true;
+        }();
+        (void)inited;
+    }
+
+    // 以下の内部関数は反転前の状態を受け取り、反転前の状態を返す
+    static uint32_t CRC32Bytewise(const uint8_t* p, size_t len, uint32_t crc) {
+        for (size_t i = 0; i < len; ++i) {
+            crc = CRC32Table[0][(crc ^ p[i]) & 0xFFu] ^ (crc >> 8);
+        }
+        return crc;
+    }
+
+    static uint32_t CRC32Slice8(const uint8_t* p, size_t len, uint32_t crc) {
+        while (len >= 8) {
+            uint32_t lo, hi;
+            memcpy(&lo, p, 4);
+            memcpy(&hi, p + 4, 4);
+            lo ^= crc;
+            crc = CRC32Table[7][lo & 0xFFu] ^ CRC32Table[6][(lo >> 8) & 0xFFu] ^
+                CRC32Table[5][(lo >> 16) & 0xFFu] ^ CRC32Table[4][lo >> 24] ^
+                CRC32Table[3][hi & 0xFFu] ^ CRC32Table[2][(hi >> 8) & 0xFFu] ^
+                CRC32Table[1][(hi >> 16) & 0xFFu] ^ CRC32Table[0][hi >> 24];
+            p += 8;
+            len -= 8;
         }
+        return CRC32Bytewise(p, len, crc);
     }
+
+#if HASHUTIL_X86
+    // PCLMULQDQ による畳み込み (Intel "Fast CRC Computation for Generic Polynomials
+    // Using PCLMULQDQ Instruction" のビット反転版)。SSE4.2 の crc32 命令は CRC32C 用なので使えない。
+    // len は 64 以上かつ 16 の倍数
+    static uint32_t CRC32Clmul(const uint8_t* p, size_t len, uint32_t crc) {
+        alignas(16) static const uint64_t k1k2[2] = { 0x0154442bd4ull, 0x01c6e41596ull };
+        alignas(16) static const uint64_t k3k4[2] = { 0x01751997d0ull, 0x00ccaa009eull };
+        alignas(16) static const uint64_t k5k0[2] = { 0x0163cd6124ull, 0x0000000000ull };
+        alignas(16) static const uint64_t poly[2] = { 0x01db710641ull, 0x01f7011641ull };
+
+        __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+        x1 = _mm_loadu_si128((const __m128i*)(p + 0x00));
+        x2 = _mm_loadu_si128((const __m128i*)(p + 0x10));
+        x3 = _mm_loadu_si128((const __m128i*)(p + 0x20));
+        x4 = _mm_loadu_si128((const __m128i*)(p + 0x30));
+        x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+        x0 = _mm_load_si128((const __m128i*)k1k2);
+        p += 64;
+        len -= 64;
+
+        // 64 バイト単位で 4 本並列に畳み込む
+        while (len >= 64) {
+            x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+            x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+            x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+            x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+            x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+            x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+            x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+            x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+            x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i*)(p + 0x00)));
+            x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i*)(p + 0x10)));
+            x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i*)(p + 0x20)));
+            x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i*)(p + 0x30)));
+            p += 64;
+            len -= 64;
+        }
+
+        // 4 本を 128bit 1 本にまとめる
+        x0 = _mm_load_si128((const __m128i*)k3k4);
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+        // 残りの 16 バイト単位
+        while (len >= 16) {
+            x2 = _mm_loadu_si128((const __m128i*)p);
+            x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+            x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+            x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+            p += 16;
+            len -= 16;
+        }
+
+        // 128bit → 64bit
+        x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+        x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+        x1 = _mm_srli_si128(x1, 8);
+        x1 = _mm_xor_si128(x1, x2);
+        x0 = _mm_loadl_epi64((const __m128i*)k5k0);
+        x2 = _mm_srli_si128(x1, 4);
+        x1 = _mm_and_si128(x1, x3);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_xor_si128(x1, x2);
+
+        // Barrett 還元で 32bit へ
+        x0 = _mm_load_si128((const __m128i*)poly);
+        x2 = _mm_and_si128(x1, x3);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+        x2 = _mm_and_si128(x2, x3);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x1 = _mm_xor_si128(x1, x2);
+        return (uint32_t)_mm_extract_epi32(x1, 1);
+    }
+#endif
+
     uint32_t CalcCRC32(const void* data, size_t len, uint32_t crc) {
         const uint8_t* p = (const uint8_t*)data;
-        for (size_t i = 0; i < len; ++i) {
-            crc = CRC32Table[(crc ^ p[i]) & 0xFFu] ^ (crc >> 8);
+#if HASHUTIL_X86
+        if (len >= 64 && UseClmul()) {
+            size_t bulk = len & ~(size_t)15;
+            crc = CRC32Clmul(p, bulk, crc);
+            p += bulk;
+            len -= bulk;
         }
-        return crc ^ 0xFFFFFFFFu;
+#endif
+        return CRC32Slice8(p, len, crc) ^ 0xFFFFFFFFu;
+    }
+
+    uint32_t CalcCRC32Reference(const void* data, size_t len, uint32_t crc) {
+        return CRC32Bytewise((const uint8_t*)data, len, crc) ^ 0xFFFFFFFFu;
+    }
+
+    // ---- 64bit ハッシュ ----
+    // Hash64Const と同じ計算をアラインされていない 8/4 バイト読み込みで行う
+    uint64_t Hash64(const void* data, size_t len, uint64_t seed) {
+        using namespace detail;
+        const uint8_t* p = (const uint8_t*)data;
+        const size_t total = len;
+        auto read64 = [](const uint8_t* q) { uint64_t v; memcpy(&v, q, 8); return v; };
+        uint64_t h = seed + kXXP5;
+        if (len >= 32) {
+            uint64_t v1 = seed + kXXP1 + kXXP2, v2 = seed + kXXP2, v3 = seed, v4 = seed - kXXP1;
+            for (; len >= 32; p += 32, len -= 32) {
+                v1 = XXRound(v1, read64(p));
+                v2 = XXRound(v2, read64(p + 8));
+                v3 = XXRound(v3, read64(p + 16));
+                v4 = XXRound(v4, read64(p + 24));
+            }
+            h = Rotl64(v1, 1) + Rotl64(v2, 7) + Rotl64(v3, 12) + Rotl64(v4, 18);
+            h = XXMerge(h, v1);
+            h = XXMerge(h, v2);
+            h = XXMerge(h, v3);
+            h = XXMerge(h, v4);
+        }
+        h += (uint64_t)total;
+        for (; len >= 8; p += 8, len -= 8) h = Rotl64(h ^ XXRound(0, read64(p)), 27) * kXXP1 + kXXP4;
+        if (len >= 4) {
+            uint32_t v;
+            memcpy(&v, p, 4);
+            h = Rotl64(h ^ (uint64_t)v * kXXP1, 23) * kXXP2 + kXXP3;
+            p += 4;
+            len -= 4;
+        }
+        for (; len > 0; ++p, --len) h = Rotl64(h ^ *p * kXXP5, 11) * kXXP1;
+        return XXAvalanche(h);
     }
 
     // ---- SHA-256 ----
     static inline uint32_t ROR(uint32_t v, uint32_t n) { return (v >> n) | (v << (32 - n)); }
-    static const uint32_t K[64] = {
+    alignas(16) static const uint32_t K[64] = {
       0x428a2f98,0x71374491,0xb5c0fbcf,0xe9b5dba5,0x3956c25b,0x59f111f1,0x923f82a4,0xab1c5ed5,
       0xd807aa98,0x12835b01,0x243185be,0x550c7dc3,0x72be5d74,0x80deb1fe,0x9bdc06a7,0xc19bf174,
       0xe49b69c1,0xefbe4786,0x0fc19dc6,0x240ca1cc,0x2de92c6f,0x4a7484aa,0x5cb0a9dc,0x76f988da,
@@ -53,51 +260,138 @@ namespace HashUtil {
         ctx.state[7] = 0x5be0cd19;
     }
 
-    static void SHA256Transform(SHA256Ctx& ctx, const uint8_t data[64]) {
-        uint32_t w[64];
-        for (int i = 0; i < 16; ++i) {
-            w[i] = (uint32_t)data[i * 4] << 24 |
-                (uint32_t)data[i * 4 + 1] << 16 |
-                (uint32_t)data[i * 4 + 2] << 8 |
-                (uint32_t)data[i * 4 + 3];
-        }
-        for (int i = 16; i < 64; ++i) {
-            uint32_t s0 = ROR(w[i - 15], 7) ^ ROR(w[i - 15], 18) ^ (w[i - 15] >> 3);
-            uint32_t s1 = ROR(w[i - 2], 17) ^ ROR(w[i - 2], 19) ^ (w[i - 2] >> 10);
-            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
-        }
-
-        uint32_t a = ctx.state[0], b = ctx.state[1], c = ctx.state[2], d = ctx.state[3],
-            e = ctx.state[4], f = ctx.state[5], g = ctx.state[6], h = ctx.state[7];
-
-        for (int i = 0; i < 64; ++i) {
-            uint32_t S1 = ROR(e, 6) ^ ROR(e, 11) ^ ROR(e, 25);
-            uint32_t ch = (e & g) ^ ((~e) & f);
-            uint32_t temp1 = h + S1 + ch + K[i] + w[i];
-            uint32_t S0 = ROR(a, 2) ^ ROR(a, 13) ^ ROR(a, 22);
-            uint32_t maj = (a & c) ^ (a & b) ^ (b & c);
-            uint32_t temp2 = S0 + maj;
-            h = g;
-            g = f;
-            f = e;
-            e = d + temp1;
-            d = c;
-            c = b;
-            b = a;
-            a = temp1 + temp2;
-        }
-        ctx.state[0] += a;
-        ctx.state[1] += b;
-        ctx.state[2] += c;
-        ctx.state[3] += d;
-        ctx.state[4] += e;
-        ctx.state[5] += f;
-        ctx.state[6] += g;
-        ctx.state[7] += h;
+    // スカラー実装 (基準)
+    static void SHA256TransformScalar(uint32_t state[8], const uint8_t* data, size_t blocks) {
+        for (; blocks > 0; --blocks, data += 64) {
+            uint32_t w[64];
+            for (int i = 0; i < 16; ++i) {
+                w[i] = (uint32_t)data[i * 4] << 24 |
+                    (uint32_t)data[i * 4 + 1] << 16 |
+                    (uint32_t)data[i * 4 + 2] << 8 |
+                    (uint32_t)data[i * 4 + 3];
+            }
+            for (int i = 16; i < 64; ++i) {
+                uint32_t s0 = ROR(w[i - 15], 7) ^ ROR(w[i - 15], 18) ^ (w[i - 15] >> 3);
+                uint32_t s1 = ROR(w[i - 2], 17) ^ ROR(w[i - 2], 19) ^ (w[i - 2] >> 10);
+                w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+            }
+
+            uint32_t a = state[0], b = state[1], c = state[2], d = state[3],
+                e = state[4], f = state[5], g = state[6], h = state[7];
+
+            for (int i = 0; i < 64; ++i) {
+                uint32_t S1 = ROR(e, 6) ^ ROR(e, 11) ^ ROR(e, 25);
+                uint32_t ch = (e & f) ^ ((~e) & g);
+                uint32_t temp1 = h + S1 + ch + K[i] + w[i];
+                uint32_t S0 = ROR(a, 2) ^ ROR(a, 13) ^ ROR(a, 22);
+                uint32_t maj = (a & c) ^ (a & b) ^ (b & c);
+                uint32_t temp2 = S0 + maj;
+                h = g;
+                g = f;
+                f = e;
+                e = d + temp1;
+                d = c;
+                c = b;
+                b = a;
+                a = temp1 + temp2;
+            }
+            state[0] += a;
+            state[1] += b;
+            state[2] += c;
+            state[3] += d;
+            state[4] += e;
+            state[5] += f;
+            state[6] += g;
+            state[7] += h;
+        }
+    }
+
+#if HASHUTIL_X86
+    // SHA-NI: 4 ラウンド分 (K[i*4..i*4+3])
+    static inline void ShaNiRounds(__m128i& st0, __m128i& st1, __m128i w, int i) {
+        __m128i msg = _mm_add_epi32(w, _mm_load_si128((const __m128i*)&K[i * 4]));
+        st1 = _mm_sha256rnds2_epu32(st1, st0, msg);
+        msg = _mm_shuffle_epi32(msg, 0x0E);
+        st0 = _mm_sha256rnds2_epu32(st0, st1, msg);
+    }
+    // メッセージスケジュール: next へ W[t-7] と sigma1 を加える
+    static inline void ShaNiMsg2(__m128i& next, __m128i cur, __m128i prev) {
+        next = _mm_add_epi32(next, _mm_alignr_epi8(cur, prev, 4));
+        next = _mm_sha256msg2_epu32(next, cur);
+    }
+
+    // SHA-NI 実装。状態は ABEF / CDGH の 2 レジスタで持つ
+    // ループにすると MSVC が展開せずメッセージがメモリ経由になるので 16 段を書き下す
+    static void SHA256TransformShaNi(uint32_t state[8], const uint8_t* data, size_t blocks) {
+        const __m128i kShuffle = _mm_set_epi64x(0x0c0d0e0f08090a0bll, 0x0405060700010203ll);
+
+        __m128i tmp = _mm_loadu_si128((const __m128i*)&state[0]);
+        __m128i st1 = _mm_loadu_si128((const __m128i*)&state[4]);
+        tmp = _mm_shuffle_epi32(tmp, 0xB1);           // CDAB
+        st1 = _mm_shuffle_epi32(st1, 0x1B);           // EFGH
+        __m128i st0 = _mm_alignr_epi8(tmp, st1, 8);   // ABEF
+        st1 = _mm_blend_epi16(st1, tmp, 0xF0);        // CDGH
+
+        for (; blocks > 0; --blocks, data += 64) {
+            const __m128i abefSave = st0;
+            const __m128i cdghSave = st1;
+
+            __m128i m0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 0)), kShuffle);
+            __m128i m1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 16)), kShuffle);
+            __m128i m2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 32)), kShuffle);
+            __m128i m3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 48)), kShuffle);
+
+            ShaNiRounds(st0, st1, m0, 0);
+            ShaNiRounds(st0, st1, m1, 1);  m0 = _mm_sha256msg1_epu32(m0, m1);
+            ShaNiRounds(st0, st1, m2, 2);  m1 = _mm_sha256msg1_epu32(m1, m2);
+            ShaNiRounds(st0, st1, m3, 3);  ShaNiMsg2(m0, m3, m2); m2 = _mm_sha256msg1_epu32(m2, m3);
+            ShaNiRounds(st0, st1, m0, 4);  ShaNiMsg2(m1, m0, m3); m3 = _mm_sha256msg1_epu32(m3, m0);
+            ShaNiRounds(st0, st1, m1, 5);  ShaNiMsg2(m2, m1, m0); m0 = _mm_sha256msg1_epu32(m0, m1);
+            ShaNiRounds(st0, st1, m2, 6);  ShaNiMsg2(m3, m2, m1); m1 = _mm_sha256msg1_epu32(m1, m2);
+            ShaNiRounds(st0, st1, m3, 7);  ShaNiMsg2(m0, m3, m2); m2 = _mm_sha256msg1_epu32(m2, m3);
+            ShaNiRounds(st0, st1, m0, 8);  ShaNiMsg2(m1, m0, m3); m3 = _mm_sha256msg1_epu32(m3, m0);
+            ShaNiRounds(st0, st1, m1, 9);  ShaNiMsg2(m2, m1, m0); m0 = _mm_sha256msg1_epu32(m0, m1);
+            ShaNiRounds(st0, st1, m2, 10); ShaNiMsg2(m3, m2, m1); m1 = _mm_sha256msg1_epu32(m1, m2);
+            ShaNiRounds(st0, st1, m3, 11); ShaNiMsg2(m0, m3, m2); m2 = _mm_sha256msg1_epu32(m2, m3);
+            ShaNiRounds(st0, st1, m0, 12); ShaNiMsg2(m1, m0, m3); m3 = _mm_sha256msg1_epu32(m3, m0);
+            ShaNiRounds(st0, st1, m1, 13); ShaNiMsg2(m2, m1, m0);
+            ShaNiRounds(st0, st1, m2, 14); ShaNiMsg2(m3, m2, m1);
+            ShaNiRounds(st0, st1, m3, 15);
+
+            st0 = _mm_add_epi32(st0, abefSave);
+            st1 = _mm_add_epi32(st1, cdghSave);
+        }
+
+        tmp = _mm_shuffle_epi32(st0, 0x1B);           // FEBA
+        st1 = _mm_shuffle_epi32(st1, 0xB1);           // DCHG
+        st0 = _mm_blend_epi16(tmp, st1, 0xF0);        // DCBA
+        st1 = _mm_alignr_epi8(st1, tmp, 8);           // ABEF
+        _mm_storeu_si128((__m128i*)&state[0], st0);
+        _mm_storeu_si128((__m128i*)&state[4], st1);
+    }
+#endif
+
+    static void SHA256Transform(SHA256Ctx& ctx, const uint8_t* data, size_t blocks) {
+#if HASHUTIL_X86
+        if (UseShaNi()) {
+            SHA256TransformShaNi(ctx.state, data, blocks);
+            return;
+        }
+#endif
+        SHA256TransformScalar(ctx.state, data, blocks);
     }
 
     void SHA256Update(SHA256Ctx& ctx, const uint8_t* data, size_t len) {
         while (len > 0) {
+            // バッファが空ならブロック単位で直接処理する (コピーを省く)
+            if (ctx.bufferLen == 0 && len >= 64) {
+                size_t blocks = len / 64;
+                SHA256Transform(ctx, data, blocks);
+                ctx.bitlen += 512ull * blocks;
+                data += blocks * 64;
+                len -= blocks * 64;
+                continue;
+            }
             size_t toCopy = 64 - ctx.bufferLen;
             if (toCopy > len) toCopy = len;
             memcpy(ctx.buffer + ctx.bufferLen, data, toCopy);
@@ -105,7 +399,7 @@ namespace HashUtil {
             data += toCopy;
             len -= toCopy;
             if (ctx.bufferLen == 64) {
-                SHA256Transform(ctx, ctx.buffer);
+                SHA256Transform(ctx, ctx.buffer, 1);
                 ctx.bitlen += 512;
                 ctx.bufferLen = 0;
             }
@@ -117,14 +411,14 @@ namespace HashUtil {
         ctx.buffer[i++] = 0x80;
         if (i > 56) {
             while (i < 64) ctx.buffer[i++] = 0;
-            SHA256Transform(ctx, ctx.buffer);
+            SHA256Transform(ctx, ctx.buffer, 1);
             i = 0;
         }
         while (i < 56) ctx.buffer[i++] = 0;
         for (int j = 7; j >= 0; --j) {
             ctx.buffer[i++] = (uint8_t)((ctx.bitlen >> (j * 8)) & 0xFFu);
         }
-        SHA256Transform(ctx, ctx.buffer);
+        SHA256Transform(ctx, ctx.buffer, 1);
         for (int s = 0; s < 8; ++s) {
             out[s * 4 + 0] = (uint8_t)(ctx.state[s] >> 24);
             out[s * 4 + 1] = (uint8_t)(ctx.state[s] >> 16);
@@ -133,4 +427,167 @@ namespace HashUtil {
         }
     }
 
-} // namespace HashUtil
\ No newline at end of file
+    // ---- 照合 / 計測 ----
+    bool SelfTest(std::string& log) {
+        InitCRC32();
+        const bool prevAccel = g_accel;
+        bool ok = true;
+        char line[256];
+        auto fail = [&](const char* what, size_t len, size_t offset) {
+            if (ok) {
+                snprintf(line, sizeof(line), "FAIL %s (len=%zu offset=%zu)\n", what, len, offset);
+                log += line;
+            }
+            ok = false;
+        };
+
+        // 既知の値
+        g_accel = prevAccel;
+        if (CalcCRC32("123456789", 9) != 0xCBF43926u) fail("CRC32 check value", 9, 0);
+        static const uint8_t kAbc[32] = {
+            0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+            0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad };
+        if (memcmp(SHA256("abc", 3).data(), kAbc, 32) != 0) fail("SHA-256 \"abc\"", 3, 0);
+
+        std::mt19937 rng(12345);
+        std::vector<uint8_t> buf((size_t)1 << 17);
+        for (uint8_t& b : buf) b = (uint8_t)rng();
+        // 短い長さ (末尾処理の分岐) と長い長さの両方を引く
+        auto randomLength = [&](size_t maxLen) {
+            return (rng() & 1) ? (size_t)(rng() % 300) : (size_t)(rng() % maxLen);
+        };
+
+        // CRC32: 高速実装 / slice-by-8 / 基準実装
+        for (int i = 0; i < 2000 && ok; ++i) {
+            const size_t offset = rng() % 64;
+            const size_t len = randomLength(buf.size() - 64);
+            const uint32_t init = (i % 3 == 0) ? 0xFFFFFFFFu : (uint32_t)rng();
+            const uint8_t* p = buf.data() + offset;
+            const uint32_t ref = CalcCRC32Reference(p, len, init);
+            g_accel = prevAccel;
+            if (CalcCRC32(p, len, init) != ref) fail(GetCRC32ImplName(), len, offset);
+            g_accel = false;
+            if (CalcCRC32(p, len, init) != ref) fail("CRC32 slice-by-8", len, offset);
+        }
+
+        // SHA-256: 高速実装を一括 / 分割、スカラー実装を分割で求めて比べる
+        auto sha = [&](const uint8_t* p, size_t len, bool accel, int pieces) {
+            g_accel = accel && prevAccel;
+            SHA256Ctx ctx;
+            SHA256Init(ctx);
+            size_t done = 0;
+            for (int k = 1; k < pieces && done < len; ++k) {
+                const size_t n = rng() % (len - done + 1);
+                SHA256Update(ctx, p + done, n);
+                done += n;
+            }
+            SHA256Update(ctx, p + done, len - done);
+            std::array<uint8_t, 32> h{};
+            SHA256Final(ctx, h.data());
+            return h;
+        };
+        for (int i = 0; i < 1000 && ok; ++i) {
+            const size_t offset = rng() % 64;
+            const size_t len = randomLength(1 << 14);
+            const uint8_t* p = buf.data() + offset;
+            const auto scalar = sha(p, len, false, 1 + (int)(rng() % 4));
+            if (sha(p, len, true, 1) != scalar) fail(GetSHA256ImplName(), len, offset);
+            if (sha(p, len, true, 2 + (int)(rng() % 6)) != scalar) fail("SHA-256 split update", len, offset);
+        }
+
+        g_accel = prevAccel;
+        snprintf(line, sizeof(line), "CRC32 %s / SHA-256 %s: %s\n", GetCRC32ImplName(), GetSHA256ImplName(),
+            ok ? "match" : "MISMATCH");
+        log += line;
+        return ok;
+    }
+
+    void Benchmark(std::string& log, size_t bytes, int rounds) {
+        InitCRC32();
+        const bool prevAccel = g_accel;
+        if (rounds < 1) rounds = 1;
+        std::vector<uint8_t> buf(bytes);
+        std::mt19937 rng(1);
+        for (uint8_t& b : buf) b = (uint8_t)rng();
+
+        char line[256];
+        volatile uint64_t sink = 0; // 最適化で消されないように結果を使う
+        auto measure = [&](const char* name, bool accel, auto&& fn) {
+            g_accel = accel;
+            double best = 1e300;
+            for (int r = 0; r < rounds; ++r) {
+                auto t0 = std::chrono::steady_clock::now();
+                sink = sink + fn();
+                best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+            }
+            snprintf(line, sizeof(line), "%-20s %7.2f GB/s\n", name, best > 0.0 ? bytes / best / 1e9 : 0.0);
+            log += line;
+        };
+        const uint8_t* p = buf.data();
+        const size_t n = buf.size();
+        measure("CRC32 reference", false, [&] { return (uint64_t)CalcCRC32Reference(p, n); });
+        measure("CRC32 slice-by-8", false, [&] { return (uint64_t)CalcCRC32(p, n); });
+        if (Cpu().clmul) measure("CRC32 PCLMUL", true, [&] { return (uint64_t)CalcCRC32(p, n); });
+        measure("SHA-256 scalar", false, [&] { return (uint64_t)SHA256(p, n)[0]; });
+        if (Cpu().sha) measure("SHA-256 SHA-NI", true, [&] { return (uint64_t)SHA256(p, n)[0]; });
+        measure("Hash64 (xxHash64)", true, [&] { return Hash64(p, n); });
+        g_accel = prevAccel;
+    }
+
+    void BenchmarkStringMap(const std::vector<std::string>& names, std::string& log, int rounds) {
+        char line[256];
+        if (names.empty()) {
+            log += "StringMap: no names\n";
+            return;
+        }
+        if (rounds < 1) rounds = 1;
+        // 無い名前は末尾を変えて作る (同じ長さ・同じ接頭辞の検索失敗)
+        std::vector<std::string> misses;
+        misses.reserve(names.size());
+        for (const std::string& s : names) misses.push_back(s + "~");
+        size_t totalLen = 0;
+        for (const std::string& s : names) totalLen += s.size();
+        // 少ない名前でも計測時間が短くなりすぎないように検索を繰り返す
+        const size_t repeat = std::max<size_t>(1, 1000000 / names.size());
+        snprintf(line, sizeof(line), "StringMap: %zu names, avg %.1f chars\n", names.size(), (double)totalLen / names.size());
+        log += line;
+
+        volatile size_t sink = 0;
+        auto seconds = [](auto&& fn) {
+            auto t0 = std::chrono::steady_clock::now();
+            fn();
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        };
+        auto run = [&](const char* name, auto makeMap, auto&& find) {
+            double insertBest = 1e300, hitBest = 1e300, missBest = 1e300;
+            for (int r = 0; r < rounds; ++r) {
+                auto map = makeMap();
+                insertBest = std::min(insertBest, seconds([&] {
+                    for (size_t i = 0; i < names.size(); ++i) map.emplace(names[i], i);
+                }));
+                hitBest = std::min(hitBest, seconds([&] {
+                    size_t found = 0;
+                    for (size_t k = 0; k < repeat; ++k)
+                        for (const std::string& s : names) found += find(map, s);
+                    sink = sink + found;
+                }));
+                missBest = std::min(missBest, seconds([&] {
+                    size_t found = 0;
+                    for (size_t k = 0; k < repeat; ++k)
+                        for (const std::string& s : misses) found += find(map, s);
+                    sink = sink + found;
+                }));
+            }
+            const double lookups = (double)names.size() * repeat;
+            snprintf(line, sizeof(line), "%-24s insert %6.1f ns  hit %6.1f ns  miss %6.1f ns\n", name,
+                insertBest / names.size() * 1e9, hitBest / lookups * 1e9, missBest / lookups * 1e9);
+            log += line;
+        };
+        run("std::hash<std::string>", [] { return std::unordered_map<std::string, size_t>(); },
+            [](const std::unordered_map<std::string, size_t>& m, const std::string& s) { return m.count(s); });
+        // エンジンの呼び出し側と同じく string_view のまま検索する
+        run("StringMap (Hash64)", [] { return StringMap<size_t>(); },
+            [](const StringMap<size_t>& m, const std::string& s) { return m.count(std::string_view(s)); });
+    }
+
+} // namespace HashUtil
@@ -3,13 +3,34 @@
 #include <cstddef>
 #include <array>
 #include <vector>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <functional>
 
 namespace HashUtil {
 
+    // CalcCRC32  PCLMULQDQ Ή CPU ł͏ݍ݁AȊO slice-by-8 ŌvZB
+    // SHA-256  SHA-NI Ή CPU Őp߂gBǂʂ̓XJ[Ɠ
     void InitCRC32();
     uint32_t CalcCRC32(const void* data, size_t len, uint32_t crc = 0xFFFFFFFFu);
+    // 1 oCg (ƍp)
+    uint32_t CalcCRC32Reference(const void* data, size_t len, uint32_t crc = 0xFFFFFFFFu);
 
-    // Ȉ SHA-256 
+    // false ŃXJ[ɌŒ肷 (ƍEvp)
+    void SetHashAcceleration(bool enable);
+    const char* GetCRC32ImplName();
+    const char* GetSHA256ImplName();
+    //  (PCLMUL / SHA-NI)  / XJ[Ɠ˂킹B
+    // E擪̂ElESHA256Update ̕𗐐ŕςBΉ CPU ł̓XJ[m̏ƍɂȂ
+    bool SelfTest(std::string& log);
+    // ȇx (GB/s)  bytes ̃obt@ rounds 񑪂Aő̒l log ֒ǋL
+    void Benchmark(std::string& log, size_t bytes = (size_t)64 << 20, int rounds = 5);
+    // names (ۂ̃AZbg) L[ɂ StringMap  std::hash<std::string> ̃}bv
+    // } /  (L閼O / O) ̑xׂ log ֒ǋL
+    void BenchmarkStringMap(const std::vector<std::string>& names, std::string& log, int rounds = 5);
+
+    // SHA-256 (FIPS 180-4)
     struct SHA256Ctx {
         uint64_t bitlen = 0;
         uint32_t state[8];
@@ -40,4 +61,88 @@ namespace HashUtil {
         return h;
     }
 
+    // ---- 64bit nbV (xxHash64) ----
+    // s̃L[ (AZbgEVF[_[ϐȂ) p̔ÍnbVB
+    // Hash64  Hash64Const ͓lԂ̂ŁARpCɋ߂ ID 
+    // [hɖO狁߂ ID ̂܂ܔrł
+    namespace detail {
+        constexpr uint64_t kXXP1 = 0x9E3779B185EBCA87ull;
+        constexpr uint64_t kXXP2 = 0xC2B2AE3D27D4EB4Full;
+        constexpr uint64_t kXXP3 = 0x165667B19E3779F9ull;
+        constexpr uint64_t kXXP4 = 0x85EBCA77C2B2AE63ull;
+        constexpr uint64_t kXXP5 = 0x27D4EB2F165667C5ull;
+
+        constexpr uint64_t Rotl64(uint64_t v, int r) { return (v << r) | (v >> (64 - r)); }
+        constexpr uint64_t XXRound(uint64_t acc, uint64_t in) {
+            return Rotl64(acc + in * kXXP2, 31) * kXXP1;
+        }
+        constexpr uint64_t XXMerge(uint64_t acc, uint64_t v) {
+            return (acc ^ XXRound(0, v)) * kXXP1 + kXXP4;
+        }
+        constexpr uint64_t XXAvalanche(uint64_t h) {
+            h ^= h >> 33;
+            h *= kXXP2;
+            h ^= h >> 29;
+            h *= kXXP3;
+            h ^= h >> 32;
+            return h;
+        }
+        constexpr uint64_t ReadLE(const char* p, int bytes) {
+            uint64_t v = 0;
+            for (int i = 0; i < bytes; ++i) v |= (uint64_t)(uint8_t)p[i] << (i * 8);
+            return v;
+        }
+    }
+
+    constexpr uint64_t Hash64Const(std::string_view s, uint64_t seed = 0) {
+        using namespace detail;
+        const char* p = s.data();
+        size_t len = s.size();
+        uint64_t h = seed + kXXP5;
+        if (len >= 32) {
+            uint64_t v1 = seed + kXXP1 + kXXP2, v2 = seed + kXXP2, v3 = seed, v4 = seed - kXXP1;
+            for (; len >= 32; p += 32, len -= 32) {
+                v1 = XXRound(v1, ReadLE(p, 8));
+                v2 = XXRound(v2, ReadLE(p + 8, 8));
+                v3 = XXRound(v3, ReadLE(p + 16, 8));
+                v4 = XXRound(v4, ReadLE(p + 24, 8));
+            }
+            h = Rotl64(v1, 1) + Rotl64(v2, 7) + Rotl64(v3, 12) + Rotl64(v4, 18);
+            h = XXMerge(h, v1);
+            h = XXMerge(h, v2);
+            h = XXMerge(h, v3);
+            h = XXMerge(h, v4);
+        }
+        h += (uint64_t)s.size();
+        for (; len >= 8; p += 8, len -= 8) h = Rotl64(h ^ XXRound(0, ReadLE(p, 8)), 27) * kXXP1 + kXXP4;
+        if (len >= 4) {
+            h = Rotl64(h ^ ReadLE(p, 4) * kXXP1, 23) * kXXP2 + kXXP3;
+            p += 4;
+            len -= 4;
+        }
+        for (; len > 0; ++p, --len) h = Rotl64(h ^ (uint8_t)*p * kXXP5, 11) * kXXP1;
+        return XXAvalanche(h);
+    }
+    static_assert(Hash64Const("") == 0xEF46DB3751D8E999ull, "xxHash64 empty input");
+
+    uint64_t Hash64(const void* data, size_t len, uint64_t seed = 0);
+    inline uint64_t Hash64(std::string_view s) { return Hash64(s.data(), s.size()); }
+
+    // L[̃}bvpBstd::hash<std::string> ̑ Hash64 gB
+    // C++20 ł string_view / const char* ̂܂ std::string 炸Ɍł
+    struct StringHash64 {
+        using is_transparent = void;
+        size_t operator()(std::string_view s) const noexcept { return (size_t)Hash64(s); }
+    };
+    template <class T>
+    using StringMap = std::unordered_map<std::string, T, StringHash64, std::equal_to<>>;
+
+    // O Hash64  64bit ID ɂ̂̃}bvpBID ͊ɏ\Ă̂ł̂܂܎g
+    // (Փ˂ ID o^鑤ŖOׂČo邱)
+    struct IdHash {
+        size_t operator()(uint64_t id) const noexcept { return (size_t)id; }
+    };
+    template <class T>
+    using IdMap = std::unordered_map<uint64_t, T, IdHash>;
+
 } 
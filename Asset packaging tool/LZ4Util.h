@@ -0,0 +1,41 @@
+#ifndef LZ4UTIL_H
+#define LZ4UTIL_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// LZ4 ブロック形式の圧縮 / 展開
+// アーカイブ内の LZ4 エントリはチャンク列 (ArchiveFormat.h 参照) として格納する
+namespace LZ4Util {
+
+    // 1 ブロック圧縮に必要な出力バッファの最大サイズ
+    inline size_t CompressBound(size_t srcLen) { return srcLen + srcLen / 255 + 16; }
+
+    // 1 ブロックを圧縮する。戻り値は圧縮後サイズ (dstCap に収まらなければ 0)
+    size_t CompressBlock(const uint8_t* src, size_t srcLen, uint8_t* dst, size_t dstCap);
+
+    // 1 ブロックを展開する。dstLen ちょうどに展開できた場合のみ true
+    bool DecompressBlock(const uint8_t* src, size_t srcLen, uint8_t* dst, size_t dstLen);
+
+    // 辞書付きの 1 ブロック圧縮 / 展開。dict (末尾 kLZ4DictMaxSize バイトまで) を src の直前にある
+    // データとみなしてマッチを探す。同じ辞書を渡した DecompressBlockDict でのみ展開できる
+    size_t CompressBlockDict(const uint8_t* dict, size_t dictLen, const uint8_t* src, size_t srcLen,
+        uint8_t* dst, size_t dstCap);
+    bool DecompressBlockDict(const uint8_t* dict, size_t dictLen, const uint8_t* src, size_t srcLen,
+        uint8_t* dst, size_t dstLen);
+
+    // チャンク列として圧縮する (圧縮で縮まないチャンクは非圧縮のまま格納)
+    void CompressChunked(const uint8_t* src, size_t srcLen, std::vector<uint8_t>& out);
+
+    // チャンク列を dst へ直接展開する
+    bool DecompressChunked(const uint8_t* src, size_t srcLen, uint8_t* dst, size_t dstLen);
+
+    // 読み込み途中のチャンク列を先頭から順に展開する。
+    // src の末尾に途中までしか無いチャンクは消費せず、消費したバイト数を consumed に返す
+    bool DecompressChunkedPartial(const uint8_t* src, size_t srcLen,
+        uint8_t* dst, size_t dstLen, size_t& consumed, size_t& produced);
+
+} // namespace LZ4Util
+
+#endif // !LZ4UTIL_H
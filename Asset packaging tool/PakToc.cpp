@@ -0,0 +1,180 @@
+#include "PakToc.h"
+#include "HashUtill.h"
+#include <fstream>
+#include <algorithm>
+
+static bool ParseTOCv3(const PakHeader& header, const std::vector<uint8_t>& toc,
+    std::vector<TempFileEntry>& entries, std::string& error, const std::filesystem::path& path) {
+    PakTocHeaderV3 th{};
+    if (toc.size() < sizeof(th)) {
+        error = "TOC 破損: " + path.string();
+        return false;
+    }
+    memcpy(&th, toc.data(), sizeof(th));
+    const uint64_t tableEnd = sizeof(th) + (uint64_t)th.entryCount * sizeof(PakTocEntryV3);
+    if (th.entryStride != sizeof(PakTocEntryV3) || th.entryCount != header.fileCount ||
+        tableEnd > toc.size() || th.stringPoolOffset < tableEnd ||
+        th.stringPoolSize > toc.size() - th.stringPoolOffset) {
+        error = "TOC 破損: " + path.string();
+        return false;
+    }
+    const char* pool = reinterpret_cast<const char*>(toc.data() + th.stringPoolOffset);
+    entries.clear();
+    entries.reserve(th.entryCount);
+    for (uint32_t i = 0; i < th.entryCount; ++i) {
+        PakTocEntryV3 src;
+        memcpy(&src, toc.data() + sizeof(th) + (size_t)i * sizeof(src), sizeof(src));
+        if ((uint64_t)src.nameOffset + src.nameLen > th.stringPoolSize ||
+            src.offset + src.storedSize > header.tocOffset) {
+            error = "TOC 破損: " + path.string();
+            return false;
+        }
+        TempFileEntry e;
+        e.relativePath.assign(pool + src.nameOffset, src.nameLen);
+        e.compression = src.compression;
+        e.crc32 = src.crc32;
+        e.originalSize = src.originalSize;
+        e.storedSize = src.storedSize;
+        e.offset = src.offset;
+        memcpy(e.sha256.data(), src.sha256, 32);
+        entries.push_back(std::move(e));
+    }
+    return true;
+}
+
+bool ReadPakTOC(const std::filesystem::path& path, PakHeader& header,
+    std::vector<TempFileEntry>& entries, std::string& error) {
+    std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+    if (!ifs) {
+        error = "開けません: " + path.string();
+        return false;
+    }
+    uint64_t fileSize = (uint64_t)ifs.tellg();
+    ifs.seekg(0, std::ios::beg);
+    if (fileSize < sizeof(PakHeader) || !ifs.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        error = "ヘッダ読込失敗: " + path.string();
+        return false;
+    }
+    if (memcmp(header.magic, "PIXPAK\0", 8) != 0) {
+        error = "PIXPAK ではありません: " + path.string();
+        return false;
+    }
+    if (header.version < 1 || header.version > 3) {
+        error = "未対応のバージョン " + std::to_string(header.version) + ": " + path.string();
+        return false;
+    }
+    if (header.tocOffset < sizeof(PakHeader) || header.tocOffset > fileSize) {
+        error = "TOC オフセット不正: " + path.string();
+        return false;
+    }
+
+    std::vector<uint8_t> toc((size_t)(fileSize - header.tocOffset));
+    ifs.seekg((std::streamoff)header.tocOffset, std::ios::beg);
+    if (!toc.empty() && !ifs.read(reinterpret_cast<char*>(toc.data()), toc.size())) {
+        error = "TOC 読込失敗: " + path.string();
+        return false;
+    }
+
+    if (header.version >= 3) return ParseTOCv3(header, toc, entries, error, path);
+
+    const size_t fixedSize = 1 + 3 + 4 + 8 + 8 + 8 + (header.version >= 2 ? 32 : 0);
+    const uint8_t* p = toc.data();
+    const uint8_t* end = p + toc.size();
+    entries.clear();
+    entries.reserve(header.fileCount);
+    for (uint32_t i = 0; i < header.fileCount; ++i) {
+        uint16_t nameLen = 0;
+        if ((size_t)(end - p) < sizeof(nameLen)) break;
+        memcpy(&nameLen, p, sizeof(nameLen));
+        p += sizeof(nameLen);
+        if ((size_t)(end - p) < nameLen + fixedSize) break;
+
+        TempFileEntry e;
+        e.relativePath.assign(reinterpret_cast<const char*>(p), nameLen);
+        p += nameLen;
+        e.compression = *p;
+        p += 1 + 3;
+        memcpy(&e.crc32, p, 4);         p += 4;
+        memcpy(&e.originalSize, p, 8);  p += 8;
+        memcpy(&e.storedSize, p, 8);    p += 8;
+        memcpy(&e.offset, p, 8);        p += 8;
+        if (header.version >= 2) {
+            memcpy(e.sha256.data(), p, 32);
+            p += 32;
+        }
+        if (e.offset + e.storedSize > header.tocOffset) break;
+        entries.push_back(std::move(e));
+    }
+    if (entries.size() != header.fileCount) {
+        error = "TOC 破損: " + path.string();
+        return false;
+    }
+    return true;
+}
+
+bool ReadPakDictionary(const std::filesystem::path& path, const PakHeader& header,
+    std::vector<uint8_t>& dict, std::string& error) {
+    dict.clear();
+    if (!HasFlag((uint16_t)header.flags, AssetFlag_Dictionary)) return true;
+    if (header.dictSize == 0 || header.dictSize > kLZ4DictMaxSize || header.dictOffset < sizeof(PakHeader) ||
+        header.dictOffset + header.dictSize > header.tocOffset) {
+        error = "辞書の位置が不正です: " + path.string();
+        return false;
+    }
+    std::ifstream ifs(path, std::ios::binary);
+    dict.resize(header.dictSize);
+    ifs.seekg((std::streamoff)header.dictOffset, std::ios::beg);
+    if (!ifs || !ifs.read(reinterpret_cast<char*>(dict.data()), dict.size())) {
+        error = "辞書の読込に失敗しました: " + path.string();
+        return false;
+    }
+    HashUtil::InitCRC32();
+    if (HashUtil::CalcCRC32(dict.data(), dict.size()) != header.dictCrc32) {
+        error = "辞書の CRC32 が一致しません: " + path.string();
+        return false;
+    }
+    return true;
+}
+
+bool WritePakTOC(std::ostream& os, const std::vector<TempFileEntry>& entries, std::string& error) {
+    // ハッシュ順 (同一ハッシュは名前順) に並べたテーブルと、同じ順の文字列プールを作る
+    std::vector<PakTocEntryV3> table(entries.size());
+    std::vector<char> pool;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const TempFileEntry& fe = entries[i];
+        PakTocEntryV3& e = table[i];
+        memset(&e, 0, sizeof(e));
+        e.pathHash = PakPathHash(fe.relativePath.data(), fe.relativePath.size());
+        e.nameOffset = (uint32_t)i; // 並べ替え後にプール位置へ置き換える
+        e.nameLen = (uint16_t)fe.relativePath.size();
+        e.compression = fe.compression;
+        e.crc32 = fe.crc32;
+        e.originalSize = fe.originalSize;
+        e.storedSize = fe.storedSize;
+        e.offset = fe.offset;
+        memcpy(e.sha256, fe.sha256.data(), 32);
+    }
+    std::sort(table.begin(), table.end(), [&](const PakTocEntryV3& a, const PakTocEntryV3& b) {
+        if (a.pathHash != b.pathHash) return a.pathHash < b.pathHash;
+        return entries[a.nameOffset].relativePath < entries[b.nameOffset].relativePath;
+    });
+    for (size_t i = 0; i < table.size(); ++i) {
+        const std::string& name = entries[table[i].nameOffset].relativePath;
+        if (i > 0 && table[i].pathHash == table[i - 1].pathHash) {
+            error = "パスのハッシュが衝突しました: " + entries[table[i - 1].nameOffset].relativePath + " / " + name;
+            return false;
+        }
+        table[i].nameOffset = (uint32_t)pool.size();
+        pool.insert(pool.end(), name.begin(), name.end());
+    }
+
+    PakTocHeaderV3 th{};
+    th.entryCount = (uint32_t)table.size();
+    th.entryStride = sizeof(PakTocEntryV3);
+    th.stringPoolOffset = sizeof(th) + (uint64_t)table.size() * sizeof(PakTocEntryV3);
+    th.stringPoolSize = pool.size();
+    os.write(reinterpret_cast<const char*>(&th), sizeof(th));
+    if (!table.empty()) os.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(PakTocEntryV3));
+    if (!pool.empty()) os.write(pool.data(), pool.size());
+    return true;
+}
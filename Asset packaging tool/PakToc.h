@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <array>
+#include <filesystem>
+#include "ArchiveFormat.h"
+
+// パック対象 1 ファイル分の TOC 情報
+struct TempFileEntry {
+    std::string relativePath;
+    uint64_t originalSize = 0;
+    uint64_t storedSize = 0;
+    uint64_t offset = 0;
+    uint32_t crc32 = 0;
+    uint8_t  compression = 0;
+    std::array<uint8_t, 32> sha256{};
+};
+
+// 既存アーカイブのヘッダと TOC を読み込む (v1 / v2 / v3)。失敗時は error に理由を入れて false
+bool ReadPakTOC(const std::filesystem::path& path, PakHeader& header,
+    std::vector<TempFileEntry>& entries, std::string& error);
+
+// AssetFlag_Dictionary のアーカイブから LZ4Dict 用の共有辞書を読む (CRC32 も確かめる)。
+// 辞書の無いアーカイブでは dict を空にして true
+bool ReadPakDictionary(const std::filesystem::path& path, const PakHeader& header,
+    std::vector<uint8_t>& dict, std::string& error);
+
+// TOC を書き出す (v3)。os の現在位置は 8 バイト境界であること。
+// パスのハッシュが衝突した場合は error に理由を入れて false
+bool WritePakTOC(std::ostream& os, const std::vector<TempFileEntry>& entries, std::string& error);
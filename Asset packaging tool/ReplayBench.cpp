@@ -0,0 +1,227 @@
+#include "ReplayBench.h"
+#include "TraceLayout.h"
+#include "PakToc.h"
+#include "LZ4Util.h"
+#include <windows.h>
+#include <iostream>
+#include <iomanip>
+#include <unordered_map>
+#include <chrono>
+#include <cstring>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// FILE_FLAG_NO_BUFFERING の読み込み単位 (オフセット / サイズ / バッファをこの倍数に揃える)
+constexpr uint64_t kSector = 4096;
+
+struct ReplayResult {
+    std::string scene;
+    size_t assets = 0;
+    size_t missing = 0;
+    size_t seeks = 0;        // 直前の読み込み終端から続かない読み込みの回数
+    uint64_t readBytes = 0;  // デバイスから読んだバイト数 (セクタ単位)
+    uint64_t seekBytes = 0;  // シークした距離の合計
+    uint64_t ns = 0;
+
+    void Add(const ReplayResult& o) {
+        assets += o.assets;
+        missing += o.missing;
+        seeks += o.seeks;
+        readBytes += o.readBytes;
+        seekBytes += o.seekBytes;
+        ns += o.ns;
+    }
+};
+
+// セクタ境界に揃えて読むリーダー。直前に読んだ範囲と重なる部分は読み直さない
+// (小さいファイルが同じセクタに並んでいる場合に、実際のデバイスと同じく 1 回の読み込みで済む)
+class SectorReader {
+public:
+    ~SectorReader() {
+        if (m_file_ != INVALID_HANDLE_VALUE) CloseHandle(m_file_);
+        if (m_buf_) VirtualFree(m_buf_, 0, MEM_RELEASE);
+    }
+
+    bool Open(const fs::path& path, bool buffered) {
+        DWORD flags = buffered ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_NO_BUFFERING;
+        m_file_ = CreateFileA(path.string().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | flags, nullptr);
+        return m_file_ != INVALID_HANDLE_VALUE;
+    }
+
+    const uint8_t* Read(uint64_t offset, uint64_t size, ReplayResult& r) {
+        const uint64_t begin = offset & ~(kSector - 1);
+        const uint64_t end = (offset + size + kSector - 1) & ~(kSector - 1);
+        if (m_valid_ && begin >= m_begin_ && end <= m_end_) return m_buf_ + (offset - m_begin_);
+
+        // 直前の範囲の末尾と重なるなら重なった分を先頭へ寄せ、続きだけを読む
+        uint64_t readFrom = begin;
+        size_t keep = 0;
+        if (m_valid_ && begin >= m_begin_ && begin < m_end_) {
+            readFrom = m_end_;
+            keep = (size_t)(m_end_ - begin);
+        }
+        if (!Reserve((size_t)(end - begin), begin - m_begin_, keep)) return nullptr;
+
+        if (!m_valid_ || readFrom != m_end_) {
+            ++r.seeks;
+            r.seekBytes += m_valid_ ? (readFrom > m_end_ ? readFrom - m_end_ : m_end_ - readFrom) : readFrom;
+        }
+        uint8_t* dst = m_buf_ + keep;
+        uint64_t at = readFrom;
+        while (at < end) {
+            DWORD chunk = (DWORD)std::min<uint64_t>(end - at, 64ull * 1024 * 1024);
+            OVERLAPPED ov{};
+            ov.Offset = (DWORD)at;
+            ov.OffsetHigh = (DWORD)(at >> 32);
+            DWORD got = 0;
+            if (!ReadFile(m_file_, dst, chunk, &got, &ov) && GetLastError() != ERROR_HANDLE_EOF) return nullptr;
+            r.readBytes += got;
+            // ファイル末尾のセクタは短く読める。エントリの範囲まで届いていれば良い
+            if (got < chunk) {
+                if (at + got < offset + size) return nullptr;
+                break;
+            }
+            dst += got;
+            at += got;
+        }
+        m_begin_ = begin;
+        m_end_ = end;
+        m_valid_ = true;
+        return m_buf_ + (offset - begin);
+    }
+
+private:
+    // size バイト以上の領域を用意し、旧領域の [from, from + keep) を先頭へ移す
+    bool Reserve(size_t size, uint64_t from, size_t keep) {
+        if (size <= m_cap_) {
+            if (keep) memmove(m_buf_, m_buf_ + from, keep);
+            return true;
+        }
+        size_t cap = std::max<size_t>(size, 4 * 1024 * 1024);
+        uint8_t* mem = static_cast<uint8_t*>(VirtualAlloc(nullptr, cap, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+        if (!mem) return false;
+        if (keep) memcpy(mem, m_buf_ + from, keep);
+        if (m_buf_) VirtualFree(m_buf_, 0, MEM_RELEASE);
+        m_buf_ = mem;
+        m_cap_ = cap;
+        return true;
+    }
+
+    HANDLE m_file_ = INVALID_HANDLE_VALUE;
+    uint8_t* m_buf_ = nullptr;
+    size_t m_cap_ = 0;
+    uint64_t m_begin_ = 0;
+    uint64_t m_end_ = 0;
+    bool m_valid_ = false;
+};
+
+double HddMs(const ReplayResult& r, const ReplayOptions& opt) {
+    return r.seeks * opt.hddSeekMs + r.readBytes / (opt.hddMBps * 1024.0 * 1024.0) * 1000.0;
+}
+
+void PrintRow(const ReplayResult& r, const ReplayOptions& opt) {
+    std::cout << "  " << std::left << std::setw(24) << r.scene << std::right
+        << std::setw(7) << r.assets
+        << std::setw(9) << std::fixed << std::setprecision(2) << r.readBytes / (1024.0 * 1024.0)
+        << std::setw(8) << r.seeks
+        << std::setw(10) << std::setprecision(1) << r.seekBytes / (1024.0 * 1024.0)
+        << std::setw(10) << std::setprecision(2) << r.ns / 1e6
+        << std::setw(12) << std::setprecision(1) << HddMs(r, opt);
+    if (r.missing) std::cout << "  (missing " << r.missing << ")";
+    std::cout << "\n";
+}
+
+bool ReplayArchive(const fs::path& pakPath, const std::vector<LoadTraceScene>& scenes, const ReplayOptions& opt) {
+    PakHeader header{};
+    std::vector<TempFileEntry> entries;
+    std::string err;
+    if (!ReadPakTOC(pakPath, header, entries, err)) {
+        std::cout << err << "\n";
+        return false;
+    }
+    std::vector<uint8_t> dict;
+    if (!ReadPakDictionary(pakPath, header, dict, err)) {
+        std::cout << err << "\n";
+        return false;
+    }
+    std::unordered_map<std::string, const TempFileEntry*> index;
+    index.reserve(entries.size());
+    for (const auto& e : entries) index.emplace(e.relativePath, &e);
+
+    SectorReader reader;
+    if (!reader.Open(pakPath, opt.buffered)) {
+        std::cout << "開けません: " << pakPath.string() << "\n";
+        return false;
+    }
+
+    std::cout << "== " << pakPath.string() << " (" << (opt.buffered ? "buffered" : "unbuffered")
+        << ", align=" << header.alignment << ")\n";
+    std::cout << "  " << std::left << std::setw(24) << "scene" << std::right << std::setw(7) << "assets"
+        << std::setw(9) << "read MB" << std::setw(8) << "seeks" << std::setw(10) << "seek MB"
+        << std::setw(10) << "time ms" << std::setw(12) << "HDD est ms" << "\n";
+
+    ReplayResult total;
+    total.scene = "total";
+    std::vector<uint8_t> out;
+    for (const auto& scene : scenes) {
+        ReplayResult r;
+        r.scene = scene.name;
+        auto t0 = std::chrono::steady_clock::now();
+        for (const auto& name : scene.assets) {
+            auto it = index.find(name);
+            if (it == index.end()) {
+                ++r.missing;
+                continue;
+            }
+            const TempFileEntry& e = *it->second;
+            const uint8_t* data = reader.Read(e.offset, e.storedSize, r);
+            if (!data) {
+                std::cout << "読込失敗: " << name << "\n";
+                return false;
+            }
+            // エンジンと同じく展開までを読み込み時間に含める
+            if (e.compression == (uint8_t)AssetCompression::LZ4) {
+                out.resize((size_t)e.originalSize);
+                if (!LZ4Util::DecompressChunked(data, (size_t)e.storedSize, out.data(), out.size())) {
+                    std::cout << "LZ4 展開失敗: " << name << "\n";
+                    return false;
+                }
+            }
+            else if (e.compression == (uint8_t)AssetCompression::LZ4Dict) {
+                out.resize((size_t)e.originalSize);
+                if (!LZ4Util::DecompressBlockDict(dict.data(), dict.size(), data, (size_t)e.storedSize,
+                    out.data(), out.size())) {
+                    std::cout << "LZ4Dict 展開失敗: " << name << "\n";
+                    return false;
+                }
+            }
+            ++r.assets;
+        }
+        r.ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - t0).count();
+        PrintRow(r, opt);
+        total.Add(r);
+    }
+    PrintRow(total, opt);
+    return true;
+}
+
+} // namespace
+
+int RunReplayBench(const fs::path& tracePath, const std::vector<fs::path>& archives, const ReplayOptions& opt) {
+    std::vector<LoadTraceScene> scenes;
+    std::string err;
+    if (!ReadLoadTrace(tracePath, scenes, err)) {
+        std::cout << err << "\n";
+        return 1;
+    }
+    std::cout << "トレース: " << tracePath.string() << " (" << scenes.size() << " scenes)\n";
+    std::cout << "HDD 換算: seek " << opt.hddSeekMs << " ms, " << opt.hddMBps << " MB/s\n";
+    for (const auto& pak : archives) {
+        if (!ReplayArchive(pak, scenes, opt)) return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include <vector>
+#include <filesystem>
+
+struct ReplayOptions {
+    bool buffered = false;  // true: OS のキャッシュを通して読む (既定はキャッシュを通さないコールド読み込み)
+    double hddSeekMs = 8.0; // HDD 換算の 1 シーク当たりの時間
+    double hddMBps = 150.0; // HDD 換算の連続読み込み速度
+};
+
+// ロードトレースの順にアーカイブのエントリを読み (LZ4 は展開まで行う)、シーン毎の
+// 読み込み時間 / 読んだバイト数 / シーク回数と、シーク回数から見積もった HDD 上の時間を表示する。
+// 同じトレースで複数のアーカイブを測って配置の違いを比べる。戻り値は終了コード
+int RunReplayBench(const std::filesystem::path& tracePath, const std::vector<std::filesystem::path>& archives,
+    const ReplayOptions& opt);
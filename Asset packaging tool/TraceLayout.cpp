@@ -0,0 +1,80 @@
+#include "TraceLayout.h"
+#include <fstream>
+#include <unordered_map>
+#include <algorithm>
+
+std::string NormalizeTracePath(std::string_view path) {
+    std::string s(path);
+    for (auto& c : s) {
+        if (c == '\\') c = '/';
+        else c = (char)tolower((unsigned char)c);
+    }
+    size_t start = 0;
+    for (;;) {
+        if (s.compare(start, 2, "./") == 0) start += 2;
+        else if (start < s.size() && s[start] == '/') start += 1;
+        else break;
+    }
+    return s.substr(start);
+}
+
+bool ReadLoadTrace(const std::filesystem::path& path, std::vector<LoadTraceScene>& scenes, std::string& error) {
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs) {
+        error = "トレースを開けません: " + path.string();
+        return false;
+    }
+    std::string line;
+    if (!std::getline(ifs, line) || line.rfind("# PIXTRACE 1", 0) != 0) {
+        error = "トレースの形式が違います: " + path.string();
+        return false;
+    }
+    // "@scene" より前の行は起動時の読み込みとして扱う
+    scenes.emplace_back().name = "(startup)";
+    while (std::getline(ifs, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+        if (line.rfind("@scene ", 0) == 0) {
+            if (scenes.back().assets.empty()) scenes.pop_back();
+            scenes.emplace_back().name = line.substr(7);
+            continue;
+        }
+        scenes.back().assets.push_back(NormalizeTracePath(line));
+    }
+    if (scenes.back().assets.empty()) scenes.pop_back();
+    return true;
+}
+
+TraceLayoutStats ApplyTraceOrder(const std::vector<LoadTraceScene>& scenes, std::vector<TempFileEntry>& files) {
+    TraceLayoutStats stats;
+    std::unordered_map<std::string, size_t> index;
+    index.reserve(files.size());
+    for (size_t i = 0; i < files.size(); ++i) index.emplace(files[i].relativePath, i);
+
+    std::vector<bool> placed(files.size(), false);
+    std::vector<size_t> order;
+    order.reserve(files.size());
+    for (const auto& scene : scenes) {
+        size_t before = order.size();
+        for (const auto& name : scene.assets) {
+            auto it = index.find(name);
+            if (it == index.end()) {
+                ++stats.missing;
+                continue;
+            }
+            if (placed[it->second]) continue;
+            placed[it->second] = true;
+            order.push_back(it->second);
+        }
+        if (order.size() > before) ++stats.scenes;
+    }
+    stats.placed = order.size();
+    for (size_t i = 0; i < files.size(); ++i)
+        if (!placed[i]) order.push_back(i);
+
+    std::vector<TempFileEntry> sorted;
+    sorted.reserve(files.size());
+    for (size_t i : order) sorted.push_back(std::move(files[i]));
+    files = std::move(sorted);
+    return stats;
+}
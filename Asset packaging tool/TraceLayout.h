@@ -0,0 +1,29 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <filesystem>
+#include "PakToc.h"
+
+// エンジンの AssetManager が書き出すロードトレース (Pixeon_Engine/LoadTrace.h 参照) の 1 シーン分
+struct LoadTraceScene {
+    std::string name;
+    std::vector<std::string> assets; // 正規化済みの論理パス (初回使用順)
+};
+
+// トレースを読み込んで scenes の末尾に追加する。失敗時は error に理由を入れて false
+bool ReadLoadTrace(const std::filesystem::path& path, std::vector<LoadTraceScene>& scenes, std::string& error);
+
+// パッカーの relativePath と同じ形 (小文字 / '/' 区切り / 先頭の "./" "/" 無し) にする
+std::string NormalizeTracePath(std::string_view path);
+
+struct TraceLayoutStats {
+    size_t scenes = 0;  // 1 件以上配置したシーン数
+    size_t placed = 0;  // トレース順に並べたファイル数
+    size_t missing = 0; // トレースにあるが入力に無いアセット数
+};
+
+// files をトレースの初回使用順に並べ替える。シーン毎に連続した領域になり、
+// 複数シーンで使うアセットは最初に使うシーンの領域に置く。トレースに無いファイルは元の順で末尾へ
+TraceLayoutStats ApplyTraceOrder(const std::vector<LoadTraceScene>& scenes, std::vector<TempFileEntry>& files);
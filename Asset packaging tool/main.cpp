@@ -7,22 +7,71 @@
 #include <iostream>
 #include <algorithm>
 #include <iomanip>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <unordered_map>
 #include "ArchiveFormat.h"
 #include "HashUtill.h"
+#include "LZ4Util.h"
+#include "PakToc.h"
+#include "TraceLayout.h"
+#include "ReplayBench.h"
+#include "DictTrainer.h"
+#include "DictBench.h"
 
 namespace fs = std::filesystem;
 
 static uint64_t AlignValue(uint64_t v, uint64_t a) { return (v + (a - 1)) & ~(a - 1); }
 
-struct TempFileEntry {
-    std::string relativePath;
-    uint64_t originalSize = 0;
-    uint64_t storedSize = 0;
-    uint64_t offset = 0;
-    uint32_t crc32 = 0;
-    uint8_t  compression = 0;
-    std::array<uint8_t, 32> sha256{};
-};
+// --group-small ŋl߂t@C̋E (LZ4 ̓WJ SIMD ̃[hȂŏP)
+static constexpr uint64_t kGroupedAlignment = 16;
+
+// Ɉkς݂̌` LZ4 Ăk܂Ȃ̂ł̂܂܊i[
+static bool IsPreCompressed(const std::string& relativePath) {
+    // relativePath  CollectFiles ŏς
+    static const char* exts[] = { ".png", ".jpg", ".jpeg", ".ogg", ".mp3", ".zip", ".pixassets" };
+    for (auto* e : exts) {
+        size_t n = strlen(e);
+        if (relativePath.size() >= n && relativePath.compare(relativePath.size() - n, n, e) == 0)
+            return true;
+    }
+    return false;
+}
+
+// L̊wKɎgTv̍v̏ (TCYɑ΂{)
+static constexpr size_t kDictSampleFactor = 100;
+// 菬t@C͎gĂkޗ]nقƂǖ
+static constexpr uint64_t kMinDictFileSize = 16;
+
+// ̑Ώ (maxSize ȉ̖k`) ̃t@CǂށBv budget 𒴂镪͓ԊuɊԈ
+static std::vector<std::vector<uint8_t>> CollectDictSamples(const fs::path& inputDir,
+    const std::vector<TempFileEntry>& files, uint64_t maxSize, size_t budget) {
+    std::vector<std::pair<size_t, uint64_t>> candidates; // (files ̓Y, TCY)
+    uint64_t total = 0;
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (IsPreCompressed(files[i].relativePath)) continue;
+        std::error_code ec;
+        uint64_t sz = fs::file_size(inputDir / files[i].relativePath, ec);
+        if (ec || sz < kMinDictFileSize || sz > maxSize) continue;
+        candidates.emplace_back(i, sz);
+        total += sz;
+    }
+    const double step = total > budget ? (double)total / budget : 1.0;
+    std::vector<std::vector<uint8_t>> samples;
+    double next = 0.0;
+    for (size_t k = 0; k < candidates.size(); ++k) {
+        if ((double)k < next) continue;
+        next += step;
+        std::ifstream ifs(inputDir / files[candidates[k].first].relativePath, std::ios::binary);
+        std::vector<uint8_t> buf((size_t)candidates[k].second);
+        if (!ifs || !ifs.read(reinterpret_cast<char*>(buf.data()), buf.size())) continue;
+        samples.push_back(std::move(buf));
+    }
+    return samples;
+}
 
 static void CollectFiles(const fs::path& root, std::vector<TempFileEntry>& out) {
     for (auto& p : fs::recursive_directory_iterator(root)) {
@@ -36,122 +85,919 @@ static void CollectFiles(const fs::path& root, std::vector<TempFileEntry>& out)
     }
 }
 
+static std::string ToHex(const std::array<uint8_t, 32>& bytes) {
+    static const char* digits = "0123456789abcdef";
+    std::string s;
+    s.reserve(64);
+    for (uint8_t b : bytes) {
+        s += digits[b >> 4];
+        s += digits[b & 15];
+    }
+    return s;
+}
+
+// dřʂoBpayloadOwner[i]  files[i] i[f[^L̓Y (LȂ i)
+static bool WriteDedupReport(const fs::path& path, const std::vector<TempFileEntry>& files,
+    const std::vector<size_t>& payloadOwner) {
+    std::vector<std::vector<size_t>> groups(files.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (payloadOwner[i] != i) groups[payloadOwner[i]].push_back(i);
+    }
+    // 팸ʂ̑傫ɕׂ
+    std::vector<size_t> owners;
+    for (size_t i = 0; i < files.size(); ++i)
+        if (!groups[i].empty()) owners.push_back(i);
+    std::sort(owners.begin(), owners.end(), [&](size_t a, size_t b) {
+        uint64_t sa = files[a].storedSize * groups[a].size();
+        uint64_t sb = files[b].storedSize * groups[b].size();
+        return sa != sb ? sa > sb : a < b;
+    });
+
+    std::ofstream ofs(path, std::ios::binary);
+    if (!ofs) return false;
+    uint64_t saved = 0;
+    size_t dupCount = 0;
+    for (size_t o : owners) {
+        saved += files[o].storedSize * groups[o].size();
+        dupCount += groups[o].size();
+    }
+    ofs << "# dedup: " << owners.size() << " payloads shared by " << dupCount << " duplicates, "
+        << saved << " stored bytes saved\n";
+    for (size_t o : owners) {
+        const TempFileEntry& fe = files[o];
+        ofs << ToHex(fe.sha256) << " stored=" << fe.storedSize << " copies=" << groups[o].size() + 1
+            << " saved=" << fe.storedSize * groups[o].size() << "\n";
+        ofs << "  " << fe.relativePath << "\n";
+        for (size_t d : groups[o]) ofs << "  " << files[d].relativePath << "\n";
+    }
+    return (bool)ofs;
+}
+
+// [J[ 1 t@ČʁB݃Xbh index Ɏo
+struct ProcessedFile {
+    bool ready = false;
+    bool ok = false;
+    std::string error;
+    std::vector<uint8_t> payload; // A[JCu֏ރoCg (kς or f[^)
+    bool reuse = false;           // true ȂOA[JCu reuseOffset  storedSize oCg𕡎ʂ
+    bool skip = false;            // pb`쐬: x[XƓȂ̂ŏo͂Ȃ
+    uint64_t reuseOffset = 0;
+};
+
+// rh / pb`쐬p: O (x[X) ̃A[JCu TOC
+struct IncrementalBase {
+    std::vector<TempFileEntry> entries;
+    std::unordered_map<std::string, size_t> index; // relativePath  entries ̓Y
+    fs::file_time_type time;                       // ÕpbNJn (O̍XVȂǂ܂ɗpł)
+    bool hasTime = false;                          // false Ȃ time  (.pixcache  / Ȃ) ̂ŃnbVŔr
+    bool stdSha = false;                           // sha256 W SHA-256  (ÂA[JCu͔W)
+    std::vector<uint8_t> dict;                     // ÕA[JCűL (΋)
+};
+
+struct PackOptions {
+    bool compress = true;
+    double maxRatio = 0.9;
+    const IncrementalBase* base = nullptr;
+    bool patch = false; // true: base ƓeقȂGgo͂
+    const std::vector<uint8_t>* dict = nullptr; // LZ4Dict ɎgL (gȂ null)
+    uint64_t dictMaxSize = 0;                   // gt@C̏TCY
+    bool baseDictShared = false;                // dict  base ̎Ɠ (base  LZ4Dict 𗬗pł)
+};
+
+// Xe[W̗ݐϏ (S[J[v, imb)
+struct StageStats {
+    std::atomic<uint64_t> readNs{ 0 };
+    std::atomic<uint64_t> hashNs{ 0 };
+    std::atomic<uint64_t> compressNs{ 0 };
+    std::atomic<uint64_t> readBytes{ 0 };
+    std::atomic<uint64_t> compressBytes{ 0 };
+    std::atomic<uint64_t> reusedFiles{ 0 };   // O̊i[f[^̂܂܎gt@C
+    std::atomic<uint64_t> reusedHashed{ 0 };  // L̂nbVrňvmF
+};
+
+// rhp̏ <output>.pixcache ɒu (A[JCu͓͂ɓoCgɂ)B
+// pbNJnƁAǂ̃A[JCuɂĂ̏񂩂m߂邽߂̃TCY / TOC ʒu
+struct PackCacheInfo {
+    uint64_t packStartTime = 0; // file_time_type  tick 
+    uint64_t archiveSize = 0;
+    uint64_t tocOffset = 0;
+};
+
+static fs::path PackCachePath(const fs::path& outputPak) {
+    fs::path p = outputPak;
+    p += ".pixcache";
+    return p;
+}
+
+static bool ReadPackCache(const fs::path& outputPak, PackCacheInfo& info) {
+    std::ifstream ifs(PackCachePath(outputPak));
+    std::string magic;
+    if (!ifs || !(ifs >> magic) || magic != "PIXCACHE1") return false;
+    std::string key;
+    uint64_t value = 0;
+    while (ifs >> key >> value) {
+        if (key == "packStartTime") info.packStartTime = value;
+        else if (key == "archiveSize") info.archiveSize = value;
+        else if (key == "tocOffset") info.tocOffset = value;
+    }
+    return info.packStartTime != 0;
+}
+
+static bool WritePackCache(const fs::path& outputPak, const PackCacheInfo& info) {
+    const fs::path path = PackCachePath(outputPak);
+    fs::path tmp = path;
+    tmp += ".tmp";
+    {
+        std::ofstream ofs(tmp, std::ios::trunc);
+        ofs << "PIXCACHE1\n"
+            << "packStartTime " << info.packStartTime << "\n"
+            << "archiveSize " << info.archiveSize << "\n"
+            << "tocOffset " << info.tocOffset << "\n";
+        if (!ofs) return false;
+    }
+    std::error_code ec;
+    fs::rename(tmp, path, ec);
+    return !ec;
+}
+
+static uint64_t ElapsedNs(std::chrono::steady_clock::time_point from) {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - from).count();
+}
+
+static double ToMBps(uint64_t bytes, uint64_t ns) {
+    if (ns == 0) return 0.0;
+    return (double)bytes / (1024.0 * 1024.0) / ((double)ns / 1e9);
+}
+
+// O̊i[f[^𗬗pł邩 (k𖳌ɂꍇ LZ4 i[蒼B
+// LZ4Dict ͓gꍇ)
+static bool CanReuse(const TempFileEntry* prev, const PackOptions& opt) {
+    if (!prev) return false;
+    if (prev->compression == (uint8_t)AssetCompression::LZ4Dict) return opt.compress && opt.baseDictShared;
+    return opt.compress || prev->compression == (uint8_t)AssetCompression::None;
+}
+
+// eOƓBÂA[JCu sha256 ͔rłȂ̂ŃTCY CRC32 Ŕ肷
+static bool SameContent(const TempFileEntry& prev, const TempFileEntry& fe, const PackOptions& opt) {
+    if (prev.originalSize != fe.originalSize) return false;
+    if (opt.base->stdSha) return prev.sha256 == fe.sha256;
+    return prev.crc32 == fe.crc32;
+}
+
+static void ReusePrevious(TempFileEntry& fe, const TempFileEntry& prev, ProcessedFile& out) {
+    fe.originalSize = prev.originalSize;
+    fe.storedSize = prev.storedSize;
+    fe.crc32 = prev.crc32;
+    fe.compression = prev.compression;
+    fe.sha256 = prev.sha256;
+    out.reuse = true;
+    out.reuseOffset = prev.offset;
+    out.ok = true;
+}
+
+// buf  LZ4 (t@C͋Lt) ňk packed / method ֓B
+// k܂Ȃ (maxRatio 𒴂) k̑ΏۊOȂ false (kŊi[)
+static bool EncodePayload(const std::vector<uint8_t>& buf, const PackOptions& opt,
+    std::vector<uint8_t>& packed, AssetCompression& method) {
+    // t@C̓`Nwb_œȂ
+    const uint64_t kMinCompressSize = 512;
+    const uint64_t sz = buf.size();
+    packed.clear();
+    method = AssetCompression::LZ4;
+    const bool useDict = opt.dict && sz >= kMinDictFileSize && sz <= opt.dictMaxSize;
+    if (sz < kMinCompressSize && !useDict) return false;
+    if (sz >= kMinCompressSize) LZ4Util::CompressChunked(buf.data(), buf.size(), packed);
+    // t@C͋Lt 1 ubNÂ
+    if (useDict) {
+        std::vector<uint8_t> block(LZ4Util::CompressBound((size_t)sz));
+        size_t c = LZ4Util::CompressBlockDict(opt.dict->data(), opt.dict->size(),
+            buf.data(), buf.size(), block.data(), block.size());
+        if (c > 0 && (packed.empty() || c < packed.size())) {
+            block.resize(c);
+            packed = std::move(block);
+            method = AssetCompression::LZ4Dict;
+        }
+    }
+    return !packed.empty() && (double)packed.size() <= (double)sz * opt.maxRatio;
+}
+
+// ǂݍ  CRC32/SHA-256  LZ4 kBʂ fe  out Ɋi[ (ItZbg͏ݑŌ߂)
+static void ProcessFile(const fs::path& inputDir, TempFileEntry& fe, ProcessedFile& out,
+    const PackOptions& opt, StageStats& stats) {
+    fs::path full = inputDir / fe.relativePath;
+
+    // rh: TCYőÕpbNJnOɍXVꂽt@C͓ǂ܂ɑÕf[^g
+    // (pbNɏꂽt@C͊JnVȂ̂Ŏ͓ǂݒ)
+    const TempFileEntry* prev = nullptr;
+    if (opt.base) {
+        auto it = opt.base->index.find(fe.relativePath);
+        if (it != opt.base->index.end()) prev = &opt.base->entries[it->second];
+    }
+    // pb`͔zzɂȂ̂ōXV͐MpKnbVŔr
+    // ÂA[JCu sha256 ͈pȂ̂œǂݒ
+    if (!opt.patch && CanReuse(prev, opt) && opt.base->stdSha && opt.base->hasTime) {
+        std::error_code ec1, ec2;
+        uint64_t curSize = fs::file_size(full, ec1);
+        auto curTime = fs::last_write_time(full, ec2);
+        if (!ec1 && !ec2 && curSize == prev->originalSize && curTime < opt.base->time) {
+            ReusePrevious(fe, *prev, out);
+            ++stats.reusedFiles;
+            return;
+        }
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::ifstream ifs(full, std::ios::binary | std::ios::ate);
+    if (!ifs) {
+        out.error = "Ǎs: " + full.string();
+        return;
+    }
+    uint64_t sz = (uint64_t)ifs.tellg();
+    ifs.seekg(0, std::ios::beg);
+    std::vector<uint8_t> buf;
+    buf.resize((size_t)sz);
+    if (sz > 0) {
+        if (!ifs.read(reinterpret_cast<char*>(buf.data()), sz)) {
+            out.error = "ǍG[: " + full.string();
+            return;
+        }
+    }
+    stats.readNs += ElapsedNs(t0);
+    stats.readBytes += sz;
+
+    // CRC32 / SHA-256 ͓WJ (t@C) ̃oCgɑ΂ČvZ
+    auto t1 = std::chrono::steady_clock::now();
+    fe.originalSize = sz;
+    fe.storedSize = sz;
+    fe.crc32 = HashUtil::CalcCRC32(buf.data(), buf.size());
+    fe.sha256 = HashUtil::SHA256(buf);
+    stats.hashNs += ElapsedNs(t1);
+
+    if (prev && opt.patch && SameContent(*prev, fe, opt)) {
+        out.skip = true;
+        out.ok = true;
+        return;
+    }
+    // XVςꍇ̓nbVvŔ肵ĈkȂ
+    if (CanReuse(prev, opt) && SameContent(*prev, fe, opt)) {
+        auto sha = fe.sha256;
+        ReusePrevious(fe, *prev, out);
+        fe.sha256 = sha;
+        ++stats.reusedFiles;
+        ++stats.reusedHashed;
+        return;
+    }
+
+    if (opt.compress && !IsPreCompressed(fe.relativePath)) {
+        auto t2 = std::chrono::steady_clock::now();
+        std::vector<uint8_t> packed;
+        AssetCompression method;
+        const bool compressed = EncodePayload(buf, opt, packed, method);
+        stats.compressNs += ElapsedNs(t2);
+        stats.compressBytes += sz;
+        if (compressed) {
+            fe.compression = (uint8_t)method;
+            fe.storedSize = packed.size();
+            out.payload = std::move(packed);
+            out.ok = true;
+            return;
+        }
+    }
+    out.payload = std::move(buf);
+    out.ok = true;
+}
+
+// LŌi[TCY (gꍇ LZ4 / k̏ꍇ̍) Ώۂ̑St@CōvB
+// ̂̑傫𒴂ȂΎuɂȂ
+static uint64_t MeasureDictSavings(const fs::path& inputDir, const std::vector<TempFileEntry>& files,
+    const PackOptions& opt) {
+    PackOptions noDict = opt;
+    noDict.dict = nullptr;
+    uint64_t savings = 0;
+    std::vector<uint8_t> buf, packed;
+    for (const TempFileEntry& fe : files) {
+        if (IsPreCompressed(fe.relativePath)) continue;
+        std::error_code ec;
+        const uint64_t sz = fs::file_size(inputDir / fe.relativePath, ec);
+        if (ec || sz < kMinDictFileSize || sz > opt.dictMaxSize) continue;
+        std::ifstream ifs(inputDir / fe.relativePath, std::ios::binary);
+        buf.resize((size_t)sz);
+        if (!ifs || !ifs.read(reinterpret_cast<char*>(buf.data()), buf.size())) continue;
+        AssetCompression method;
+        const uint64_t withDict = EncodePayload(buf, opt, packed, method) ? packed.size() : sz;
+        if (method != AssetCompression::LZ4Dict) continue; // gȂt@C͓i[ɂȂ
+        const uint64_t without = EncodePayload(buf, noDict, packed, method) ? packed.size() : sz;
+        if (without > withDict) savings += without - withDict;
+    }
+    return savings;
+}
+
+// offset  alignment ̔{܂ 0 Ŗ߂B߂l͖߂̃ItZbg
+static uint64_t WritePadding(std::ofstream& out, uint64_t offset, uint64_t alignment) {
+    uint64_t aligned = AlignValue(offset, alignment);
+    size_t pad = (size_t)(aligned - offset);
+    static const char padBuf[4096]{};
+    while (pad > 0) {
+        size_t chunk = std::min<size_t>(pad, sizeof(padBuf));
+        out.write(padBuf, chunk);
+        pad -= chunk;
+    }
+    return aligned;
+}
+
+// ÕA[JCui[f[^̂܂ܕʂ
+static bool CopyBlock(std::ifstream& in, uint64_t offset, uint64_t size, std::ofstream& out, std::vector<char>& buf) {
+    if (size == 0) return true;
+    buf.resize(1024 * 1024);
+    in.clear();
+    in.seekg((std::streamoff)offset, std::ios::beg);
+    while (size > 0) {
+        size_t n = (size_t)std::min<uint64_t>(size, buf.size());
+        if (!in.read(buf.data(), n)) return false;
+        out.write(buf.data(), n);
+        size -= n;
+    }
+    return true;
+}
+
+// --replay <trace> <archive>... [--buffered] [--hdd-seek-ms MS] [--hdd-mbps MBPS]
+static int ReplayMain(int argc, char* argv[]) {
+    ReplayOptions opt;
+    fs::path trace;
+    std::vector<fs::path> archives;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--buffered") opt.buffered = true;
+        else if (arg == "--hdd-seek-ms" && i + 1 < argc) opt.hddSeekMs = std::stod(argv[++i]);
+        else if (arg == "--hdd-mbps" && i + 1 < argc) opt.hddMBps = std::stod(argv[++i]);
+        else if (trace.empty()) trace = arg;
+        else archives.push_back(arg);
+    }
+    if (trace.empty() || archives.empty()) {
+        std::cout << "gp@: PixAssetPacker.exe --replay <trace.txt> <a.pak> [b.pak ...] [--buffered] [--hdd-seek-ms MS] [--hdd-mbps MBPS]\n";
+        return 1;
+    }
+    return RunReplayBench(trace, archives, opt);
+}
+
+// --bench-dict <input_dir> [--dict-size N] [--dict-max N] [--rounds N]
+static int DictBenchMain(int argc, char* argv[]) {
+    DictBenchOptions opt;
+    fs::path inputDir;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--dict-size" && i + 1 < argc) opt.dictSize = std::stoul(argv[++i]);
+        else if (arg == "--dict-max" && i + 1 < argc) opt.maxFileSize = std::stoul(argv[++i]);
+        else if (arg == "--rounds" && i + 1 < argc) opt.rounds = std::max(1, std::stoi(argv[++i]));
+        else inputDir = arg;
+    }
+    if (inputDir.empty() || !fs::is_directory(inputDir)) {
+        std::cout << "gp@: PixAssetPacker.exe --bench-dict <input_dir> [--dict-size N] [--dict-max N] [--rounds N]\n";
+        return 1;
+    }
+    opt.dictSize = std::min<size_t>(std::max<size_t>(opt.dictSize, 1024), kLZ4DictMaxSize);
+    opt.maxFileSize = std::min<uint64_t>(opt.maxFileSize, kLZ4ChunkSize);
+    std::vector<TempFileEntry> files;
+    CollectFiles(inputDir, files);
+    std::sort(files.begin(), files.end(),
+        [](const TempFileEntry& a, const TempFileEntry& b) { return a.relativePath < b.relativePath; });
+    // St@CΏۂɑ (ԈȂ)B̊wK͎ۂ̃pbNƓŊԈ
+    std::vector<std::vector<uint8_t>> all = CollectDictSamples(inputDir, files, opt.maxFileSize, SIZE_MAX);
+    std::vector<std::vector<uint8_t>> samples = CollectDictSamples(inputDir, files, opt.maxFileSize,
+        opt.dictSize * kDictSampleFactor);
+    return RunDictBench(all, samples, opt);
+}
+
+// --bench-hash [input_dir] [--size MB] [--rounds N]
+static int HashBenchMain(int argc, char* argv[]) {
+    size_t sizeMB = 64;
+    int rounds = 5;
+    fs::path inputDir;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--size" && i + 1 < argc) sizeMB = std::max<size_t>(1, std::stoul(argv[++i]));
+        else if (arg == "--rounds" && i + 1 < argc) rounds = std::max(1, std::stoi(argv[++i]));
+        else if (inputDir.empty() && fs::is_directory(arg)) inputDir = arg;
+        else {
+            std::cout << "gp@: PixAssetPacker.exe --bench-hash [input_dir] [--size MB] [--rounds N]\n";
+            return 1;
+        }
+    }
+    // ƍĂ瑪 (ʂႤ̑x͈Ӗ)
+    std::string log;
+    const bool ok = HashUtil::SelfTest(log);
+    HashUtil::Benchmark(log, sizeMB << 20, rounds);
+    // input_dir ΃pbNƓ΃pX () L[ɂă}bv̑xׂ
+    if (!inputDir.empty()) {
+        std::vector<TempFileEntry> files;
+        CollectFiles(inputDir, files);
+        std::vector<std::string> names;
+        names.reserve(files.size());
+        for (const TempFileEntry& fe : files) names.push_back(fe.relativePath);
+        HashUtil::BenchmarkStringMap(names, log, rounds);
+    }
+    std::cout << log << (ok ? "ALL PASS" : "FAILED") << "\n";
+    return ok ? 0 : 1;
+}
+
 int main(int argc, char* argv[]) {
     SetConsoleOutputCP(CP_UTF8);
-    if (argc < 3 || argc > 4) {
-        std::cout << "gp@: PixAssetPacker.exe <input_dir> <output.pak> [alignment]\n";
+    if (argc >= 2 && std::string(argv[1]) == "--replay") return ReplayMain(argc, argv);
+    if (argc >= 2 && std::string(argv[1]) == "--bench-dict") return DictBenchMain(argc, argv);
+    if (argc >= 2 && std::string(argv[1]) == "--bench-hash") return HashBenchMain(argc, argv);
+    if (argc < 3) {
+        std::cout << "gp@: PixAssetPacker.exe <input_dir> <output.pak> [alignment] [--no-compress] [--ratio R] [--jobs N] [--group-small N] [--trace FILE]... [--no-dedup] [--dedup-report FILE] [--dict [--dict-size N] [--dict-max N]] [--incremental | --patch-base BASE]\n";
+        std::cout << "       PixAssetPacker.exe --replay <trace.txt> <a.pak> [b.pak ...] [--buffered]\n";
+        std::cout << "       PixAssetPacker.exe --bench-dict <input_dir> [--dict-size N] [--dict-max N] [--rounds N]\n";
+        std::cout << "       PixAssetPacker.exe --bench-hash [input_dir] [--size MB] [--rounds N]\n";
+        std::cout << "  --no-compress : LZ4 ksȂ\n";
+        std::cout << "  --ratio R     : kTCY R {ȉ̏ꍇ݈̂kĊi[ ( 0.9)\n";
+        std::cout << "  --jobs N      : Ǎ / nbV / ks[J[ (: _RA)\n";
+        std::cout << "  --group-small N : i[TCY N oCg̃t@C 16 oCgEŋl߁Aalignment ̃ubNL\n";
+        std::cout << "  --trace FILE  : GW̃[hg[X̏gpɁAV[ɂ܂Ƃ߂Ĕzu (w)\n";
+        std::cout << "  --no-dedup    : e (SHA-256) t@CʁXɊi[ (ł 1 ̊i[f[^L)\n";
+        std::cout << "  --dedup-report FILE : Li[f[^ƁAwt@C̈ꗗ FILE ֏o\n";
+        std::cout << "  --dict        : t@C狤LwKăwb_ɒuAt LZ4 (LZ4Dict) Ŋi[\n"
+            "                (LZ4 ɔׂ팸̑傫ȉȂ玫u LZ4 Ŋi[)\n";
+        std::cout << "  --dict-size N : ̃oCg ( 65536,  65536)\n";
+        std::cout << "  --dict-max N  : gt@C̏TCY ( 16384)\n";
+        std::cout << "  --bench-dict  : t@C None / LZ4 / LZ4Dict Ŋi[ꍇ̈kƓWJxׂ\n";
+        std::cout << "  --bench-hash  : CRC32 (PCLMUL) / SHA-256 (SHA-NI) ƏƍAȇx (GB/s) 𑪂B\n"
+            "                input_dir nƂ̑΃pX StringMap  std::hash<std::string> ̃}bvׂ\n";
+        std::cout << "  --replay      : g[X̏ɃA[JCuǂ݁AV[̓ǂݍݎԂƃV[N񐔂\\n";
+        std::cout << "  --incremental : ̏o̓A[JCu疢ύXt@C̊i[f[^𕡎ʂ (<output>.pixcache ̊JnōXV𔻒)\n";
+        std::cout << "  --patch-base BASE : BASE ƓeقȂ / BASE ɖt@C̃pb`A[JCu\n";
         return 1;
     }
 
     fs::path inputDir = argv[1];
     fs::path outputPak = argv[2];
     uint32_t alignment = 16;
-    if (argc == 4) alignment = std::max<uint32_t>(1, std::stoul(argv[3]));
+    PackOptions opt;
+    unsigned jobs = std::max(1u, std::thread::hardware_concurrency());
+    bool incremental = false;
+    uint32_t groupSmall = 0;
+    std::vector<fs::path> traces;
+    fs::path patchBase;
+    bool dedup = true;
+    fs::path dedupReport;
+    bool useDict = false;
+    size_t dictSize = kLZ4DictMaxSize;
+    uint64_t dictMax = 16 * 1024;
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--no-compress") opt.compress = false;
+        else if (arg == "--ratio" && i + 1 < argc) opt.maxRatio = std::stod(argv[++i]);
+        else if (arg == "--incremental") incremental = true;
+        else if (arg == "--patch-base" && i + 1 < argc) patchBase = argv[++i];
+        else if (arg == "--jobs" && i + 1 < argc) jobs = std::max(1ul, std::stoul(argv[++i]));
+        else if (arg == "--group-small" && i + 1 < argc) groupSmall = (uint32_t)std::stoul(argv[++i]);
+        else if (arg == "--trace" && i + 1 < argc) traces.push_back(argv[++i]);
+        else if (arg == "--no-dedup") dedup = false;
+        else if (arg == "--dedup-report" && i + 1 < argc) dedupReport = argv[++i];
+        else if (arg == "--dict") useDict = true;
+        else if (arg == "--dict-size" && i + 1 < argc) dictSize = std::stoul(argv[++i]);
+        else if (arg == "--dict-max" && i + 1 < argc) dictMax = std::stoull(argv[++i]);
+        else alignment = std::max<uint32_t>(1, std::stoul(arg));
+    }
+
+    // ubN傫t@C͂܂Ƃ߂Ăǂݍ݉񐔂Ȃ
+    groupSmall = std::min(groupSmall, alignment);
+    // LZ4 ̎QƋɎ܂鎫ƁA1 ubNœWJłt@CɌ
+    dictSize = std::min<size_t>(std::max<size_t>(dictSize, 1024), kLZ4DictMaxSize);
+    dictMax = std::min<uint64_t>(dictMax, kLZ4ChunkSize);
+
+    if (incremental && !patchBase.empty()) {
+        std::cout << "--incremental  --patch-base ͓Ɏwł܂\n";
+        return 1;
+    }
 
     if (!fs::exists(inputDir) || !fs::is_directory(inputDir)) {
         std::cout << "̓fBNg݂܂\n";
         return 1;
     }
 
+    // 񋓂OɎBȍ~ɍXVꂽt@C͎̍rhœǂݒ
+    const fs::file_time_type packStart = fs::file_time_type::clock::now();
     std::vector<TempFileEntry> files;
     CollectFiles(inputDir, files);
     if (files.empty()) {
         std::cout << "Ώۃt@C܂\n";
         return 1;
     }
+    // 񋓏̓t@CVXeˑȂ̂ŃpXŃ\[gAo͂𖈉񓯈ɂ
+    std::sort(files.begin(), files.end(),
+        [](const TempFileEntry& a, const TempFileEntry& b) { return a.relativePath < b.relativePath; });
+
+    // [hg[X΃V[ɏgpŕׁA1 V[̓ǂݍ݂A[JCuŘA悤ɂ
+    if (!traces.empty()) {
+        std::vector<LoadTraceScene> scenes;
+        for (const auto& t : traces) {
+            std::string err;
+            if (!ReadLoadTrace(t, scenes, err)) {
+                std::cout << err << "\n";
+                return 1;
+            }
+        }
+        TraceLayoutStats ts = ApplyTraceOrder(scenes, files);
+        std::cout << "g[Xzu: " << ts.placed << " files / " << ts.scenes << " scenes";
+        if (ts.missing) std::cout << " (͂ɖAZbg " << ts.missing << " )";
+        std::cout << "\n";
+    }
 
     HashUtil::InitCRC32();
 
+    // pb`쐬: x[X TOC  SHA-256 ׁAقȂGgo͂
+    // rh: ÕA[JCuǂ݁AVA[JCu͈ꎞt@C֏Ău
+    IncrementalBase base;
+    std::vector<std::string> removedFromBase; // pb`쐬Ax[Xɂē͂ɖGg
+    std::ifstream prevIn;
+    fs::path writePath = outputPak;
+    if (!patchBase.empty()) {
+        PakHeader baseHeader{};
+        std::string err;
+        if (!ReadPakTOC(patchBase, baseHeader, base.entries, err)) {
+            std::cout << err << "\n";
+            return 1;
+        }
+        if (HasFlag((uint16_t)baseHeader.flags, AssetFlag_PatchData)) {
+            std::cout << "x[XɃpb`A[JCu͎wł܂: " << patchBase << "\n";
+            return 1;
+        }
+        if (!ReadPakDictionary(patchBase, baseHeader, base.dict, err)) {
+            std::cout << err << "\n";
+            return 1;
+        }
+        for (size_t i = 0; i < base.entries.size(); ++i) base.index[base.entries[i].relativePath] = i;
+        base.stdSha = HasFlag((uint16_t)baseHeader.flags, AssetFlag_StdSHA256);
+        opt.base = &base;
+        opt.patch = true;
+
+        // pb`̓x[X̃GgȂ (TOC ɍ폜̈󂪖) ̂ŁA͂t@C
+        // pb`d˂Ăx[X̓ê܂ܓǂ߂Ă܂BCt悤Ɉꗗo
+        HashUtil::StringMap<bool> inputs;
+        for (const TempFileEntry& fe : files) inputs.emplace(fe.relativePath, true);
+        for (const TempFileEntry& be : base.entries) {
+            if (inputs.find(be.relativePath) == inputs.end()) removedFromBase.push_back(be.relativePath);
+        }
+        std::sort(removedFromBase.begin(), removedFromBase.end());
+        if (!removedFromBase.empty()) {
+            std::cout << "x: x[Xɂē͂ɖt@C " << removedFromBase.size()
+                << " ܂ (pb`ł͍폜łȂ߁Ax[X̓eǂ܂ꑱ܂)\n";
+            for (const std::string& path : removedFromBase) std::cout << "  " << path << "\n";
+        }
+    }
+    else if (incremental) {
+        PakHeader prevHeader{};
+        std::string err;
+        if (!fs::exists(outputPak)) {
+            std::cout << "ÕA[JCuߑŜrh܂\n";
+        }
+        else if (!ReadPakTOC(outputPak, prevHeader, base.entries, err) ||
+            !ReadPakDictionary(outputPak, prevHeader, base.dict, err)) {
+            base.entries.clear();
+            std::cout << err << "\nÕA[JCug킸ɑŜrh܂\n";
+        }
+        else {
+            // ÕA[JCu̍XV̓pbNIȂ̂ŁApbNɍXVꂽt@CB
+            // .pixcache ̃pbNJnƔׁA / ʂ̃A[JCû̂ȂSt@CnbVŔr
+            PackCacheInfo cache;
+            std::error_code ec;
+            const uint64_t prevSize = fs::file_size(outputPak, ec);
+            if (ReadPackCache(outputPak, cache) && !ec && cache.archiveSize == prevSize && cache.tocOffset == prevHeader.tocOffset) {
+                base.hasTime = true;
+                base.time = fs::file_time_type(fs::file_time_type::duration((fs::file_time_type::rep)cache.packStartTime));
+            }
+            else {
+                std::cout << "rh (" << PackCachePath(outputPak).filename().string() << ") vȂߑSt@CnbVŔr܂\n";
+            }
+            base.stdSha = HasFlag((uint16_t)prevHeader.flags, AssetFlag_StdSHA256);
+            for (size_t i = 0; i < base.entries.size(); ++i) base.index[base.entries[i].relativePath] = i;
+            prevIn.open(outputPak, std::ios::binary);
+            opt.base = &base;
+            writePath += ".tmp";
+        }
+    }
+
+    // LBO (x[X) ̃A[JCuɎ΂gALZ4Dict ̊i[f[^𗬗pł悤ɂ
+    std::vector<uint8_t> dictionary;
+    if (useDict && opt.compress) {
+        if (opt.base && !opt.base->dict.empty()) {
+            dictionary = opt.base->dict;
+            opt.baseDictShared = true;
+            std::cout << "L: x[X̎gp (" << dictionary.size() << " bytes)\n";
+        }
+        else {
+            auto td = std::chrono::steady_clock::now();
+            std::vector<std::vector<uint8_t>> samples = CollectDictSamples(inputDir, files, dictMax,
+                dictSize * kDictSampleFactor);
+            dictionary = TrainDictionary(samples, dictSize);
+            std::cout << "L: " << samples.size() << " samples  " << dictionary.size() << " bytes wK ("
+                << std::fixed << std::setprecision(1) << ElapsedNs(td) / 1e6 << " ms)\n";
+        }
+        if (!dictionary.empty()) {
+            opt.dict = &dictionary;
+            opt.dictMaxSize = dictMax;
+            // ̓A[JCu 1 ûŁAΏۂ̃t@CŜŎ̑傫ȏɏk܂ȂΎgȂ
+            // (LZ4Dict IԂ͂t@C LZ4 / kŊi[)
+            auto ts = std::chrono::steady_clock::now();
+            const uint64_t savings = MeasureDictSavings(inputDir, files, opt);
+            std::cout << "L: LZ4 ɔׂ " << savings << " bytes 팸 ( " << dictionary.size() << " bytes, "
+                << std::fixed << std::setprecision(1) << ElapsedNs(ts) / 1e6 << " ms)\n";
+            if (savings <= dictionary.size()) {
+                std::cout << "L: 팸̑傫ɖȂߎgp܂ (LZ4 Ŋi[)\n";
+                opt.dict = nullptr;
+                opt.baseDictShared = false;
+                dictionary.clear();
+            }
+        }
+    }
+
     PakHeader header{};
     memcpy(header.magic, "PIXPAK\0", 8);
-    header.version = 2;  // v2
+    header.version = 3;  // v3
     header.fileCount = (uint32_t)files.size();
     header.tocOffset = 0;
-    header.flags = 0;
+    header.flags = AssetFlag_StdSHA256 | (opt.patch ? AssetFlag_PatchData : 0);
     header.alignment = alignment;
     memset(header.reserved, 0, sizeof(header.reserved));
 
-    std::ofstream ofs(outputPak, std::ios::binary);
+    std::ofstream ofs(writePath, std::ios::binary);
     if (!ofs) {
-        std::cout << "o͂J܂: " << outputPak << "\n";
+        std::cout << "o͂J܂: " << writePath << "\n";
         return 1;
     }
 
     ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
     uint64_t currentOffset = sizeof(header);
+    // L̓wb_ɒu (}Eg 1 񂾂ǂ)
+    if (opt.dict) {
+        header.flags |= AssetFlag_Dictionary;
+        header.dictOffset = currentOffset;
+        header.dictSize = (uint32_t)dictionary.size();
+        header.dictCrc32 = HashUtil::CalcCRC32(dictionary.data(), dictionary.size());
+        ofs.write(reinterpret_cast<const char*>(dictionary.data()), dictionary.size());
+        currentOffset += dictionary.size();
+    }
 
-    size_t idx = 0;
-    for (auto& fe : files) {
-        uint64_t aligned = AlignValue(currentOffset, header.alignment);
-        if (aligned != currentOffset) {
-            size_t pad = (size_t)(aligned - currentOffset);
-            static const char padBuf[4096]{};
-            while (pad > 0) {
-                size_t chunk = std::min<size_t>(pad, sizeof(padBuf));
-                ofs.write(padBuf, chunk);
-                pad -= chunk;
+    uint64_t totalOriginal = 0;
+    uint64_t totalStored = 0;
+    size_t compressedCount = 0;
+    size_t dictCount = 0;
+    uint64_t dictOriginal = 0;
+    uint64_t dictStored = 0;
+    uint64_t paddingBytes = 0;
+    size_t groupedCount = 0;
+
+    // [J[ index 荇ĕɏA݂̓CXbh index ɍsB
+    // o͏ƃItZbg͏ݑŌ܂̂ŃXbhɊ֌WȂ̃oCgɂȂB
+    // ݂̌ʂ𗭂ߍ݂Ȃ悤Asł錏𐧌
+    const size_t window = (size_t)jobs * 4;
+    std::vector<ProcessedFile> results(files.size());
+    std::mutex mtx;
+    std::condition_variable cvReady;  // ʂ ( ݑ)
+    std::condition_variable cvWindow; // ݂i ( [J[)
+    std::atomic<size_t> nextIndex{ 0 };
+    size_t writtenCount = 0;
+    bool aborted = false;
+    StageStats stats;
+
+    auto worker = [&]() {
+        for (;;) {
+            size_t i = nextIndex.fetch_add(1);
+            if (i >= files.size()) return;
+            {
+                std::unique_lock<std::mutex> lk(mtx);
+                cvWindow.wait(lk, [&] { return aborted || i < writtenCount + window; });
+                if (aborted) return;
+            }
+            ProcessedFile pf;
+            ProcessFile(inputDir, files[i], pf, opt, stats);
+            {
+                std::lock_guard<std::mutex> lk(mtx);
+                results[i] = std::move(pf);
+                results[i].ready = true;
             }
-            currentOffset = aligned;
+            cvReady.notify_all();
         }
+    };
 
-        fs::path full = inputDir / fe.relativePath;
-        std::ifstream ifs(full, std::ios::binary | std::ios::ate);
-        if (!ifs) {
-            std::cout << "Ǎs: " << full << "\n";
-            return 1;
+    auto wallStart = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    jobs = (unsigned)std::min<size_t>(jobs, files.size());
+    for (unsigned t = 0; t < jobs; ++t) pool.emplace_back(worker);
+
+    uint64_t writeNs = 0;
+    uint64_t reusedBytes = 0;
+    // dr: SHA-256  ŏɏGg̓YBẽGg TOC œi[f[^w
+    HashUtil::StringMap<size_t> payloadBySha;
+    std::vector<size_t> payloadOwner(files.size());
+    for (size_t i = 0; i < files.size(); ++i) payloadOwner[i] = i;
+    size_t dedupCount = 0;
+    uint64_t dedupBytes = 0;
+    std::vector<bool> skipped(files.size(), false);
+    std::vector<char> copyBuf;
+    bool failed = false;
+    for (size_t idx = 0; idx < files.size(); ++idx) {
+        ProcessedFile pf;
+        {
+            std::unique_lock<std::mutex> lk(mtx);
+            cvReady.wait(lk, [&] { return results[idx].ready; });
+            pf = std::move(results[idx]);
         }
-        uint64_t sz = (uint64_t)ifs.tellg();
-        ifs.seekg(0, std::ios::beg);
-        std::vector<uint8_t> buf;
-        buf.resize((size_t)sz);
-        if (sz > 0) {
-            if (!ifs.read(reinterpret_cast<char*>(buf.data()), sz)) {
-                std::cout << "ǍG[: " << full << "\n";
-                return 1;
+        if (!pf.ok) {
+            std::cout << "\n" << pf.error << "\n";
+            failed = true;
+            break;
+        }
+        if (pf.skip) {
+            skipped[idx] = true;
+            {
+                std::lock_guard<std::mutex> lk(mtx);
+                writtenCount = idx + 1;
             }
+            cvWindow.notify_all();
+            continue;
         }
 
-        fe.originalSize = sz;
-        fe.storedSize = sz;
+        auto tw = std::chrono::steady_clock::now();
+        TempFileEntry& fe = files[idx];
+        if (dedup) {
+            auto ins = payloadBySha.emplace(std::string(fe.sha256.begin(), fe.sha256.end()), idx);
+            const TempFileEntry& owner = files[ins.first->second];
+            if (!ins.second && owner.originalSize == fe.originalSize) {
+                // i[`͐ɏɑ (k̗LĂWJ̓e͓)
+                fe.offset = owner.offset;
+                fe.storedSize = owner.storedSize;
+                fe.compression = owner.compression;
+                payloadOwner[idx] = ins.first->second;
+                ++dedupCount;
+                dedupBytes += fe.storedSize;
+                totalOriginal += fe.originalSize;
+                writeNs += ElapsedNs(tw);
+                {
+                    std::lock_guard<std::mutex> lk(mtx);
+                    writtenCount = idx + 1;
+                }
+                cvWindow.notify_all();
+                continue;
+            }
+        }
+        // t@C͍ alignment ubNɎ܂l߂ĒuB
+        // ZN^Pʂ̓ǂݍ݂ł 1 ubNǂ߂ΓubÑt@C܂Ƃ߂Ďɓ
+        uint64_t padTo = header.alignment;
+        if (fe.storedSize < groupSmall && header.alignment > kGroupedAlignment) {
+            uint64_t packed = AlignValue(currentOffset, kGroupedAlignment);
+            uint64_t blockStart = packed - packed % header.alignment;
+            if (packed + fe.storedSize <= blockStart + header.alignment) {
+                padTo = kGroupedAlignment;
+                ++groupedCount;
+            }
+        }
+        uint64_t before = currentOffset;
+        currentOffset = WritePadding(ofs, currentOffset, padTo);
+        paddingBytes += currentOffset - before;
         fe.offset = currentOffset;
-        fe.crc32 = HashUtil::CalcCRC32(buf.data(), buf.size());
-        auto h = HashUtil::SHA256(buf);
-        fe.sha256 = h;
+        if (pf.reuse) {
+            if (!CopyBlock(prevIn, pf.reuseOffset, fe.storedSize, ofs, copyBuf)) {
+                std::cout << "\nÕA[JCu̕ʂɎs: " << fe.relativePath << "\n";
+                failed = true;
+                break;
+            }
+            reusedBytes += fe.storedSize;
+        }
+        else if (fe.storedSize > 0) {
+            ofs.write(reinterpret_cast<const char*>(pf.payload.data()), fe.storedSize);
+        }
+        currentOffset += fe.storedSize;
+        totalOriginal += fe.originalSize;
+        totalStored += fe.storedSize;
+        if (fe.compression == (uint8_t)AssetCompression::LZ4) ++compressedCount;
+        if (fe.compression == (uint8_t)AssetCompression::LZ4Dict) {
+            ++dictCount;
+            dictOriginal += fe.originalSize;
+            dictStored += fe.storedSize;
+        }
+        writeNs += ElapsedNs(tw);
 
-        if (sz > 0) ofs.write(reinterpret_cast<const char*>(buf.data()), sz);
-        currentOffset += sz;
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            writtenCount = idx + 1;
+        }
+        cvWindow.notify_all();
 
-        ++idx;
-        if (idx % 10 == 0 || idx == files.size()) {
-            double prog = (double)idx / files.size() * 100.0;
+        if ((idx + 1) % 10 == 0 || idx + 1 == files.size()) {
+            double prog = (double)(idx + 1) / files.size() * 100.0;
             std::cout << "\rݒ... " << std::fixed << std::setprecision(1) << prog << "%";
         }
     }
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        aborted = failed;
+    }
+    cvWindow.notify_all();
+    for (auto& th : pool) th.join();
+    if (failed) return 1;
     std::cout << "\n";
 
+    if (!dedupReport.empty()) {
+        if (!WriteDedupReport(dedupReport, files, payloadOwner)) {
+            std::cout << "dr|[g߂܂: " << dedupReport.string() << "\n";
+            return 1;
+        }
+        std::cout << "dr|[g: " << dedupReport.string() << "\n";
+    }
+
+    // TOC v3 ̓}bv܂܍\̂Ƃēǂނ̂ 8 oCgEɒu
+    currentOffset = WritePadding(ofs, currentOffset, alignof(PakTocEntryV3));
     header.tocOffset = currentOffset;
 
-    // TOC  (v2)
-    for (auto& fe : files) {
-        uint16_t nameLen = (uint16_t)fe.relativePath.size();
-        ofs.write(reinterpret_cast<const char*>(&nameLen), sizeof(nameLen));
-        ofs.write(fe.relativePath.data(), nameLen);
-        ofs.write(reinterpret_cast<const char*>(&fe.compression), 1);
-        uint8_t reservedC[3]{};
-        ofs.write(reinterpret_cast<const char*>(reservedC), 3);
-        ofs.write(reinterpret_cast<const char*>(&fe.crc32), sizeof(fe.crc32));
-        ofs.write(reinterpret_cast<const char*>(&fe.originalSize), sizeof(fe.originalSize));
-        ofs.write(reinterpret_cast<const char*>(&fe.storedSize), sizeof(fe.storedSize));
-        ofs.write(reinterpret_cast<const char*>(&fe.offset), sizeof(fe.offset));
-        ofs.write(reinterpret_cast<const char*>(fe.sha256.data()), fe.sha256.size());
+    // TOC  (v3)
+    if (opt.patch) {
+        // x[XƓꂾGg TOC 珜
+        std::vector<TempFileEntry> changed;
+        for (size_t i = 0; i < files.size(); ++i)
+            if (!skipped[i]) changed.push_back(std::move(files[i]));
+        files = std::move(changed);
+        header.fileCount = (uint32_t)files.size();
+    }
+    std::string tocError;
+    if (!WritePakTOC(ofs, files, tocError)) {
+        std::cout << tocError << "\n";
+        return 1;
     }
 
     ofs.seekp(0, std::ios::beg);
     ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
-    ofs.flush();
+    ofs.close();
+    if (!ofs) {
+        std::cout << "݂Ɏs܂: " << writePath << "\n";
+        return 1;
+    }
+    // uOɌÂrh (rŎsĂÂJnVA[JCuɎgȂ)
+    std::error_code cacheEc;
+    fs::remove(PackCachePath(outputPak), cacheEc);
+    if (writePath != outputPak) {
+        prevIn.close();
+        std::error_code ec;
+        fs::rename(writePath, outputPak, ec);
+        if (ec) {
+            std::cout << "uɎs܂: " << outputPak << " (" << ec.message() << ")\n";
+            return 1;
+        }
+    }
+    // pb`͍rȟɂȂ̂ŏȂ
+    if (!opt.patch) {
+        PackCacheInfo cache;
+        cache.packStartTime = (uint64_t)packStart.time_since_epoch().count();
+        cache.archiveSize = fs::file_size(outputPak, cacheEc);
+        cache.tocOffset = header.tocOffset;
+        if (cacheEc || !WritePackCache(outputPak, cache))
+            std::cout << "rh߂܂: " << PackCachePath(outputPak).string() << "\n";
+    }
 
     std::cout << "pbN: " << outputPak << "\n";
     std::cout << "t@C: " << files.size() << "\n";
     std::cout << "TOC Offset: " << header.tocOffset << "\n";
+    std::cout << "LZ4 k: " << compressedCount << " files, "
+        << totalOriginal << " -> " << totalStored << " bytes";
+    if (totalOriginal > 0)
+        std::cout << " (" << std::fixed << std::setprecision(1) << (double)totalStored / totalOriginal * 100.0 << "%)";
+    std::cout << "\n";
+    if (opt.dict) {
+        std::cout << "LZ4Dict: " << dictCount << " files, " << dictOriginal << " -> " << dictStored << " bytes";
+        if (dictOriginal > 0)
+            std::cout << " (" << std::fixed << std::setprecision(1) << (double)dictStored / dictOriginal * 100.0 << "%)";
+        std::cout << ",  " << dictionary.size() << " bytes\n";
+    }
+    std::cout << "Alignment: " << header.alignment << " bytes, padding " << paddingBytes << " bytes";
+    if (groupSmall > 0) std::cout << ", grouped " << groupedCount << " small files (< " << groupSmall << " bytes)";
+    std::cout << "\n";
+    if (dedup) {
+        std::cout << "dr: " << dedupCount << " files ̊i[f[^L (" << dedupBytes << " bytes 팸)\n";
+    }
+
+    if (opt.patch) {
+        std::cout << "pb`: x[X " << patchBase << " ƈقȂ " << files.size() << " files o";
+        if (!removedFromBase.empty()) std::cout << " (͂ɖx[X̃Gg " << removedFromBase.size() << " ͍폜܂)";
+        std::cout << "\n";
+    }
+    else if (opt.base) {
+        std::cout << "rh: " << stats.reusedFiles << " / " << files.size() << " files ėp ("
+            << reusedBytes << " bytes ,  " << stats.reusedHashed << " files ̓nbVv)\n";
+    }
+
+    // Xe[WʃX[vbg (Ǎ / nbV / k̓[J[ 1 {AŜ͎)
+    uint64_t wallNs = ElapsedNs(wallStart);
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "X[vbg (jobs=" << jobs << "):\n";
+    std::cout << "  Ǎ    : " << ToMBps(stats.readBytes, stats.readNs) << " MB/s\n";
+    std::cout << "  nbV: " << ToMBps(stats.readBytes, stats.hashNs) << " MB/s ("
+        << HashUtil::GetCRC32ImplName() << " / " << HashUtil::GetSHA256ImplName() << ")\n";
+    std::cout << "  k    : " << ToMBps(stats.compressBytes, stats.compressNs) << " MB/s\n";
+    std::cout << "      : " << ToMBps(totalStored, writeNs) << " MB/s\n";
+    std::cout << "  S    : " << ToMBps(totalOriginal, wallNs) << " MB/s ("
+        << (double)wallNs / 1e6 << " ms)\n";
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,28 @@
+// [x̕` (ModelRenderComponent::DrawDepthOnly)BʒũXg[ǂށBPS ͎gȂ
+cbuffer ModelCB : register(b0)
+{
+    matrix gWorld;
+    matrix gView;
+    matrix gProj;
+    float4 gBaseColor;
+};
+
+// ʎqʒűtʎq (TubV)Bfloat ̈ʒu scale=1, bias=0
+cbuffer PackCB : register(b1)
+{
+    float4 gPosScale;
+    float4 gPosBias;
+};
+
+struct VS_INPUT
+{
+    float3 pos : POSITION;     // float3 ܂ unorm16x4
+};
+
+float4 main(VS_INPUT i) : SV_POSITION
+{
+    float3 pos = gPosBias.xyz + gPosScale.xyz * i.pos;
+    float4 wp = mul(float4(pos, 1), gWorld);
+    float4 vp = mul(wp, gView);
+    return mul(vp, gProj);
+}
@@ -0,0 +1,53 @@
+// l߂_ (VertexPack.h) pBo͂ VS_ModelStatic ƓȂ̂ PS ͂̂܂܎g
+cbuffer ModelCB : register(b0)
+{
+    matrix gWorld;
+    matrix gView;
+    matrix gProj;
+    float4 gBaseColor;
+};
+
+// ʎqʒűtʎq (TubV)Bfloat ̈ʒu scale=1, bias=0
+cbuffer PackCB : register(b1)
+{
+    float4 gPosScale;
+    float4 gPosBias;
+};
+
+struct VS_INPUT
+{
+    float3 pos : POSITION;     // float3 ܂ unorm16x4
+    float2 normal : NORMAL;    // ʑ̎ʑ snorm16x2
+    float4 tangent : TANGENT;  // ʑ̎ʑ snorm8x2 + ]@̌ (gp)
+    float2 uv : TEXCOORD;      // unorm16x2 ܂ half2
+};
+
+struct VS_OUTPUT
+{
+    float4 pos : SV_POSITION;
+    float3 normal : NORMAL;
+    float2 uv : TEXCOORD;
+    float3 worldPos : WORLDPOS;
+};
+
+// VertexPack.cpp  DecodeOct Ɠ
+float3 OctDecode(float2 e)
+{
+    float3 n = float3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+    float t = saturate(-n.z);
+    n.xy += (n.xy >= 0.0) ? -t : t;
+    return normalize(n);
+}
+
+VS_OUTPUT main(VS_INPUT i)
+{
+    VS_OUTPUT o;
+    float3 pos = gPosBias.xyz + gPosScale.xyz * i.pos;
+    float4 wp = mul(float4(pos, 1), gWorld);
+    o.worldPos = wp.xyz;
+    float4 vp = mul(wp, gView);
+    o.pos = mul(vp, gProj);
+    o.normal = mul(float4(OctDecode(i.normal), 0), gWorld).xyz;
+    o.uv = i.uv;
+    return o;
+}
@@ -1,5 +1,9 @@
 #include "AssetManager.h"
+#include "PakArchive.h"
+#include "PakMountStack.h"
+#include "PakScrubber.h"
 #include <fstream>
+#include <algorithm>
 #include <Windows.h>
 #include "IMGUI/imgui.h"
 #include "ErrorLog.h"
@@ -25,8 +29,10 @@ void AssetManager::DeleteInstance()
 
 void AssetManager::UnInit()
 {
+    StopIOThreads();
     StopAutoSync();
     ClearRawCache();
+    UnmountArchive();
     {
         std::lock_guard<std::mutex> lk(m_mtx_);
         m_recentChanges_.clear();
@@ -34,11 +40,87 @@ void AssetManager::UnInit()
 }
 
 AssetManager::~AssetManager() {
+    StopIOThreads();
     StopAutoSync();
+    if (m_scrubber_) m_scrubber_->Stop();
 }
 
 void AssetManager::SetRoot(const std::string& root) { m_root_ = root; }
-void AssetManager::SetLoadMode(LoadMode m) { m_mode_ = m; }
+
+void AssetManager::SetLoadMode(LoadMode m) {
+    if (m == LoadMode::FromArchive && !IsArchiveMounted()) {
+        if (!MountArchive()) {
+            ErrorLogger::Instance().LogError("AssetManager", "SetLoadMode(FromArchive) failed: archive not mounted.");
+            return;
+        }
+    }
+    m_mode_ = m;
+}
+
+void AssetManager::SetArchivePath(const std::string& archivePath) {
+    std::lock_guard<std::mutex> lk(m_mtx_);
+    m_archivePath_ = archivePath;
+}
+
+void AssetManager::AddPatchArchive(const std::string& patchPath) {
+    std::lock_guard<std::mutex> lk(m_mtx_);
+    m_patchPaths_.push_back(patchPath);
+}
+
+void AssetManager::ClearPatchArchives() {
+    std::lock_guard<std::mutex> lk(m_mtx_);
+    m_patchPaths_.clear();
+}
+
+void AssetManager::SetArchiveVerify(bool enable, uint64_t scrubBytesPerSec) {
+    std::lock_guard<std::mutex> lk(m_mtx_);
+    m_verify_ = enable;
+    m_scrubRate_ = scrubBytesPerSec;
+}
+
+bool AssetManager::MountArchive() {
+    std::lock_guard<std::mutex> lk(m_mtx_);
+    if (m_scrubber_) m_scrubber_->Stop();
+    if (m_archivePath_.empty()) {
+        ErrorLogger::Instance().LogError("AssetManager", "MountArchive failed: archive path not set.");
+        return false;
+    }
+    std::vector<std::shared_ptr<PakArchive>> archives;
+    auto base = std::make_shared<PakArchive>();
+    if (!base->Open(m_archivePath_)) return false;
+    archives.push_back(std::move(base));
+    for (auto& path : m_patchPaths_) {
+        auto patch = std::make_shared<PakArchive>();
+        if (!patch->Open(path)) return false;
+        archives.push_back(std::move(patch));
+    }
+    auto mounts = std::make_shared<PakMountStack>();
+    if (!mounts->Build(std::move(archives))) return false;
+    m_mounts_ = std::move(mounts);
+    m_prefetched_.clear();
+    m_prefetchedBytes_ = 0;
+
+    if (m_verify_) {
+        for (auto& archive : m_mounts_->GetMounts()) archive->SetVerify(true);
+        if (!m_scrubber_) m_scrubber_ = std::make_unique<PakScrubber>();
+        m_scrubber_->Start(m_mounts_, m_scrubRate_, [this] { return IsForegroundReading(); });
+    }
+    return true;
+}
+
+void AssetManager::UnmountArchive() {
+    m_mode_ = LoadMode::FromSource;
+    std::lock_guard<std::mutex> lk(m_mtx_);
+    if (m_scrubber_) m_scrubber_->Stop();
+    m_mounts_.reset();
+    m_prefetched_.clear();
+    m_prefetchedBytes_ = 0;
+}
+
+bool AssetManager::IsArchiveMounted() const {
+    std::lock_guard<std::mutex> lk(m_mtx_);
+    return m_mounts_ != nullptr;
+}
 
 std::string AssetManager::Normalize(const std::string& name) const {
     std::string s = name;
@@ -48,9 +130,13 @@ std::string AssetManager::Normalize(const std::string& name) const {
 
 bool AssetManager::Exists(const std::string& logicalName) {
     std::string norm = Normalize(logicalName);
+    if (m_mode_ == LoadMode::FromArchive) {
+        std::lock_guard<std::mutex> lk(m_mtx_);
+        return m_mounts_ && m_mounts_->Find(norm) != nullptr;
+    }
     {
         std::lock_guard<std::mutex> lk(m_mtx_);
-        if (m_cache_.find(norm) != m_cache_.end()) return true;
+        if (m_cache_.find(norm) != m_cache_.end() || m_warm_.Contains(norm)) return true;
     }
     std::filesystem::path p = std::filesystem::path(m_root_) / norm;
     return std::filesystem::exists(p);
@@ -58,45 +144,607 @@ bool AssetManager::Exists(const std::string& logicalName) {
 
 bool AssetManager::LoadAsset(const std::string& logicalName, std::vector<uint8_t>& outData) {
     std::string norm = Normalize(logicalName);
+    m_trace_.Record(norm);
+    if (m_mode_ == LoadMode::FromArchive) {
+        return LoadFromArchive(norm, outData);
+    }
+    auto buf = LoadSourceShared(norm);
+    if (!buf) return false;
+    outData = *buf;
+    m_copyBytes_.fetch_add(buf->size());
+    return true;
+}
+
+AssetView AssetManager::AcquireAsset(const std::string& logicalName) {
+    std::string norm = Normalize(logicalName);
+    m_trace_.Record(norm);
+    if (m_mode_ == LoadMode::FromArchive) {
+        return AcquireFromArchive(norm);
+    }
+    auto buf = LoadSourceShared(norm);
+    if (!buf) return {};
+    m_viewBytes_.fetch_add(buf->size());
+    return AssetView(buf, buf->data(), buf->size());
+}
+
+static int64_t SteadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// \[XtH_̓ǂݍ݁BLbVς݂Ȃobt@LĕԂ
+// hot ɖ warm ɂΓWJ hot ֖߂ (warm ̈kf[^͎c)
+std::shared_ptr<const std::vector<uint8_t>> AssetManager::LoadSourceShared(const std::string& norm) {
+    std::shared_ptr<const CompressedCache::Blob> warm;
+    uint64_t epoch = 0;
     {
         std::lock_guard<std::mutex> lk(m_mtx_);
         auto it = m_cache_.find(norm);
         if (it != m_cache_.end()) {
-            outData = it->second;
-            return true;
+            m_lru_.splice(m_lru_.begin(), m_lru_, it->second.lru);
+            ++m_cacheHits_;
+            return it->second.data;
         }
+        ++m_cacheMisses_;
+        warm = m_warm_.Find(norm);
+        epoch = m_cacheEpoch_;
+    }
+
+    if (warm) {
+        auto data = std::make_shared<std::vector<uint8_t>>();
+        int64_t t0 = SteadyNowNs();
+        if (CompressedCache::Decompress(*warm, *data)) {
+            int64_t t1 = SteadyNowNs();
+            {
+                std::lock_guard<std::mutex> lk(m_mtx_);
+                m_warm_.AddDecodeTime(data->size(), (uint64_t)(t1 - t0));
+                // WJɃt@CύXĂÂeȂ̂ hot ւ͓Ȃ
+                if (epoch == m_cacheEpoch_) InsertCacheLocked(norm, data);
+            }
+            FlushWarmPending();
+            return data;
+        }
+        ErrorLogger::Instance().LogError("AssetManager", "Failed to decompress warm cache entry: " + norm);
+        std::lock_guard<std::mutex> lk(m_mtx_);
+        m_warm_.Erase(norm);
     }
 
     std::filesystem::path p = std::filesystem::path(m_root_) / norm;
     std::ifstream ifs(p, std::ios::binary);
     if (!ifs) {
 		ErrorLogger::Instance().LogError("AssetManager", "Failed to open asset: " + norm);
-        return false;
+        return nullptr;
     }
     ifs.seekg(0, std::ios::end);
     size_t sz = (size_t)ifs.tellg();
     ifs.seekg(0, std::ios::beg);
-    outData.resize(sz);
-    ifs.read((char*)outData.data(), sz);
+    auto data = std::make_shared<std::vector<uint8_t>>(sz);
+    ifs.read((char*)data->data(), sz);
     if (!ifs) {
 		ErrorLogger::Instance().LogError("AssetManager", "Failed to read asset: " + norm);
-        return false;
+        return nullptr;
+    }
+    {
+        std::lock_guard<std::mutex> lk(m_mtx_);
+        InsertCacheLocked(norm, data);
+    }
+    FlushWarmPending();
+    return data;
+}
+
+// A[JCuǂݍ݂̎sƂ̒̓XNo[x܂
+class ForegroundReadScope {
+public:
+    ForegroundReadScope(std::atomic<int>& active, std::atomic<int64_t>& last) : m_active(active), m_last(last) { ++m_active; }
+    ~ForegroundReadScope() {
+        m_last.store(SteadyNowNs());
+        --m_active;
     }
+private:
+    std::atomic<int>& m_active;
+    std::atomic<int64_t>& m_last;
+};
+
+bool AssetManager::IsForegroundReading() const {
+    const int64_t kQuietNs = 250ll * 1000 * 1000;
+    return m_archiveReads_.load() > 0 || SteadyNowNs() - m_lastArchiveRead_.load() < kQuietNs;
+}
+
+AssetView AssetManager::FindPrefetched(const std::string& norm) {
+    std::lock_guard<std::mutex> lk(m_mtx_);
+    if (m_prefetched_.empty()) return {};
+    auto it = m_prefetched_.find(norm);
+    if (it == m_prefetched_.end()) return {};
+    m_prefetchHits_.fetch_add(1);
+    return it->second;
+}
+
+// A[JCu Mount ɊJnh璼ړǂނ̂ m_cache_ ɂ͍ڂȂ
+bool AssetManager::LoadFromArchive(const std::string& norm, std::vector<uint8_t>& outData) {
+    if (AssetView pre = FindPrefetched(norm)) {
+        outData.assign(pre.data(), pre.data() + pre.size());
+        m_copyBytes_.fetch_add(pre.size());
+        return true;
+    }
+    ForegroundReadScope scope(m_archiveReads_, m_lastArchiveRead_);
+    std::shared_ptr<const PakMountStack> mounts;
     {
         std::lock_guard<std::mutex> lk(m_mtx_);
-        m_cache_[norm] = outData;
+        mounts = m_mounts_;
+    }
+    if (!mounts) {
+        ErrorLogger::Instance().LogError("AssetManager", "Archive not mounted: " + norm);
+        return false;
+    }
+    std::shared_ptr<PakArchive> archive;
+    const PakArchive::Entry* entry = mounts->Find(norm, &archive);
+    if (!entry) {
+        ErrorLogger::Instance().LogError("AssetManager", "Asset not found in archive: " + norm);
+        return false;
     }
+    if (!archive->Read(*entry, outData)) return false;
+    m_copyBytes_.fetch_add(outData.size());
     return true;
 }
 
+// }bvς݂ȂA[JCũy[W𒼐ڎwr[ԂB
+// }bvłĂȂꍇ̂݃q[vɓǂݍł̃obt@ owner ɂ
+AssetView AssetManager::AcquireFromArchive(const std::string& norm) {
+    if (AssetView pre = FindPrefetched(norm)) {
+        m_viewBytes_.fetch_add(pre.size());
+        return pre;
+    }
+    ForegroundReadScope scope(m_archiveReads_, m_lastArchiveRead_);
+    std::shared_ptr<const PakMountStack> mounts;
+    {
+        std::lock_guard<std::mutex> lk(m_mtx_);
+        mounts = m_mounts_;
+    }
+    if (!mounts) {
+        ErrorLogger::Instance().LogError("AssetManager", "Archive not mounted: " + norm);
+        return {};
+    }
+    std::shared_ptr<PakArchive> archive;
+    const PakArchive::Entry* entry = mounts->Find(norm, &archive);
+    if (!entry) {
+        ErrorLogger::Instance().LogError("AssetManager", "Asset not found in archive: " + norm);
+        return {};
+    }
+    // 傫kGg̓y[WLbVʂy[WẼobt@֒ړǂ
+    if (archive->CanReadDirect(*entry)) {
+        std::shared_ptr<const void> owner;
+        const uint8_t* data = nullptr;
+        if (archive->ReadDirect(*entry, owner, data)) {
+            m_directBytes_.fetch_add(entry->originalSize);
+            return AssetView(std::move(owner), data, (size_t)entry->originalSize);
+        }
+    }
+    if (const uint8_t* mapped = archive->GetMappedData(*entry)) {
+        m_viewBytes_.fetch_add(entry->originalSize);
+        return AssetView(archive, mapped, (size_t)entry->originalSize);
+    }
+    auto buf = std::make_shared<std::vector<uint8_t>>();
+    if (!archive->Read(*entry, *buf)) return {};
+    m_copyBytes_.fetch_add(buf->size());
+    return AssetView(buf, buf->data(), buf->size());
+}
+
+// ǂ݂ 1 ̓ǂݍ݂ɂ܂Ƃ߂͈́BԂ̖gp̈悪 kPrefetchGap ȉȂ
+// ǂݎ̂ĂV[NB1 ͈͂ kPrefetchMaxRange ܂łɂ I/O Xbh֕U
+static constexpr uint64_t kPrefetchGap = 256 * 1024;
+static constexpr uint64_t kPrefetchMaxRange = 16ull * 1024 * 1024;
+
+AssetManager::PrefetchResult AssetManager::PrefetchAssets(const std::vector<std::string>& names) {
+    PrefetchResult result;
+    std::vector<std::string> norms;
+    HashUtil::StringMap<bool> seen;
+    for (const auto& n : names) {
+        std::string norm = Normalize(n);
+        if (!norm.empty() && seen.emplace(norm, true).second) norms.push_back(std::move(norm));
+    }
+    if (norms.empty()) return result;
+
+    std::vector<std::function<void()>> tasks;
+    if (m_mode_ != LoadMode::FromArchive) {
+        // \[XtH_̓t@CɕʂȂ̂ŕɓǂނ
+        for (auto& norm : norms) {
+            std::error_code ec;
+            if (!std::filesystem::exists(std::filesystem::path(m_root_) / norm, ec)) continue;
+            tasks.push_back([this, norm] { LoadSourceShared(norm); });
+        }
+        result.assets = result.reads = tasks.size();
+        RunAndWait(std::move(tasks));
+        return result;
+    }
+
+    std::shared_ptr<const PakMountStack> mounts;
+    {
+        std::lock_guard<std::mutex> lk(m_mtx_);
+        mounts = m_mounts_;
+    }
+    if (!mounts) return result;
+
+    struct Item {
+        std::shared_ptr<PakArchive> archive;
+        const PakArchive::Entry* entry = nullptr;
+        std::string norm;
+    };
+    std::vector<Item> items;
+    for (auto& norm : norms) {
+        {
+            std::lock_guard<std::mutex> lk(m_mtx_);
+            if (m_prefetched_.find(norm) != m_prefetched_.end()) continue;
+        }
+        Item item;
+        item.entry = mounts->Find(norm, &item.archive);
+        if (!item.entry) continue; // Ȃ͖̂{̓ǂݍ݂ŃG[ɂ
+        // 傫kGg͌X 1 ̔obt@Oǂݍ݂ɂȂ̂Őǂ݂Ȃ
+        if (item.entry->compression == (uint8_t)AssetCompression::None && item.archive->CanReadDirect(*item.entry)) continue;
+        item.norm = std::move(norm);
+        items.push_back(std::move(item));
+    }
+    // A[JCu̕тŗא (kPrefetchGap ȓ) Gg 1 ͈̔͂ɂ܂Ƃ߂
+    std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) {
+        if (a.archive != b.archive) return a.archive < b.archive;
+        return a.entry->offset < b.entry->offset;
+    });
+    struct Range {
+        std::shared_ptr<PakArchive> archive;
+        uint64_t begin = 0;
+        uint64_t end = 0;
+        std::vector<Item> items;
+    };
+    std::vector<Range> ranges;
+    for (auto& item : items) {
+        const uint64_t begin = item.entry->offset;
+        const uint64_t end = begin + item.entry->storedSize;
+        if (ranges.empty() || ranges.back().archive != item.archive || begin > ranges.back().end + kPrefetchGap ||
+            end - ranges.back().begin > kPrefetchMaxRange) {
+            ranges.push_back(Range{ item.archive, begin, end });
+        }
+        Range& r = ranges.back();
+        r.end = std::max(r.end, end);
+        r.items.push_back(std::move(item));
+    }
+
+    result.assets = items.size();
+    result.reads = ranges.size();
+    for (auto& r : ranges) {
+        result.bytes += r.end - r.begin;
+        tasks.push_back([this, mounts, r = std::move(r)] {
+            ForegroundReadScope scope(m_archiveReads_, m_lastArchiveRead_);
+            // ͈̓obt@ I/O XbhɎg񂵁AGg͓WJ / Rs[ČʂɎ
+            thread_local std::vector<uint8_t> scratch;
+            const uint8_t* base = nullptr;
+            if (!r.archive->ReadRange(r.begin, r.end - r.begin, scratch, base)) return;
+            const PakArchive::Entry* prev = nullptr;
+            AssetView prevView;
+            for (const auto& item : r.items) {
+                const PakArchive::Entry& e = *item.entry;
+                // }bvς݂̖kGg̓y[WڂΏ\ (AcquireAsset ̓}bṽr[Ԃ)
+                if (e.compression == (uint8_t)AssetCompression::None && r.archive->IsMapped()) continue;
+                // i[f[^LGg (ItZbgŗׂɕ)  1 ̓WJʂL
+                const bool shared = prev && prevView && prev->offset == e.offset && prev->storedSize == e.storedSize;
+                AssetView view = shared ? prevView : AssetView{};
+                if (!shared) {
+                    auto data = std::make_shared<std::vector<uint8_t>>();
+                    if (!r.archive->Decode(e, base + (e.offset - r.begin), *data)) continue;
+                    view = AssetView(data, data->data(), data->size());
+                }
+                prev = &e;
+                prevView = view;
+                std::lock_guard<std::mutex> lk(m_mtx_);
+                if (m_mounts_ != mounts) return; // ǂݒɃ}Egς
+                if (!shared) m_prefetchedBytes_ += view.size();
+                m_prefetched_[item.norm] = std::move(view);
+            }
+        });
+    }
+    RunAndWait(std::move(tasks));
+    return result;
+}
+
+void AssetManager::ClearPrefetched() {
+    std::lock_guard<std::mutex> lk(m_mtx_);
+    m_prefetched_.clear();
+    m_prefetchedBytes_ = 0;
+}
+
+// tasks  I/O XbhŎsASďI܂ő҂
+void AssetManager::RunAndWait(std::vector<std::function<void()>> tasks) {
+    if (tasks.empty()) return;
+    struct Batch {
+        std::mutex mtx;
+        std::condition_variable cv;
+        size_t left = 0;
+    };
+    auto batch = std::make_shared<Batch>();
+    batch->left = tasks.size();
+    auto finish = [batch] {
+        std::lock_guard<std::mutex> blk(batch->mtx);
+        if (--batch->left == 0) batch->cv.notify_all();
+    };
+    {
+        std::lock_guard<std::mutex> lk(m_ioMtx_);
+        StartIOThreadsLocked();
+        for (auto& t : tasks) {
+            auto job = std::make_shared<AsyncJob>();
+            job->priority = AssetPriority::High;
+            job->task = [t = std::move(t), finish] {
+                t();
+                finish();
+            };
+            // StopIOThreads ŎsꂸɎ̂ĂĂ҂I悤ɂ
+            job->cancel = finish;
+            m_ioQueues_[(size_t)AssetPriority::High].push_back(std::move(job));
+            ++m_ioQueued_;
+        }
+    }
+    m_ioCv_.notify_all();
+    std::unique_lock<std::mutex> lk(batch->mtx);
+    batch->cv.wait(lk, [&] { return batch->left == 0; });
+}
+
 void AssetManager::ClearRawCache() {
     std::lock_guard<std::mutex> lk(m_mtx_);
-    m_cache_.clear();
+    ClearCacheLocked();
     m_fileMeta_.clear();
 }
 
+void AssetManager::SetCacheBudget(size_t bytes) {
+    {
+        std::lock_guard<std::mutex> lk(m_mtx_);
+        m_cacheBudget_ = bytes;
+        EvictLocked();
+    }
+    FlushWarmPending();
+}
+
+size_t AssetManager::GetCacheBudget() const {
+    std::lock_guard<std::mutex> lk(m_mtx_);
+    return m_cacheBudget_;
+}
+
+void AssetManager::SetWarmCacheBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lk(m_mtx_);
+    m_warm_.SetBudget(bytes);
+    if (bytes == 0) m_warmPending_.clear();
+}
+
+size_t AssetManager::GetWarmCacheBudget() const {
+    std::lock_guard<std::mutex> lk(m_mtx_);
+    return m_warm_.GetBudget();
+}
+
+// ǂo҂̃f[^k warm ֓ (m_mtx_ ێɌĂ)
+void AssetManager::FlushWarmPending() {
+    std::vector<std::pair<std::string, std::shared_ptr<const std::vector<uint8_t>>>> pending;
+    uint64_t epoch = 0;
+    {
+        std::lock_guard<std::mutex> lk(m_mtx_);
+        if (m_warmPending_.empty()) return;
+        pending.swap(m_warmPending_);
+        epoch = m_cacheEpoch_;
+    }
+    std::vector<std::shared_ptr<const CompressedCache::Blob>> blobs;
+    blobs.reserve(pending.size());
+    for (auto& p : pending) blobs.push_back(CompressedCache::Compress(*p.second));
+
+    std::lock_guard<std::mutex> lk(m_mtx_);
+    // kɃt@CύXꂽꍇ͂ǂꂪÂȂ̂őŜĂ (̗vœǂݒ)
+    if (epoch != m_cacheEpoch_) return;
+    for (size_t i = 0; i < pending.size(); ++i) {
+        // kɍēxǂݍ܂ hot ɂ̂ warm ֓ėǂ (e͓)
+        m_warm_.Put(pending[i].first, std::move(blobs[i]));
+    }
+}
+
+// ȉ m_mtx_ ێԂŌĂԂ
+void AssetManager::InsertCacheLocked(const std::string& norm, std::shared_ptr<const std::vector<uint8_t>> data) {
+    EraseCacheLocked(norm);
+    m_lru_.push_front(norm);
+    m_cacheBytes_ += data->size();
+    m_cache_[norm] = CacheEntry{ std::move(data), m_lru_.begin() };
+    EvictLocked();
+}
+
+void AssetManager::EraseCacheLocked(const std::string& norm) {
+    auto it = m_cache_.find(norm);
+    if (it == m_cache_.end()) return;
+    m_cacheBytes_ -= it->second.data->size();
+    m_lru_.erase(it->second.lru);
+    m_cache_.erase(it);
+}
+
+// t@C̕ύX / 폜Bhot / warm / k҂̂ǂꂩ̂Ă
+void AssetManager::InvalidateCacheLocked(const std::string& norm) {
+    EraseCacheLocked(norm);
+    m_warm_.Erase(norm);
+    std::erase_if(m_warmPending_, [&](const auto& p) { return p.first == norm; });
+    ++m_cacheEpoch_;
+}
+
+void AssetManager::ClearCacheLocked() {
+    m_cache_.clear();
+    m_lru_.clear();
+    m_cacheBytes_ = 0;
+    m_warm_.Clear();
+    m_warmPending_.clear();
+    ++m_cacheEpoch_;
+}
+
+void AssetManager::EvictLocked() {
+    if (m_cacheBudget_ == 0) return;
+    // Â猩ĂAgp (LbVȊOɂQƂ) ͔̂̂΂
+    auto it = m_lru_.end();
+    while (m_cacheBytes_ > m_cacheBudget_ && it != m_lru_.begin()) {
+        --it;
+        auto ct = m_cache_.find(*it);
+        if (ct->second.data.use_count() > 1) continue;
+        m_cacheBytes_ -= ct->second.data->size();
+        // warm ɓecĂΈkKv͖
+        if (m_warm_.GetBudget() > 0 && !m_warm_.Contains(*it)) {
+            m_warmPending_.emplace_back(*it, std::move(ct->second.data));
+        }
+        m_cache_.erase(ct);
+        it = m_lru_.erase(it);
+        ++m_cacheEvictions_;
+    }
+}
+
+void AssetManager::SetIOThreadCount(unsigned count) {
+    std::lock_guard<std::mutex> lk(m_ioMtx_);
+    m_ioThreadCount_ = count;
+}
+
+AssetRequestId AssetManager::RequestAsync(const std::string& logicalName, AssetPriority priority, AssetCallback callback) {
+    std::string norm = Normalize(logicalName);
+    m_trace_.Record(norm);
+    if (priority >= AssetPriority::Count) priority = AssetPriority::Low;
+
+    std::lock_guard<std::mutex> lk(m_ioMtx_);
+    StartIOThreadsLocked();
+    AssetRequestId id = m_nextRequestId_++;
+    m_ioRequested_.fetch_add(1);
+
+    auto& job = m_ioJobs_[norm];
+    if (job) {
+        // AZbgҋ@ / ǂݍݒȂ瑊肷
+        m_ioCoalesced_.fetch_add(1);
+        if (!job->started && priority < job->priority) {
+            job->priority = priority;
+            m_ioQueues_[(size_t)priority].push_back(job);
+        }
+    }
+    else {
+        job = std::make_shared<AsyncJob>();
+        job->norm = norm;
+        job->priority = priority;
+        m_ioQueues_[(size_t)priority].push_back(job);
+        ++m_ioQueued_;
+        m_ioCv_.notify_one();
+    }
+    job->waiters.push_back(AsyncWaiter{ id, std::move(callback) });
+    m_ioRequests_[id] = job;
+    return id;
+}
+
+bool AssetManager::CancelAsync(AssetRequestId id) {
+    std::lock_guard<std::mutex> lk(m_ioMtx_);
+    auto it = m_ioRequests_.find(id);
+    if (it == m_ioRequests_.end()) return false;
+    std::shared_ptr<AsyncJob> job = it->second;
+    m_ioRequests_.erase(it);
+
+    auto& w = job->waiters;
+    w.erase(std::remove_if(w.begin(), w.end(), [id](const AsyncWaiter& x) { return x.id == id; }), w.end());
+    m_ioCancelled_.fetch_add(1);
+
+    // N҂ĂȂ̃Wû͎Ă (ǂݍݒ̂̂͊܂ő点)
+    if (w.empty() && !job->started) {
+        job->dropped = true;
+        --m_ioQueued_;
+        auto jt = m_ioJobs_.find(job->norm);
+        if (jt != m_ioJobs_.end() && jt->second == job) m_ioJobs_.erase(jt);
+    }
+    return true;
+}
+
+// m_ioMtx_ ێԂŌĂԂ
+void AssetManager::StartIOThreadsLocked() {
+    if (!m_ioThreads_.empty()) return;
+    unsigned n = m_ioThreadCount_;
+    if (n == 0) n = std::clamp(std::thread::hardware_concurrency() / 2, 2u, 4u);
+    for (unsigned i = 0; i < n; ++i) m_ioThreads_.emplace_back(&AssetManager::IOLoop, this, m_ioGeneration_);
+}
+
+// ̗v͔j (R[obN͌Ă΂Ȃ)BRunAndWait ̖^XN͎sɑ҂I点B
+// R[obNĂ΂Ȃ
+void AssetManager::StopIOThreads() {
+    std::vector<std::thread> threads;
+    std::vector<std::function<void()>> cancels;
+    {
+        std::lock_guard<std::mutex> lk(m_ioMtx_);
+        ++m_ioGeneration_;
+        threads.swap(m_ioThreads_);
+        for (auto& q : m_ioQueues_) {
+            for (auto& job : q) {
+                if (job->started || job->dropped || !job->cancel) continue;
+                job->dropped = true;
+                cancels.push_back(std::move(job->cancel));
+            }
+            q.clear();
+        }
+        m_ioJobs_.clear();
+        m_ioRequests_.clear();
+        m_ioQueued_ = 0;
+    }
+    m_ioCv_.notify_all();
+    for (auto& t : threads) t.join();
+    // ̂܂܎̂Ă^XN҂Ă RunAndWait N
+    for (auto& cancel : cancels) cancel();
+}
+
+// m_ioMtx_ ێԂŌĂԂƁBDx̍L[疢̃Wuo
+std::shared_ptr<AssetManager::AsyncJob> AssetManager::PopJobLocked() {
+    for (auto& q : m_ioQueues_) {
+        while (!q.empty()) {
+            std::shared_ptr<AsyncJob> job = std::move(q.front());
+            q.pop_front();
+            // DxグۂɎcÂ / ς݂͓ǂݔ΂
+            if (job->started || job->dropped) continue;
+            job->started = true;
+            --m_ioQueued_;
+            ++m_ioRunning_;
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+void AssetManager::IOLoop(uint64_t generation) {
+    for (;;) {
+        std::shared_ptr<AsyncJob> job;
+        {
+            std::unique_lock<std::mutex> lk(m_ioMtx_);
+            m_ioCv_.wait(lk, [&] { return m_ioGeneration_ != generation || m_ioQueued_ > 0; });
+            if (m_ioGeneration_ != generation) return;
+            job = PopJobLocked();
+            if (!job) continue;
+        }
+        if (job->task) {
+            job->task();
+            std::lock_guard<std::mutex> lk(m_ioMtx_);
+            --m_ioRunning_;
+            continue;
+        }
+
+        AssetView view = AcquireAsset(job->norm);
+
+        // ɗv͐VWuɂȂ悤AR[obNOɓo^O
+        std::vector<AsyncWaiter> waiters;
+        {
+            std::lock_guard<std::mutex> lk(m_ioMtx_);
+            auto jt = m_ioJobs_.find(job->norm);
+            if (jt != m_ioJobs_.end() && jt->second == job) m_ioJobs_.erase(jt);
+            waiters.swap(job->waiters);
+            for (auto& w : waiters) m_ioRequests_.erase(w.id);
+            --m_ioRunning_;
+        }
+        for (auto& w : waiters) {
+            if (w.callback) w.callback(job->norm, view);
+            m_ioCompleted_.fetch_add(1);
+        }
+    }
+}
+
 void AssetManager::PushChange(ChangeType type, const std::string& path) {
     std::lock_guard<std::mutex> lk(m_mtx_);
+    PushChangeLocked(type, path);
+}
+
+// m_mtx_ ێԂŌĂԂ
+void AssetManager::PushChangeLocked(ChangeType type, const std::string& path) {
     if (m_recentChanges_.size() >= kMaxRecentChanges_)
         m_recentChanges_.pop_front();
     m_recentChanges_.push_back({ type, path, m_scanCount_.load() });
@@ -118,26 +766,140 @@ void AssetManager::StartAutoSync(std::chrono::milliseconds interval, bool recurs
 void AssetManager::StopAutoSync() {
     if (!m_watchRunning_.load()) return;
     m_watchRunning_ = false;
+    {
+        std::lock_guard<std::mutex> lk(m_mtx_);
+        if (m_watchBackend_) m_watchBackend_->Wake();
+    }
     if (m_watchThread_.joinable()) m_watchThread_.join();
     OutputDebugStringA("[AssetManager] AutoSync stopped.\n");
 }
 
+// ύXʒmg΂҂AgȂ / rŎsꍇ̓|[Oɐ؂ւ
 void AssetManager::WatchLoop() {
-    PerformScan(); 
+    std::unique_ptr<IFileWatchBackend> backend;
+    if (m_useNativeWatch_) {
+        backend = CreateNativeFileWatchBackend();
+        if (!backend->Start(m_root_, m_recursive_)) {
+            OutputDebugStringA("[AssetManager] Change notification unavailable, falling back to polling.\n");
+            backend.reset();
+        }
+    }
+    IFileWatchBackend* native = backend.get();
+    {
+        std::lock_guard<std::mutex> lk(m_mtx_);
+        m_watchBackend_ = std::move(backend);
+        m_watchBackendName_ = native ? native->GetName() : "Polling";
+    }
+
+    // ʒm󂯎n߂Ă珉񑖍̂ŁA̕ύX肱ڂȂ
+    RunTimedScan();
+
+    std::vector<std::string> changed;
     while (m_watchRunning_.load()) {
-        auto t0 = std::chrono::steady_clock::now();
-        PerformScan();
-        auto t1 = std::chrono::steady_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
-        m_lastScanDurationMs_.store((uint64_t)elapsed);
-        std::this_thread::sleep_for(m_interval_);
+        if (!native) {
+            std::this_thread::sleep_for(m_interval_);
+            if (m_watchRunning_.load()) RunTimedScan();
+            continue;
+        }
+        changed.clear();
+        bool needRescan = false;
+        if (!native->Wait(m_interval_, changed, needRescan)) {
+            OutputDebugStringA("[AssetManager] Change notification failed, falling back to polling.\n");
+            std::lock_guard<std::mutex> lk(m_mtx_);
+            m_watchBackend_.reset();
+            m_watchBackendName_ = "Polling";
+            native = nullptr;
+            continue;
+        }
+        m_watchEvents_.fetch_add(changed.size());
+        if (needRescan) RunTimedScan();
+        else if (!changed.empty()) ApplyWatchChanges(changed);
     }
+
+    std::lock_guard<std::mutex> lk(m_mtx_);
+    m_watchBackend_.reset();
+}
+
+void AssetManager::RunTimedScan() {
+    auto t0 = std::chrono::steady_clock::now();
+    PerformScan();
+    auto t1 = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+    m_lastScanDurationMs_.store((uint64_t)elapsed);
+}
+
+// ʒmꂽpX𒲂ׂă^ƃLbVXV (ǂݍ݂͎ɗvꂽ)
+void AssetManager::ApplyWatchChanges(const std::vector<std::string>& changed) {
+    using namespace std::filesystem;
+    const path rootPath(m_root_);
+    std::unordered_set<std::string> seen;
+    bool needRescan = false;
+    uint64_t adds = 0, mods = 0, removes = 0;
+
+    std::unique_lock<std::mutex> lk(m_mtx_);
+    for (auto& raw : changed) {
+        std::string rel = Normalize(raw);
+        if (!seen.insert(rel).second) continue;
+        if (!m_recursive_ && rel.find('/') != std::string::npos) continue;
+
+        std::error_code ec;
+        path full = rootPath / rel;
+        file_status st = status(full, ec);
+        if (is_directory(st)) {
+            // tH_̒ǉ / OύX͒̃t@CʂɒʒmȂ̂őŜ𑖍
+            needRescan = true;
+            break;
+        }
+        if (is_regular_file(st)) {
+            FileMeta meta;
+            meta.size = (uint64_t)file_size(full, ec);
+            meta.writeTime = last_write_time(full, ec);
+            auto it = m_fileMeta_.find(rel);
+            if (it == m_fileMeta_.end()) {
+                m_fileMeta_[rel] = meta;
+                PushChangeLocked(ChangeType::Added, rel);
+                ++adds;
+            }
+            else if (it->second.size != meta.size || it->second.writeTime != meta.writeTime) {
+                it->second = meta;
+                InvalidateCacheLocked(rel); // Qƒ̃r[͋obt@ێ
+                PushChangeLocked(ChangeType::Modified, rel);
+                ++mods;
+            }
+            continue;
+        }
+        if (m_fileMeta_.erase(rel)) {
+            InvalidateCacheLocked(rel);
+            PushChangeLocked(ChangeType::Removed, rel);
+            ++removes;
+            continue;
+        }
+        // m̃t@CłȂ΍폜 / OύXꂽtH_̉\
+        const std::string prefix = rel + "/";
+        for (auto& kv : m_fileMeta_) {
+            if (kv.first.compare(0, prefix.size(), prefix) == 0) { needRescan = true; break; }
+        }
+        if (needRescan) break;
+    }
+    lk.unlock();
+
+    if (needRescan) {
+        RunTimedScan();
+        return;
+    }
+    m_lastDiffAdds_.store(adds);
+    m_lastDiffMods_.store(mods);
+    m_lastDiffRemoves_.store(removes);
+    m_scanCount_.fetch_add(1);
 }
 
 void AssetManager::PerformScan() {
     using namespace std::filesystem;
 
-    std::unordered_map<std::string, FileMeta> current;
+    // A[JCu^p̓\[XtH_ĎȂ
+    if (m_mode_ == LoadMode::FromArchive) return;
+
+    HashUtil::StringMap<FileMeta> current;
     std::vector<std::string> additions;
     std::vector<std::string> modifications;
     std::vector<std::string> deletions;
@@ -201,32 +963,21 @@ void AssetManager::PerformScan() {
         }
     }
 
-    // ǉ/ύXt@C̃[hibNOԂ IOj
-    for (auto& add : additions) {
-        std::vector<uint8_t> dummy;
-        if (LoadAsset(add, dummy)) {
-            PushChange(ChangeType::Added, add);
-        }
-        else {
-            PushChange(ChangeType::ReloadFailed, add);
-        }
-    }
-    for (auto& mod : modifications) {
-        std::vector<uint8_t> dummy;
-        if (LoadAsset(mod, dummy)) {
-            PushChange(ChangeType::Modified, mod);
-        }
-        else {
-            PushChange(ChangeType::ReloadFailed, mod);
-        }
-    }
-    // 폜Kp
+    // ǉ / ύX͋L^邾œǂݍ܂Ȃ (ɗvꂽɓǂ)
     {
         std::lock_guard<std::mutex> lk(m_mtx_);
+        for (auto& add : additions) {
+            PushChangeLocked(ChangeType::Added, add);
+        }
+        for (auto& mod : modifications) {
+            // ÂêĂ (Qƒ̃r[͋obt@ێ)
+            InvalidateCacheLocked(mod);
+            PushChangeLocked(ChangeType::Modified, mod);
+        }
         for (auto& del : deletions) {
-            m_cache_.erase(del);
+            InvalidateCacheLocked(del);
             m_fileMeta_.erase(del);
-            PushChange(ChangeType::Removed, del);
+            PushChangeLocked(ChangeType::Removed, del);
         }
         // t@C^XV
         for (auto& kv : current) {
@@ -240,27 +991,136 @@ void AssetManager::PerformScan() {
     m_scanCount_.fetch_add(1);
 }
 
+void AssetManager::StartLoadTrace() {
+    m_trace_.Start();
+    OutputDebugStringA("[AssetManager] Load trace started.\n");
+}
+
+void AssetManager::MarkLoadTraceScene(const std::string& sceneName) {
+    m_trace_.MarkScene(sceneName);
+}
+
+bool AssetManager::StopLoadTrace(const std::string& outPath) {
+    size_t n = m_trace_.GetRecordCount();
+    if (!m_trace_.StopAndSave(outPath)) return false;
+    char dbg[512];
+    sprintf_s(dbg, "[AssetManager] Load trace saved: %s (%zu assets)\n", outPath.c_str(), n);
+    OutputDebugStringA(dbg);
+    return true;
+}
+
 void AssetManager::DrawDebugGUI()
 {
-    std::lock_guard<std::mutex> lk(m_mtx_);
+    std::unique_lock<std::mutex> lk(m_mtx_);
     ImGui::TextUnformatted("AssetManager");
     ImGui::Separator();
     ImGui::Text("Root: %s", m_root_.c_str());
     ImGui::Text("Mode: %s", (m_mode_ == LoadMode::FromSource) ? "FromSource" : "FromArchive");
-    ImGui::Text("Cached Raw Files: %zu", m_cache_.size());
-    ImGui::Text("AutoSync: %s", m_watchRunning_.load() ? "Running" : "Stopped");
+    if (m_mounts_) {
+        const auto& mounts = m_mounts_->GetMounts();
+        ImGui::Text("Archive: %zu mounts", mounts.size());
+        for (size_t i = 0; i < mounts.size(); ++i) {
+            const PakHeader& h = mounts[i]->GetHeader();
+            ImGui::Text("  [%s] %s (v%u, files=%u, align=%u, shared=%zu, dict=%u)", i == 0 ? "base" : "patch",
+                mounts[i]->GetPath().c_str(), h.version, h.fileCount, h.alignment, mounts[i]->GetSharedPayloadCount(),
+                h.dictSize);
+        }
+        if (m_scrubber_) {
+            PakScrubber::Stats st = m_scrubber_->GetStats();
+            ImGui::Text("Verify: %zu / %zu entries, %.2f MB, corrupt=%zu (%s)", st.checked, st.total,
+                st.bytes / (1024.0 * 1024.0), st.corrupt, st.running ? "scrubbing" : "idle");
+            int rateMB = (int)(m_scrubber_->GetBandwidth() / (1024 * 1024));
+            if (ImGui::InputInt("Scrub Bandwidth (MB/s, 0=unlimited)", &rateMB) && rateMB >= 0) {
+                m_scrubRate_ = (uint64_t)rateMB * 1024 * 1024;
+                m_scrubber_->SetBandwidth(m_scrubRate_);
+            }
+        }
+    }
+    else {
+        ImGui::Text("Archive: (not mounted) %s (+%zu patches)", m_archivePath_.c_str(), m_patchPaths_.size());
+    }
+    ImGui::Text("Cached Raw Files: %zu (%.2f / %.2f MB)", m_cache_.size(),
+        m_cacheBytes_ / (1024.0 * 1024.0), m_cacheBudget_ / (1024.0 * 1024.0));
+    {
+        uint64_t lookups = m_cacheHits_ + m_cacheMisses_;
+        ImGui::Text("Hot  hit=%llu miss=%llu evict=%llu (hit rate %.1f%%)",
+            (unsigned long long)m_cacheHits_, (unsigned long long)m_cacheMisses_,
+            (unsigned long long)m_cacheEvictions_, lookups ? m_cacheHits_ * 100.0 / lookups : 0.0);
+        int budgetMB = (int)(m_cacheBudget_ / (1024 * 1024));
+        if (ImGui::InputInt("Cache Budget (MB, 0=unlimited)", &budgetMB) && budgetMB >= 0) {
+            m_cacheBudget_ = (size_t)budgetMB * 1024 * 1024;
+            EvictLocked(); // ǂo͎̓ǂݍ݂ warm ֈk
+        }
+    }
+    {
+        // warm  hit rate  hot ŊOꂽv̂ warm Ō
+        CompressedCache::Stats ws = m_warm_.GetStats();
+        uint64_t lookups = ws.hits + ws.misses;
+        ImGui::Text("Warm: %zu (%.2f MB stored, %.2f MB raw, ratio %.1f%%, budget %.2f MB)", ws.entries,
+            ws.bytes / (1024.0 * 1024.0), ws.originalBytes / (1024.0 * 1024.0),
+            ws.originalBytes ? ws.bytes * 100.0 / ws.originalBytes : 0.0, m_warm_.GetBudget() / (1024.0 * 1024.0));
+        ImGui::Text("Warm hit=%llu miss=%llu evict=%llu (hit rate %.1f%%, decode %.0f MB/s)",
+            (unsigned long long)ws.hits, (unsigned long long)ws.misses, (unsigned long long)ws.evictions,
+            lookups ? ws.hits * 100.0 / lookups : 0.0,
+            ws.decodeNs ? ws.decodedBytes / (1024.0 * 1024.0) / (ws.decodeNs / 1e9) : 0.0);
+        int warmMB = (int)(m_warm_.GetBudget() / (1024 * 1024));
+        if (ImGui::InputInt("Warm Budget (MB, 0=disabled)", &warmMB) && warmMB >= 0) {
+            m_warm_.SetBudget((size_t)warmMB * 1024 * 1024);
+            if (warmMB == 0) m_warmPending_.clear();
+        }
+    }
+    ImGui::Text("AutoSync: %s (%s, events=%llu)", m_watchRunning_.load() ? "Running" : "Stopped",
+        m_watchBackendName_.c_str(), (unsigned long long)m_watchEvents_.load());
     ImGui::Text("ScanCount: %llu", (unsigned long long)m_scanCount_.load());
     ImGui::Text("LastDiff A=%llu M=%llu R=%llu",
         (unsigned long long)m_lastDiffAdds_.load(),
         (unsigned long long)m_lastDiffMods_.load(),
         (unsigned long long)m_lastDiffRemoves_.load());
     ImGui::Text("LastScanDuration: %llu ms", (unsigned long long)m_lastScanDurationMs_.load());
+    ImGui::Text("Zero-copy: %.2f MB  Copied: %.2f MB  Unbuffered: %.2f MB",
+        m_viewBytes_.load() / (1024.0 * 1024.0),
+        m_copyBytes_.load() / (1024.0 * 1024.0),
+        m_directBytes_.load() / (1024.0 * 1024.0));
+    {
+        std::lock_guard<std::mutex> iolk(m_ioMtx_);
+        ImGui::Text("Async I/O: threads=%zu queued=%zu running=%zu",
+            m_ioThreads_.size(), m_ioQueued_, m_ioRunning_);
+    }
+    ImGui::Text("Prefetched: %zu assets, %.2f MB (hits=%llu)", m_prefetched_.size(),
+        m_prefetchedBytes_ / (1024.0 * 1024.0), (unsigned long long)m_prefetchHits_.load());
+    ImGui::Text("Async req=%llu coalesced=%llu cancelled=%llu done=%llu",
+        (unsigned long long)m_ioRequested_.load(),
+        (unsigned long long)m_ioCoalesced_.load(),
+        (unsigned long long)m_ioCancelled_.load(),
+        (unsigned long long)m_ioCompleted_.load());
+    const bool runStressTest = ImGui::Button("Async Stress Test (10k requests)");
+    ImGui::SameLine();
+    const bool runHashTest = ImGui::Button("Hash Self Test / Benchmark");
+    if (!m_selfTestLog_.empty()) {
+        ImGui::BeginChild("AssetManagerSelfTest", ImVec2(0, 120), true, ImGuiWindowFlags_HorizontalScrollbar);
+        ImGui::TextUnformatted(m_selfTestLog_.c_str());
+        ImGui::EndChild();
+    }
+
+    {
+        char path[260];
+        strncpy_s(path, m_tracePath_.c_str(), sizeof(path) - 1);
+        if (ImGui::InputText("Trace File", path, sizeof(path))) m_tracePath_ = path;
+        if (!m_trace_.IsActive()) {
+            if (ImGui::Button("Start Load Trace")) StartLoadTrace();
+        }
+        else {
+            if (ImGui::Button("Stop & Save Trace")) StopLoadTrace(m_tracePath_);
+            ImGui::SameLine();
+            ImGui::Text("Tracing: %zu assets", m_trace_.GetRecordCount());
+        }
+    }
 
     static char filter[128] = "";
     ImGui::InputText("Filter (substring)", filter, sizeof(filter));
 
     if (ImGui::Button("Clear Raw Cache")) {
-        m_cache_.clear();
+        ClearCacheLocked();
         m_fileMeta_.clear();
     }
     ImGui::SameLine();
@@ -289,22 +1149,62 @@ void AssetManager::DrawDebugGUI()
     ImGui::BeginChild("AssetManagerCacheList", ImVec2(0, 160), true);
     for (auto& kv : m_cache_) {
         if (filter[0] && kv.first.find(filter) == std::string::npos) continue;
-        ImGui::Text("%s (size=%zu bytes)", kv.first.c_str(), kv.second.size());
+        ImGui::Text("%s (size=%zu bytes, refs=%ld)", kv.first.c_str(), kv.second.data->size(), kv.second.data.use_count());
     }
     ImGui::EndChild();
+    lk.unlock();
+
+    // Ȑff͕ʂ̃CX^XōŝŁAm_mtx_ 𗣂Ă瑖点
+    if (runStressTest) {
+        std::string log;
+        const bool ok = AsyncStressTest(log);
+        log += ok ? "ALL PASS" : "FAILED";
+        lk.lock();
+        m_selfTestLog_ = std::move(log);
+    }
+    // PCLMUL / SHA-NI ƏƍĊȇx𑪂ÃAZbgŃ}bv̑xׂ
+    // (pbJ[ --bench-hash Ɠ)
+    if (runHashTest) {
+        std::string log;
+        const bool ok = HashUtil::SelfTest(log);
+        HashUtil::Benchmark(log);
+        HashUtil::BenchmarkStringMap(GetCachedAssetNames(), log);
+        log += ok ? "ALL PASS" : "FAILED";
+        lk.lock();
+        m_selfTestLog_ = std::move(log);
+    }
+}
+
+// m_mtx_ ێԂŌĂԂ
+std::vector<std::string> AssetManager::GetAssetNamesLocked() const {
+    std::vector<std::string> names;
+    if (m_mode_ == LoadMode::FromArchive && m_mounts_) {
+        names = m_mounts_->GetEntryNames();
+    }
+    else {
+        // LbVǂoꂽt@CĎŌĂΈꗗɊ܂߂
+        names.reserve(m_fileMeta_.size() + m_cache_.size());
+        for (auto& kv : m_fileMeta_) names.push_back(kv.first);
+        for (auto& kv : m_cache_) {
+            if (m_fileMeta_.find(kv.first) == m_fileMeta_.end()) names.push_back(kv.first);
+        }
+        m_warm_.ForEach([&](const std::string& name, const CompressedCache::Blob&) {
+            if (m_fileMeta_.find(name) == m_fileMeta_.end() && m_cache_.find(name) == m_cache_.end()) names.push_back(name);
+        });
+    }
+    return names;
 }
 
 std::vector<std::string> AssetManager::GetCachedAssetNames(bool onlyModelExt) const {
     std::vector<std::string> result;
     {
         std::lock_guard<std::mutex> lk(m_mtx_);
-        result.reserve(m_cache_.size());
-        for (auto& kv : m_cache_) {
+        for (auto& name : GetAssetNamesLocked()) {
             if (!onlyModelExt) {
-                result.push_back(kv.first);
+                result.push_back(name);
             }
             else {
-                std::string lower = kv.first;
+                std::string lower = name;
                 for (auto& c : lower) c = (char)tolower(c);
                 auto hasExt = [&](const char* ext)->bool {
                     size_t Ls = lower.size(), Le = std::strlen(ext);
@@ -312,7 +1212,7 @@ std::vector<std::string> AssetManager::GetCachedAssetNames(bool onlyModelExt) co
                     return lower.compare(Ls - Le, Le, ext) == 0;
                     };
                 if (hasExt(".fbx") || hasExt(".obj") || hasExt(".gltf") || hasExt(".glb"))
-                    result.push_back(kv.first);
+                    result.push_back(name);
             }
         }
     }
@@ -325,9 +1225,8 @@ std::vector<std::string> AssetManager::GetCachedTextureNames() const{
     std::vector<std::string> result;
     {
         std::lock_guard<std::mutex> lk(m_mtx_);
-        result.reserve(m_cache_.size());
-        for (auto& kv : m_cache_) {
-            std::string lower = kv.first;
+        for (auto& name : GetAssetNamesLocked()) {
+            std::string lower = name;
             for (auto& c : lower) c = (char)tolower(c);
             auto hasExt = [&](const char* ext)->bool {
                 size_t Ls = lower.size(), Le = std::strlen(ext);
@@ -335,7 +1234,7 @@ std::vector<std::string> AssetManager::GetCachedTextureNames() const{
                 return lower.compare(Ls - Le, Le, ext) == 0;
                 };
             for (auto* e : exts) {
-                if (hasExt(e)) { result.push_back(kv.first); break; }
+                if (hasExt(e)) { result.push_back(name); break; }
             }
         }
     }
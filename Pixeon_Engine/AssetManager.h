@@ -13,7 +13,51 @@
 #include <atomic>
 #include <chrono>
 #include <deque>
+#include <list>
 #include <filesystem>
+#include <memory>
+#include <span>
+#include <functional>
+#include <condition_variable>
+#include "FileWatcher.h"
+#include "HashUtill.h"
+#include "LoadTrace.h"
+#include "CompressedCache.h"
+
+class PakArchive;
+class PakMountStack;
+class PakScrubber;
+
+// AZbg̓ǂݎpr[
+// owner (}bvς݃A[JCu / LbVobt@) QƃJEgŕێ̂
+// r[ĂԂ data() ɂȂȂ
+class AssetView
+{
+public:
+    AssetView() = default;
+    AssetView(std::shared_ptr<const void> owner, const uint8_t* data, size_t size)
+        : m_owner_(std::move(owner)), m_data_(data), m_size_(size) {}
+
+    const uint8_t* data() const { return m_data_; }
+    size_t size() const { return m_size_; }
+    bool empty() const { return m_size_ == 0; }
+    const uint8_t& operator[](size_t i) const { return m_data_[i]; }
+    std::span<const uint8_t> span() const { return { m_data_, m_size_ }; }
+    explicit operator bool() const { return m_owner_ != nullptr; }
+
+private:
+    std::shared_ptr<const void> m_owner_;
+    const uint8_t* m_data_ = nullptr;
+    size_t m_size_ = 0;
+};
+
+// 񓯊ǂݍ݂̗Dx (ォ珇ɏ)
+enum class AssetPriority : uint8_t { Critical, High, Normal, Low, Count };
+
+using AssetRequestId = uint64_t;
+// ǂݍ݊ I/O XbhĂ΂ (s͋̃r[)B
+// D3D ̃foCXReLXgȂǃCXbhp̂̂͂ŐGȂ
+using AssetCallback = std::function<void(const std::string& logicalName, AssetView data)>;
 
 class AssetManager
 {
@@ -26,17 +70,78 @@ public:
     void UnInit();
 
     void SetRoot(const std::string& root);
+    const std::string& GetRoot() const { return m_root_; }
     void SetLoadMode(LoadMode m);
+    LoadMode GetLoadMode() const { return m_mode_; }
+    void SetArchivePath(const std::string& archivePath);
+    void AddPatchArchive(const std::string& patchPath); // x[X̏ɏd˂pb` (ǉɗDxオ)
+    void ClearPatchArchives();
+    bool MountArchive();   // FromArchive p: x[X + pb`J TOC ǂݍ
+    void UnmountArchive();
+    bool IsArchiveMounted() const;
+    // A[JCu̐ (MountArchive OɌĂ)BeGg̏ǂݍ݂ CRC32 m߁A
+    // DxXbh scrubBytesPerSec ȉ̑шőSGg SHA-256 ƍ
+    void SetArchiveVerify(bool enable, uint64_t scrubBytesPerSec = 8ull * 1024 * 1024);
     bool LoadAsset(const std::string& logicalName, std::vector<uint8_t>& outData); // oCg擾
+    AssetView AcquireAsset(const std::string& logicalName); // Rs[̓ǂݎpr[擾
     bool Exists(const std::string& logicalName);
     void ClearRawCache();
+    // f[^LbV̏ (oCg, 0 Ŗ)B͎QƂ̖̂ÂɎ̂Ă
+    void SetCacheBudget(size_t bytes);
+    size_t GetCacheBudget() const;
+    // 2 iڂ̃LbV (LZ4 k̂܂ܕێ) ̏ (oCg, 0 Ŗ)B
+    // 𒴂Ēǂoꂽ͔̂jA̗vŃfBXNǂݒB
+    // JԂǂޔ͈͂菬ƁAŜɓǂݒgł͓炸Ɉk̎Ԃ|
+    void SetWarmCacheBudget(size_t bytes);
+    size_t GetWarmCacheBudget() const;
+
+    // 񓯊ǂݍ݁BAZbgւ̗v 1 ̓ǂݍ݂ɂ܂Ƃ߁ASɓr[n
+    AssetRequestId RequestAsync(const std::string& logicalName, AssetPriority priority, AssetCallback callback);
+    // R[obNOɎꍇ true (ṽR[obN͌Ă΂Ȃ)
+    bool CancelAsync(AssetRequestId id);
+    void SetIOThreadCount(unsigned count); // ŏ RequestAsync OɌĂ
+
+    // ǂ݁Bnames ̃AZbg I/O Xbhł܂Ƃ߂ēǂݍ݁ASďI܂ő҂B
+    // A[JCuł͋߂Gg͈̔͂ 1 ̓ǂݍ݂ɂ܂Ƃ߁Aʂ ClearPrefetched ܂ŕێ
+    // LoadAsset / AcquireAsset Ԃ (\[XtH_ł͐f[^LbVɓ)
+    struct PrefetchResult {
+        size_t assets = 0; // ǂ݂AZbg
+        size_t reads = 0;  // sǂݍݐ (A[JCuł͂܂Ƃ߂͈͂̐)
+        uint64_t bytes = 0;
+    };
+    PrefetchResult PrefetchAssets(const std::vector<std::string>& names);
+    void ClearPrefetched();
+
+    // [hg[XBL^ LoadAsset / AcquireAsset / RequestAsync ŗvꂽAZbg
+    // V[ɏgpŋL^AStopLoadTrace ŏo (pbJ[ --trace ŔzuɎg)
+    void StartLoadTrace();
+    void MarkLoadTraceScene(const std::string& sceneName); // V[؂ւ SceneManger Ă
+    bool StopLoadTrace(const std::string& outPath);
+    bool IsLoadTracing() const { return m_trace_.IsActive(); }
 
     void DrawDebugGUI();
 
+    // ȐffBꎞtH_̃t@CpbJ[ (packerPath) ł܂Ƃ߁Aʂ̃CX^XőSGg
+    // ǂݖ߂ TOC  CRC32 / SHA-256 ƌt@Cɏƍ
+    static bool ArchiveSelfTest(const std::string& packerPath, std::string& log);
+    // 8 Xbhv 10k  RequestAsync (ꕔ͂ CancelAsync) oASR[obN̓eƉ񐔂m߂
+    static bool AsyncStressTest(std::string& log);
+    // V[؂ւ̌vB4 V[̃AZbg / g[XzuŃpbNAt@CLbV̂Ă
+    // ǂݖ / L̓ǂݍݎԂׂBǂݒ StopIOThreads ő҂I邱Ƃm߂
+    static bool PrefetchBenchmark(const std::string& packerPath, std::string& log);
+    // [Rs[̌vBtotalBytes ( 1GB) ̔񈳏kA[JCuAt@CLbV̂Ă
+    // LoadAsset (q[v֕)  AcquireAsset (}bvy[W̃r[) őS
+    // ǂݍݎԂƃ[LOZbg / vCx[g̃R~bgʂ̍ő呝ׂ
+    static bool ZeroCopyBenchmark(const std::string& packerPath, std::string& log, uint64_t totalBytes = 1ull << 30);
+    // ړǂݍ݂̌vBt@C 3000  1MB ȏ̃t@C alignment 4096  --group-small  / L
+    // 2 ʂɃpbNAt@CLbV̂ĂĒ (傫Gĝ) / obt@oR / }bvőSǂގԂׂ
+    static bool DirectReadBenchmark(const std::string& packerPath, std::string& log);
+
     void StartAutoSync(std::chrono::milliseconds interval = std::chrono::milliseconds(1000),
         bool recursive = true);
 
 	void StopAutoSync();
+    void SetUseNativeWatch(bool use) { m_useNativeWatch_ = use; } // StartAutoSync OɌĂ
 
     bool IsAutoSyncRunning() const { return m_watchRunning_.load(); }
 
@@ -46,10 +151,25 @@ private:
     AssetManager() = default;
     ~AssetManager();
     std::string Normalize(const std::string& name) const;
+    bool LoadFromArchive(const std::string& norm, std::vector<uint8_t>& outData);
+    AssetView AcquireFromArchive(const std::string& norm);
+    AssetView FindPrefetched(const std::string& norm);
+    void RunAndWait(std::vector<std::function<void()>> tasks);
+    bool IsForegroundReading() const;
+    std::shared_ptr<const std::vector<uint8_t>> LoadSourceShared(const std::string& norm);
+    std::vector<std::string> GetAssetNamesLocked() const;
+    void InsertCacheLocked(const std::string& norm, std::shared_ptr<const std::vector<uint8_t>> data);
+    void EraseCacheLocked(const std::string& norm);
+    void InvalidateCacheLocked(const std::string& norm);
+    void ClearCacheLocked();
+    void EvictLocked();
+    void FlushWarmPending();
 
     void WatchLoop();
 
     void PerformScan();
+    void RunTimedScan();
+    void ApplyWatchChanges(const std::vector<std::string>& changed);
 
     struct FileMeta {
         uint64_t size = 0;
@@ -64,14 +184,61 @@ private:
     };
 
     void PushChange(ChangeType type, const std::string& path);
+    void PushChangeLocked(ChangeType type, const std::string& path);
+
+    struct AsyncWaiter {
+        AssetRequestId id = 0;
+        AssetCallback callback;
+    };
+    struct AsyncJob {
+        std::string norm;
+        AssetPriority priority = AssetPriority::Normal;
+        std::vector<AsyncWaiter> waiters;
+        bool started = false;
+        bool dropped = false; // Svꂽ (L[ɎcĂĂ̂Ă)
+        std::function<void()> task; // ݒ肳ĂΓǂݍ݂̑Ɏs (ǂ)
+        std::function<void()> cancel; // task sꂸ StopIOThreads Ŏ̂ĂꂽɌĂ
+    };
+
+    void StartIOThreadsLocked();
+    void StopIOThreads();
+    void IOLoop(uint64_t generation);
+    std::shared_ptr<AsyncJob> PopJobLocked();
 
 private:
 
     std::string m_root_;
-    LoadMode m_mode_ = LoadMode::FromSource;
+    std::atomic<LoadMode> m_mode_{ LoadMode::FromSource };
+
+    std::string m_archivePath_;
+    std::vector<std::string> m_patchPaths_;
+    std::shared_ptr<const PakMountStack> m_mounts_;
 
-    std::unordered_map<std::string, std::vector<uint8_t>> m_cache_;
-    std::unordered_map<std::string, FileMeta> m_fileMeta_;
+    bool m_verify_ = false;
+    uint64_t m_scrubRate_ = 8ull * 1024 * 1024;
+    std::unique_ptr<PakScrubber> m_scrubber_;        // ؗLɃ}Egƈꏏɍ
+    std::atomic<int> m_archiveReads_{ 0 };           // s̃tHAOEhǂݍݐ
+    std::atomic<int64_t> m_lastArchiveRead_{ 0 };    // Ō̓ǂݍ݂I (steady_clock, ns)
+
+    // f[^LbV (LRU)Bm_lru_ ̐擪ŋߎǵB
+    // LbVOŎQƂĂobt@ (AssetView Ŏgp) ͒ǂoȂ
+    struct CacheEntry {
+        std::shared_ptr<const std::vector<uint8_t>> data;
+        std::list<std::string>::iterator lru;
+    };
+    HashUtil::StringMap<CacheEntry> m_cache_;
+    std::list<std::string> m_lru_;
+    size_t m_cacheBytes_ = 0;
+    size_t m_cacheBudget_ = 256ull * 1024 * 1024;
+    uint64_t m_cacheHits_ = 0;
+    uint64_t m_cacheMisses_ = 0;
+    uint64_t m_cacheEvictions_ = 0;
+    // hot ǂof[^ m_warm_ ɈkĎcBk̓bN̊Oōŝ
+    // ǂo_ł m_warmPending_ ɐς݁AFlushWarmPending ł܂Ƃ߂Ĉk
+    CompressedCache m_warm_;
+    std::vector<std::pair<std::string, std::shared_ptr<const std::vector<uint8_t>>>> m_warmPending_;
+    uint64_t m_cacheEpoch_ = 0; // t@CύXŃLbV̂Ăxɐi߂ (kɕςeȂ)
+    HashUtil::StringMap<FileMeta> m_fileMeta_;
 
     std::deque<ChangeLog> m_recentChanges_;
 
@@ -80,6 +247,10 @@ private:
     std::atomic<bool> m_watchRunning_{ false };
     std::chrono::milliseconds m_interval_{ 1000 };
     bool m_recursive_ = true;
+    bool m_useNativeWatch_ = true;                    // false Ȃ|[Ô
+    std::unique_ptr<IFileWatchBackend> m_watchBackend_; // ĎXbhғ̂ (m_mtx_ ŕی)
+    std::string m_watchBackendName_ = "Polling";
+    std::atomic<uint64_t> m_watchEvents_{ 0 };        // 󂯎ύXʒm̐
 
     std::atomic<uint64_t> m_scanCount_{ 0 };
     std::atomic<uint64_t> m_lastDiffAdds_{ 0 };
@@ -87,8 +258,43 @@ private:
     std::atomic<uint64_t> m_lastDiffMods_{ 0 };
     std::atomic<uint64_t> m_lastScanDurationMs_{ 0 };
 
+    std::atomic<uint64_t> m_viewBytes_{ 0 };   // AcquireAsset ŃRs[ɓnoCg
+    std::atomic<uint64_t> m_copyBytes_{ 0 };   // LoadAsset / }bvǂݍ݂ŃRs[oCg
+    std::atomic<uint64_t> m_directBytes_{ 0 }; // obt@Oǂݍ݂ŒړnoCg
+
+    // PrefetchAssets Őǂ݂A[JCũAZbg (m_mtx_ ŕی)B
+    // kGg͂܂Ƃ߂ēǂ񂾔͈͂̃obt@wr[ALZ4 ͓WJ̃obt@
+    HashUtil::StringMap<AssetView> m_prefetched_;
+    uint64_t m_prefetchedBytes_ = 0;
+    std::atomic<uint64_t> m_prefetchHits_{ 0 };
+
+    LoadTrace m_trace_;
+    std::string m_tracePath_ = "load_trace.txt";
+    std::string m_selfTestLog_; // fobO GUI ̎Ȑff (m_mtx_ ŕی)
+
     mutable std::mutex m_mtx_;
 
+    // 񓯊 I/O (m_ioMtx_ ŕی)
+    std::mutex m_ioMtx_;
+    std::condition_variable m_ioCv_;
+    std::vector<std::thread> m_ioThreads_;
+    unsigned m_ioThreadCount_ = 0; // 0: _RA̔ (2`4)
+    // StopIOThreads ɐi߂BN̒lςXbh͏I
+    // (~ join ɕʃXbh RunAndWait VXbhNĂÂ͎~܂)
+    uint64_t m_ioGeneration_ = 0;
+    // Dxʂ̃L[BDxグv͏̃L[ɂς݁AÂ͎oɓǂݔ΂
+    std::deque<std::shared_ptr<AsyncJob>> m_ioQueues_[(size_t)AssetPriority::Count];
+    HashUtil::StringMap<std::shared_ptr<AsyncJob>> m_ioJobs_;                    // norm  ҋ@ / s
+    std::unordered_map<AssetRequestId, std::shared_ptr<AsyncJob>> m_ioRequests_; // v ID  Wu
+    AssetRequestId m_nextRequestId_ = 1;
+    size_t m_ioQueued_ = 0; // ̃Wu
+    size_t m_ioRunning_ = 0; // I/O Xbhs̃Wu
+
+    std::atomic<uint64_t> m_ioRequested_{ 0 };
+    std::atomic<uint64_t> m_ioCoalesced_{ 0 };
+    std::atomic<uint64_t> m_ioCancelled_{ 0 };
+    std::atomic<uint64_t> m_ioCompleted_{ 0 };
+
 	static AssetManager* s_instance_;
     static constexpr size_t kMaxRecentChanges_ = 64;
 };
@@ -0,0 +1,665 @@
+// AssetManager の自己診断 (デバッグ GUI から呼ぶ)
+// Instance() とは別のインスタンスを作って試すので、エディタが読み込んでいるアセットには触らない
+
+#include "AssetManager.h"
+#include "PakArchive.h"
+#include "PakMountStack.h"
+#include "PakScrubber.h"
+#include "File.h"
+#include "HashUtill.h"
+#include <Windows.h>
+#include <psapi.h>
+#include <fstream>
+#include <random>
+#include <cstring>
+#include <thread>
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+    struct TestFile {
+        std::string name; // 読み込みに使う名前 (大文字 / '\\' を含むものもある)
+        std::vector<uint8_t> data;
+    };
+
+    // 圧縮の効く物 / 効かない物 / 空 / 辞書に入る小さい物 / 重複 / 大文字のパスを一通り用意する
+    std::vector<TestFile> MakeTestFiles() {
+        std::mt19937 rng(7);
+        std::vector<TestFile> files;
+        auto add = [&](std::string name, std::vector<uint8_t> data) {
+            files.push_back({ std::move(name), std::move(data) });
+        };
+        {
+            // LZ4 のチャンク (256KB) を複数またぐテキスト
+            std::string text;
+            for (int i = 0; text.size() < 600 * 1024; ++i)
+                text += "material " + std::to_string(i % 97) + " diffuse=tex/albedo_" + std::to_string(i % 13) + ".png\n";
+            add("text/materials.txt", std::vector<uint8_t>(text.begin(), text.end()));
+        }
+        {
+            std::vector<uint8_t> noise(300 * 1024 + 17);
+            for (auto& b : noise) b = (uint8_t)rng();
+            add("bin/noise.bin", std::move(noise));
+        }
+        add("empty.dat", {});
+        for (int i = 0; i < 24; ++i) {
+            std::string s = "{ \"id\": " + std::to_string(i) + ", \"name\": \"prop_" + std::to_string(i * 31) + "\", \"scale\": [1, 1, 1] }\n";
+            add("small/prop_" + std::to_string(i) + ".json", std::vector<uint8_t>(s.begin(), s.end()));
+        }
+        add("dup/prop_copy.json", files.back().data);
+        {
+            std::string s = "Mixed case path\n";
+            add("Upper\\MixedCase.TXT", std::vector<uint8_t>(s.begin(), s.end()));
+        }
+        return files;
+    }
+
+    bool WriteFileBytes(const std::filesystem::path& path, const std::vector<uint8_t>& data) {
+        std::error_code ec;
+        std::filesystem::create_directories(path.parent_path(), ec);
+        std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+        if (!ofs) return false;
+        if (!data.empty()) ofs.write(reinterpret_cast<const char*>(data.data()), (std::streamsize)data.size());
+        return (bool)ofs;
+    }
+
+    // プロセスのワーキングセットとプライベートのコミット量 (ヒープへの複写はこちらにも乗る)
+    struct MemorySample {
+        uint64_t workingSet = 0;
+        uint64_t privateBytes = 0;
+    };
+    MemorySample SampleMemory() {
+        PROCESS_MEMORY_COUNTERS_EX pmc{};
+        pmc.cb = sizeof(pmc);
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&pmc), sizeof(pmc))) return {};
+        return { (uint64_t)pmc.WorkingSetSize, (uint64_t)pmc.PrivateUsage };
+    }
+
+    // 自己診断用の作業フォルダ (既にあれば消して作り直す)
+    std::filesystem::path MakeWorkDir(const char* name) {
+        std::error_code ec;
+        std::filesystem::path dir = std::filesystem::temp_directory_path(ec) / name;
+        std::filesystem::remove_all(dir, ec);
+        std::filesystem::create_directories(dir, ec);
+        return dir;
+    }
+
+} // namespace
+
+bool AssetManager::ArchiveSelfTest(const std::string& packerPath, std::string& log) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    const fs::path work = MakeWorkDir("PixeonArchiveSelfTest");
+    const fs::path srcDir = work / "src";
+
+    const std::vector<TestFile> files = MakeTestFiles();
+    for (const TestFile& f : files) {
+        // 読み込み側は大文字 / '\\' 混じりの名前で引く (パッカーは小文字化したパスで読み直すので小文字で書く)
+        std::string rel = f.name;
+        for (auto& c : rel) c = (c == '\\') ? '/' : (char)tolower((unsigned char)c);
+        if (!WriteFileBytes(srcDir / fs::path(rel), f.data)) {
+            log += "FAIL: cannot write " + (srcDir / fs::path(rel)).string() + "\n";
+            return false;
+        }
+    }
+    HashUtil::InitCRC32();
+
+    // 既定 (LZ4 + 重複排除) / 無圧縮 / 共有辞書 / 4KB 境界 + 小ファイル詰めでそれぞれまとめて読み戻す。
+    // verify は初回読み込みの CRC32 検証と走査を有効にしてマウントする
+    struct Variant { const char* name; const char* args; bool verify; };
+    const Variant variants[] = {
+        { "default", "", false },
+        { "default+verify", "", true },
+        { "no-compress", "--no-compress", false },
+        { "dict", "--dict", false },
+        { "align4k+group", "4096 --group-small 4096", false },
+    };
+    bool ok = true;
+    char line[256];
+    for (const Variant& v : variants) {
+        const fs::path pak = work / (std::string(v.name) + ".PixAssets");
+        if (!File::CallAssetPacker(packerPath, srcDir.string(), pak.string(), v.args)) {
+            log += std::string("FAIL: ") + v.name + ": packer failed (" + packerPath + ")\n";
+            ok = false;
+            continue;
+        }
+
+        AssetManager am;
+        am.SetArchivePath(pak.string());
+        am.SetArchiveVerify(v.verify);
+        am.SetLoadMode(LoadMode::FromArchive);
+        if (!am.IsArchiveMounted()) {
+            log += std::string("FAIL: ") + v.name + ": mount failed\n";
+            ok = false;
+            continue;
+        }
+        const PakArchive& archive = *am.m_mounts_->GetMounts().front();
+        const bool stdSha = HasFlag((uint16_t)archive.GetHeader().flags, AssetFlag_StdSHA256);
+
+        size_t failures = 0;
+        std::string firstFailure;
+        auto fail = [&](const std::string& what) {
+            if (failures++ == 0) firstFailure = what;
+        };
+        if (archive.GetEntries().size() != files.size())
+            fail("entry count " + std::to_string(archive.GetEntries().size()) + " != " + std::to_string(files.size()));
+        if (!stdSha) fail("archive has no standard SHA-256");
+
+        for (const TestFile& f : files) {
+            const PakArchive::Entry* entry = archive.Find(f.name);
+            if (!entry) { fail(f.name + ": not in TOC"); continue; }
+            if (entry->originalSize != f.data.size()) { fail(f.name + ": size mismatch in TOC"); continue; }
+            if (entry->crc32 != HashUtil::CalcCRC32(f.data.data(), f.data.size())) fail(f.name + ": TOC CRC32 != source");
+            if (stdSha && memcmp(entry->sha256, HashUtil::SHA256(f.data).data(), 32) != 0) fail(f.name + ": TOC SHA-256 != source");
+
+            // 読み戻したデータを TOC と元ファイルの両方に照合する
+            std::vector<uint8_t> loaded;
+            if (!am.LoadAsset(f.name, loaded)) { fail(f.name + ": LoadAsset failed"); continue; }
+            if (HashUtil::CalcCRC32(loaded.data(), loaded.size()) != entry->crc32) fail(f.name + ": LoadAsset CRC32 mismatch");
+            if (stdSha && memcmp(HashUtil::SHA256(loaded).data(), entry->sha256, 32) != 0) fail(f.name + ": LoadAsset SHA-256 mismatch");
+            if (loaded != f.data) fail(f.name + ": LoadAsset bytes differ from source");
+
+            AssetView view = am.AcquireAsset(f.name);
+            if (!view) { fail(f.name + ": AcquireAsset failed"); continue; }
+            if (view.size() != f.data.size() || (view.size() && memcmp(view.data(), f.data.data(), view.size()) != 0))
+                fail(f.name + ": AcquireAsset bytes differ from source");
+        }
+        if (am.Exists("missing/not_packed.bin")) fail("Exists() true for a missing entry");
+        const size_t entryCount = archive.GetEntries().size();
+        am.UnInit();
+
+        ok = ok && failures == 0;
+        snprintf(line, sizeof(line), "%-15s %3zu entries  %s", v.name, entryCount, failures ? "FAIL" : "PASS");
+        log += line;
+        if (failures) log += " (" + std::to_string(failures) + " failures, first: " + firstFailure + ")";
+        log += "\n";
+    }
+
+    // 格納データを 1 バイト壊したコピーは、検証を有効にすると読み込みに失敗しなければならない
+    {
+        const fs::path pak = work / "default.PixAssets";
+        const fs::path bad = work / "corrupt.PixAssets";
+        const std::string victim = "bin/noise.bin"; // 無圧縮で格納される
+        uint64_t offset = 0;
+        {
+            PakArchive archive;
+            const PakArchive::Entry* entry = archive.Open(pak.string()) ? archive.Find(victim) : nullptr;
+            if (entry) offset = entry->offset + entry->storedSize / 2;
+        }
+        bool corrupted = offset != 0 && fs::copy_file(pak, bad, fs::copy_options::overwrite_existing, ec);
+        if (corrupted) {
+            std::fstream f(bad, std::ios::in | std::ios::out | std::ios::binary);
+            char c = 0;
+            f.seekg((std::streamoff)offset);
+            f.read(&c, 1);
+            c = (char)~c;
+            f.seekp((std::streamoff)offset);
+            f.write(&c, 1);
+            corrupted = (bool)f;
+        }
+        bool detected = false;
+        if (corrupted) {
+            AssetManager am;
+            am.SetArchivePath(bad.string());
+            am.SetArchiveVerify(true);
+            am.SetLoadMode(LoadMode::FromArchive);
+            std::vector<uint8_t> data;
+            detected = am.IsArchiveMounted() && !am.LoadAsset(victim, data) && !am.AcquireAsset(victim);
+            am.UnInit();
+        }
+        ok = ok && detected;
+        log += std::string("corrupt entry detected with verify: ") + (detected ? "PASS" : "FAIL") + "\n";
+    }
+    fs::remove_all(work, ec);
+    return ok;
+}
+
+bool AssetManager::AsyncStressTest(std::string& log) {
+    namespace fs = std::filesystem;
+    constexpr int kFiles = 256;
+    constexpr int kThreads = 8;
+    constexpr int kPerThread = 1250; // 8 x 1250 = 10k 要求
+    const fs::path work = MakeWorkDir("PixeonAsyncStressTest");
+
+    // 1B〜64KB のファイル。要求が同じファイルに集まって相乗りが起きる数にしておく
+    std::mt19937 rng(11);
+    std::vector<std::string> names(kFiles);
+    std::vector<uint32_t> crcs(kFiles);
+    HashUtil::InitCRC32();
+    for (int i = 0; i < kFiles; ++i) {
+        std::vector<uint8_t> data(1 + rng() % (64 * 1024));
+        for (auto& b : data) b = (uint8_t)rng();
+        names[i] = "stress/file_" + std::to_string(i) + ".bin";
+        crcs[i] = HashUtil::CalcCRC32(data.data(), data.size());
+        if (!WriteFileBytes(work / names[i], data)) {
+            log += "FAIL: cannot write " + (work / names[i]).string() + "\n";
+            return false;
+        }
+    }
+
+    AssetManager am;
+    am.SetRoot(work.string());
+    am.SetCacheBudget(1024 * 1024); // 全体 (約 8MB) より小さくして追い出しも起こす
+
+    // 要求毎のコールバック回数。取り消せた要求は 0 回、それ以外はちょうど 1 回でなければならない
+    std::vector<std::atomic<uint8_t>> calls(kThreads * kPerThread);
+    std::vector<uint8_t> cancelled(kThreads * kPerThread, 0);
+    std::atomic<int> done{ 0 }, bad{ 0 };
+    std::atomic<int> cancelCount{ 0 };
+
+    const auto t0 = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            std::mt19937 r(100 + t);
+            for (int i = 0; i < kPerThread; ++i) {
+                const int slot = t * kPerThread + i;
+                const int file = (int)(r() % kFiles);
+                const AssetPriority priority = (AssetPriority)(r() % (int)AssetPriority::Count);
+                const AssetRequestId id = am.RequestAsync(names[file], priority,
+                    [&, slot, file](const std::string&, AssetView view) {
+                        if (!view || HashUtil::CalcCRC32(view.data(), view.size()) != crcs[file]) bad.fetch_add(1);
+                        calls[slot].fetch_add(1);
+                        done.fetch_add(1);
+                    });
+                // 5 件に 1 件はすぐ取り消す (読み込み中なら取り消せずにコールバックが来る)
+                if (r() % 5 == 0 && am.CancelAsync(id)) {
+                    cancelled[slot] = 1;
+                    cancelCount.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    const int total = kThreads * kPerThread;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (done.load() + cancelCount.load() < total && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    // 遅れて来る重複コールバックも数えるため少し待ってから止める
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    const uint64_t coalesced = am.m_ioCoalesced_.load();
+    am.UnInit();
+
+    int missing = 0, duplicated = 0, afterCancel = 0;
+    for (int i = 0; i < total; ++i) {
+        const int c = calls[i].load();
+        if (cancelled[i]) afterCancel += c != 0;
+        else if (c == 0) ++missing;
+        else if (c > 1) ++duplicated;
+    }
+    const bool ok = bad == 0 && missing == 0 && duplicated == 0 && afterCancel == 0;
+    char line[256];
+    snprintf(line, sizeof(line), "%d requests (%d threads): done=%d cancelled=%d coalesced=%llu in %.1f ms (%.0f req/s)\n",
+        total, kThreads, done.load(), cancelCount.load(), (unsigned long long)coalesced, ms, ms > 0.0 ? total / ms * 1000.0 : 0.0);
+    log += line;
+    snprintf(line, sizeof(line), "bad data=%d missing=%d duplicated=%d called after cancel=%d  %s\n",
+        bad.load(), missing, duplicated, afterCancel, ok ? "PASS" : "FAIL");
+    log += line;
+
+    std::error_code ec;
+    fs::remove_all(work, ec);
+    return ok;
+}
+
+bool AssetManager::PrefetchBenchmark(const std::string& packerPath, std::string& log) {
+    namespace fs = std::filesystem;
+    constexpr int kScenes = 4;
+    constexpr int kAssets = 400;        // 全アセット数。各シーンはこの中から 150 個使う
+    constexpr int kAssetsPerScene = 150;
+    const fs::path work = MakeWorkDir("PixeonPrefetchBench");
+    const fs::path srcDir = work / "src";
+
+    // 4KB〜64KB。半分は圧縮の効くテキスト、残りは乱数
+    std::mt19937 rng(23);
+    std::vector<std::string> names(kAssets);
+    std::vector<std::vector<uint8_t>> sources(kAssets);
+    for (int i = 0; i < kAssets; ++i) {
+        std::vector<uint8_t>& data = sources[i];
+        data.resize(4096 + rng() % (60 * 1024));
+        if (i % 2 == 0) {
+            for (size_t j = 0; j < data.size(); ++j) data[j] = (uint8_t)"vertex 0.0 1.0 0.5\n"[(j + i) % 19];
+        }
+        else {
+            for (auto& b : data) b = (uint8_t)rng();
+        }
+        names[i] = "bench/asset_" + std::to_string(i) + (i % 2 == 0 ? ".txt" : ".bin");
+        if (!WriteFileBytes(srcDir / names[i], data)) {
+            log += "FAIL: cannot write " + (srcDir / names[i]).string() + "\n";
+            return false;
+        }
+    }
+    // シーン毎の使用順 (名前順とは無関係に並べる)
+    std::vector<std::vector<int>> scenes(kScenes);
+    for (auto& scene : scenes) {
+        std::vector<int> all(kAssets);
+        for (int i = 0; i < kAssets; ++i) all[i] = i;
+        std::shuffle(all.begin(), all.end(), rng);
+        scene.assign(all.begin(), all.begin() + kAssetsPerScene);
+    }
+    std::vector<std::vector<std::string>> sceneNames(kScenes);
+    for (int s = 0; s < kScenes; ++s)
+        for (int i : scenes[s]) sceneNames[s].push_back(names[i]);
+
+    bool ok = true;
+    char line[256];
+
+    // ソースフォルダから読み込んでロードトレースを記録し、それを使う配置と既定の配置の 2 つを作る
+    const fs::path trace = work / "bench.pixtrace";
+    {
+        AssetManager am;
+        am.SetRoot(srcDir.string());
+        am.StartLoadTrace();
+        std::vector<uint8_t> data;
+        for (int s = 0; s < kScenes; ++s) {
+            am.MarkLoadTraceScene("scene_" + std::to_string(s));
+            for (auto& n : sceneNames[s]) am.LoadAsset(n, data);
+        }
+        if (!am.StopLoadTrace(trace.string())) {
+            log += "FAIL: cannot save load trace\n";
+            return false;
+        }
+        am.UnInit();
+    }
+    struct Layout { const char* name; std::string args; };
+    const Layout layouts[] = {
+        { "base", "" },
+        { "trace", "--trace \"" + trace.string() + "\"" },
+    };
+    for (const Layout& layout : layouts) {
+        const fs::path pak = work / (std::string(layout.name) + ".PixAssets");
+        if (!File::CallAssetPacker(packerPath, srcDir.string(), pak.string(), layout.args)) {
+            log += std::string("FAIL: ") + layout.name + ": packer failed (" + packerPath + ")\n";
+            ok = false;
+            continue;
+        }
+        AssetManager am;
+        am.SetArchivePath(pak.string());
+
+        // 先読み無し / 有りで全シーンを順に切り替え、切り替え毎に OS のファイルキャッシュを捨てる
+        double total[2] = {};
+        size_t bad = 0, reads = 0;
+        for (int mode = 0; mode < 2; ++mode) {
+            for (int s = 0; s < kScenes; ++s) {
+                am.UnmountArchive();
+                am.ClearRawCache();
+                // マップを外した状態で非バッファリングで開き直すとファイルのキャッシュが破棄される
+                HANDLE h = CreateFileA(pak.string().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                    OPEN_EXISTING, FILE_FLAG_NO_BUFFERING, nullptr);
+                if (h != INVALID_HANDLE_VALUE) CloseHandle(h);
+                am.SetLoadMode(LoadMode::FromArchive);
+                if (!am.IsArchiveMounted()) {
+                    log += std::string("FAIL: ") + layout.name + ": mount failed\n";
+                    return false;
+                }
+
+                const auto t0 = std::chrono::steady_clock::now();
+                if (mode == 1) reads += am.PrefetchAssets(sceneNames[s]).reads;
+                std::vector<AssetView> keep;
+                for (int i : scenes[s]) {
+                    AssetView view = am.AcquireAsset(names[i]);
+                    if (!view || view.size() != sources[i].size() || memcmp(view.data(), sources[i].data(), view.size()) != 0) ++bad;
+                    keep.push_back(std::move(view));
+                }
+                total[mode] += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+                am.ClearPrefetched();
+            }
+        }
+        am.UnInit();
+        ok = ok && bad == 0;
+        snprintf(line, sizeof(line), "%-6s %d scenes: no prefetch %.1f ms, prefetch %.1f ms (%zu reads)  bad data=%zu  %s\n",
+            layout.name, kScenes, total[0], total[1], reads, bad, bad ? "FAIL" : "PASS");
+        log += line;
+    }
+
+    // 先読みの待ち中に StopIOThreads で未着手のタスクを捨てても PrefetchAssets が戻ること。
+    // I/O スレッド 1 本でファイル毎のタスクを積み、積み終わる前後の色々な時点で止める
+    {
+        std::shared_ptr<AssetManager> am(new AssetManager, [](AssetManager* p) { delete p; }); // コンストラクタ / デストラクタは非公開
+        am->SetRoot(srcDir.string());
+        am->SetIOThreadCount(1);
+        int hung = 0;
+        for (int iter = 0; iter < 20 && hung == 0; ++iter) {
+            am->ClearRawCache();
+            auto finished = std::make_shared<std::atomic<bool>>(false);
+            std::thread th([am, finished, names] {
+                am->PrefetchAssets(names);
+                finished->store(true);
+            });
+            std::this_thread::sleep_for(std::chrono::microseconds(100 * iter));
+            am->StopIOThreads();
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (!finished->load() && std::chrono::steady_clock::now() < deadline)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            if (finished->load()) th.join();
+            else { th.detach(); ++hung; } // 戻らないスレッドが am を持ち続けるので解放しない
+        }
+        // 止めた後の先読みは I/O スレッドを起こし直して普通に終わる
+        bool restarted = false;
+        if (hung == 0) {
+            am->ClearRawCache();
+            restarted = am->PrefetchAssets(names).assets == names.size();
+            am->UnInit();
+        }
+        ok = ok && hung == 0 && restarted;
+        snprintf(line, sizeof(line), "StopIOThreads during prefetch: %s\n", hung ? "HANG" : restarted ? "PASS" : "FAIL (restart)");
+        log += line;
+    }
+
+    std::error_code ec;
+    fs::remove_all(work, ec);
+    return ok;
+}
+
+bool AssetManager::ZeroCopyBenchmark(const std::string& packerPath, std::string& log, uint64_t totalBytes) {
+    namespace fs = std::filesystem;
+    constexpr int kFiles = 64;
+    const size_t fileSize = (size_t)std::max<uint64_t>(totalBytes / kFiles, 4096);
+    char line[256];
+
+    // 元ファイルとアーカイブで totalBytes の 2 倍を書くので、一時フォルダの空きを先に確かめる
+    std::error_code ec;
+    const fs::space_info space = fs::space(fs::temp_directory_path(ec), ec);
+    if (!ec && space.available < (uint64_t)fileSize * kFiles * 2 + (64ull << 20)) {
+        snprintf(line, sizeof(line), "SKIP: temp has %.0f MB free, need %.0f MB\n",
+            space.available / (1024.0 * 1024.0), (double)fileSize * kFiles * 2 / (1024.0 * 1024.0));
+        log += line;
+        return false;
+    }
+    const fs::path work = MakeWorkDir("PixeonZeroCopyBench");
+    const fs::path srcDir = work / "src";
+
+    // 乱数の中身 (圧縮されずにそのまま格納される) を 1 ファイルずつ作って書く。
+    // 元データを持ったままだと計測に乗るので、照合用にはハッシュだけ残す
+    std::vector<std::string> names(kFiles);
+    std::vector<uint64_t> hashes(kFiles);
+    {
+        std::vector<uint8_t> data(fileSize);
+        uint64_t x = 0x9E3779B97F4A7C15ull;
+        for (int i = 0; i < kFiles; ++i) {
+            for (size_t j = 0; j + 8 <= data.size(); j += 8) {
+                x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+                memcpy(&data[j], &x, 8);
+            }
+            names[i] = "big/asset_" + std::to_string(i) + ".bin";
+            hashes[i] = HashUtil::Hash64(data.data(), data.size());
+            if (!WriteFileBytes(srcDir / names[i], data)) {
+                log += "FAIL: cannot write " + (srcDir / names[i]).string() + "\n";
+                fs::remove_all(work, ec);
+                return false;
+            }
+        }
+    }
+    const fs::path pak = work / "zerocopy.PixAssets";
+    if (!File::CallAssetPacker(packerPath, srcDir.string(), pak.string(), "--no-compress")) {
+        log += "FAIL: packer failed (" + packerPath + ")\n";
+        fs::remove_all(work, ec);
+        return false;
+    }
+    fs::remove_all(srcDir, ec);
+
+    // 全アセットを読んで持ったまま中身を使い (ハッシュで照合)、ファイル毎にメモリを測って最大の増分を採る。
+    // 各方式の前に OS のファイルキャッシュを捨てる
+    bool ok = true;
+    const char* modes[2] = { "LoadAsset (copy)", "AcquireAsset (view)" };
+    for (int mode = 0; mode < 2; ++mode) {
+        AssetManager am;
+        am.SetArchivePath(pak.string());
+        am.UnmountArchive();
+        HANDLE h = CreateFileA(pak.string().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_FLAG_NO_BUFFERING, nullptr);
+        if (h != INVALID_HANDLE_VALUE) CloseHandle(h);
+        am.SetLoadMode(LoadMode::FromArchive);
+        if (!am.IsArchiveMounted()) {
+            log += "FAIL: mount failed\n";
+            ok = false;
+            break;
+        }
+
+        const MemorySample base = SampleMemory();
+        MemorySample peak = base;
+        size_t bad = 0;
+        std::vector<std::vector<uint8_t>> copies;
+        std::vector<AssetView> views;
+        const auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < kFiles; ++i) {
+            const uint8_t* p = nullptr;
+            size_t size = 0;
+            if (mode == 0) {
+                copies.emplace_back();
+                if (am.LoadAsset(names[i], copies.back())) { p = copies.back().data(); size = copies.back().size(); }
+            }
+            else {
+                views.push_back(am.AcquireAsset(names[i]));
+                if (views.back()) { p = views.back().data(); size = views.back().size(); }
+            }
+            if (!p || size != fileSize || HashUtil::Hash64(p, size) != hashes[i]) ++bad;
+            const MemorySample now = SampleMemory();
+            peak.workingSet = std::max(peak.workingSet, now.workingSet);
+            peak.privateBytes = std::max(peak.privateBytes, now.privateBytes);
+        }
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        copies.clear();
+        views.clear();
+        am.UnInit();
+
+        ok = ok && bad == 0;
+        snprintf(line, sizeof(line), "%-20s %d x %.0f MB: %.1f ms (%.0f MB/s), peak working set +%.0f MB, private +%.0f MB  bad=%zu  %s\n",
+            modes[mode], kFiles, fileSize / (1024.0 * 1024.0), ms, (double)fileSize * kFiles / (1024.0 * 1024.0) / (ms / 1000.0),
+            (peak.workingSet - std::min(peak.workingSet, base.workingSet)) / (1024.0 * 1024.0),
+            (peak.privateBytes - std::min(peak.privateBytes, base.privateBytes)) / (1024.0 * 1024.0),
+            bad, bad ? "FAIL" : "PASS");
+        log += line;
+    }
+
+    fs::remove_all(work, ec);
+    return ok;
+}
+
+bool AssetManager::DirectReadBenchmark(const std::string& packerPath, std::string& log) {
+    namespace fs = std::filesystem;
+    constexpr int kSmall = 3000;       // 256B〜6KB
+    constexpr int kLarge = 16;         // 1MB〜8MB (PakArchive::kDirectReadMin 以上)
+    const fs::path work = MakeWorkDir("PixeonDirectReadBench");
+    const fs::path srcDir = work / "src";
+
+    // 半分は圧縮の効くテキスト、残りは乱数 (大きいものは 4 つに 1 つがテキスト)
+    std::mt19937 rng(31);
+    std::vector<std::string> names;
+    std::vector<uint64_t> hashes;
+    uint64_t largeBytes = 0;
+    for (int i = 0; i < kSmall + kLarge; ++i) {
+        const bool large = i >= kSmall;
+        const bool text = large ? (i % 4 == 0) : (i % 2 == 0);
+        std::vector<uint8_t> data(large ? (1u << 20) + rng() % (7u << 20) : 256 + rng() % 6000);
+        if (text) {
+            for (size_t j = 0; j < data.size(); ++j) data[j] = (uint8_t)"mesh 0.25 0.5 1.0 uv 0 1\n"[(j + i) % 25];
+        }
+        else {
+            for (auto& b : data) b = (uint8_t)rng();
+        }
+        names.push_back((large ? "large/stream_" : "small/item_") + std::to_string(i) + (text ? ".txt" : ".bin"));
+        hashes.push_back(HashUtil::Hash64(data.data(), data.size()));
+        if (large) largeBytes += data.size();
+        if (!WriteFileBytes(srcDir / names.back(), data)) {
+            log += "FAIL: cannot write " + (srcDir / names.back()).string() + "\n";
+            return false;
+        }
+    }
+
+    struct Layout { const char* name; const char* file; const char* args; };
+    const Layout layouts[] = {
+        { "align 4096", "plain", "4096" },
+        { "align 4096 + group", "grouped", "4096 --group-small 4096" },
+    };
+    const char* modes[3] = { "direct", "buffered", "mapped" };
+    bool ok = true;
+    char line[256];
+    for (const Layout& layout : layouts) {
+        const fs::path pak = work / (std::string(layout.file) + ".PixAssets");
+        if (!File::CallAssetPacker(packerPath, srcDir.string(), pak.string(), layout.args)) {
+            log += std::string("FAIL: ") + layout.name + ": packer failed (" + packerPath + ")\n";
+            ok = false;
+            continue;
+        }
+        for (int mode = 0; mode < 3; ++mode) {
+            // 開く前に非バッファリングで開き直してファイルのキャッシュを捨てる
+            HANDLE h = CreateFileA(pak.string().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                OPEN_EXISTING, FILE_FLAG_NO_BUFFERING, nullptr);
+            if (h != INVALID_HANDLE_VALUE) CloseHandle(h);
+            PakArchive archive;
+            if (!archive.Open(pak.string())) {
+                log += std::string("FAIL: ") + layout.name + ": open failed\n";
+                ok = false;
+                break;
+            }
+            archive.SetDirectReads(mode == 0);
+            if ((mode == 0 && !archive.HasDirectHandle()) || (mode == 2 && !archive.IsMapped())) {
+                snprintf(line, sizeof(line), "%-20s %-8s: SKIP (%s)\n", layout.name, modes[mode],
+                    mode == 0 ? "no unbuffered handle" : "not mapped");
+                log += line;
+                continue;
+            }
+
+            // パックと同じ名前順に読む。大きい / 小さいエントリの時間を分けて数える
+            double ms[2] = {};
+            size_t bad = 0;
+            std::vector<uint8_t> data, scratch;
+            for (size_t i = 0; i < names.size(); ++i) {
+                const auto t0 = std::chrono::steady_clock::now();
+                const uint8_t* p = nullptr;
+                size_t size = 0;
+                const PakArchive::Entry* entry = archive.Find(names[i]);
+                if (entry && mode == 2 && entry->compression == (uint8_t)AssetCompression::None) {
+                    p = archive.GetMappedData(*entry);
+                    size = (size_t)entry->originalSize;
+                }
+                else if (entry && mode == 2) {
+                    const uint8_t* stored = nullptr;
+                    if (archive.ReadRange(entry->offset, entry->storedSize, scratch, stored) && archive.Decode(*entry, stored, data)) {
+                        p = data.data();
+                        size = data.size();
+                    }
+                }
+                else if (entry && archive.Read(*entry, data)) {
+                    p = data.data();
+                    size = data.size();
+                }
+                // 中身を使う (マップしたページはここで読まれる)
+                if (!p || HashUtil::Hash64(p, size) != hashes[i]) ++bad;
+                ms[(int)i >= kSmall] += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            }
+            archive.Close();
+            ok = ok && bad == 0;
+            snprintf(line, sizeof(line), "%-20s %-8s: small %d %.1f ms, large %d %.1f ms (%.0f MB/s)  bad=%zu  %s\n",
+                layout.name, modes[mode], kSmall, ms[0], kLarge, ms[1],
+                ms[1] > 0.0 ? largeBytes / (1024.0 * 1024.0) / (ms[1] / 1000.0) : 0.0, bad, bad ? "FAIL" : "PASS");
+            log += line;
+        }
+    }
+
+    std::error_code ec;
+    fs::remove_all(work, ec);
+    return ok;
+}
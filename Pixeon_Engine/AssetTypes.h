@@ -6,6 +6,8 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <algorithm>
+#include <cstdint>
 #include <wrl/client.h>
 #include <d3d11.h>
 #include <DirectXMath.h>
@@ -27,6 +29,78 @@ struct SubMesh {
     bool     skinned = false; // XLL
     bool     hasUV = false; // UV`l
     bool     uvAllZero = false; // UVS(0,0)
+    uint32_t vertexOffset = 0;   // ̃TubVg_̐擪
+    uint32_t vertexCount = 0;   // _
+    float    posScale[3] = { 1,1,1 }; // ʎqʒűtʎq (ʒu = posBias + posScale * unorm16)
+    float    posBias[3] = { 0,0,0 };
+    // GPU ̃CfbNXobt@̔zu (IndexPack.h)BCfbNX baseVertex ̑Βl
+    uint32_t baseVertex = 0;   // DrawIndexed  BaseVertexLocation
+    uint32_t indexStart = 0;   // 擪 (index16 Ȃ uint16, łȂ uint32 ̗vfP)
+    bool     index16 = false;  // uint16 ̃CfbNX
+};
+
+// bVbg (MeshletBuilder.h)BCPU ł̃JO̒P
+struct Meshlet {
+    uint32_t vertexOffset = 0;   // MeshletData::vertices ̐擪
+    uint32_t triangleOffset = 0; // MeshletData::triangles ̐擪 (3  1 Op`)
+    uint32_t vertexCount = 0;
+    uint32_t triangleCount = 0;
+    uint32_t submesh = 0;
+    float    center[3] = { 0,0,0 }; // ދ (f)
+    float    radius = 0.0f;
+    float    coneApex[3] = { 0,0,0 }; // @̉~B_ dot(normalize(apex - _), axis) >= cutoff ȂSė
+    float    coneAxis[3] = { 0,0,0 };
+    float    coneCutoff = 1.0f;       // 1 ȏȂ痠͂Ȃ
+};
+
+struct MeshletData {
+    std::vector<Meshlet> meshlets;
+    std::vector<uint32_t> vertices; // f̒_ԍ (_obt@擪)
+    std::vector<uint8_t> triangles; // bVbg̒_ԍ * 3
+};
+
+// CfbNXobt@̌` (TubV uint16 / uint32 ꍇ Mixed)
+enum class IndexBufferFormat : uint8_t {
+    UInt32,
+    UInt16,
+    Mixed,
+};
+
+// l߂_̌` (VertexPack.h)BbaseStride  0 Ȃ ModelVertex ̂܂
+struct PackedVertexLayout {
+    uint32_t flags = 0;      // VertexPackFlags
+    uint32_t baseStride = 0; // Xg[ 0: ʒu / @ / ڐ / UV
+    uint32_t skinStride = 0; // Xg[ 1: {[ԍ / EFCg (XL 0)
+};
+
+// _Xg[
+enum VertexAttributeBits : uint32_t {
+    VertexAttr_Position = 1 << 0,
+    VertexAttr_Normal = 1 << 1,
+    VertexAttr_Tangent = 1 << 2,
+    VertexAttr_UV = 1 << 3,
+    VertexAttr_Skin = 1 << 4, // {[ԍ / EFCg
+};
+
+// `pXɕKvȑ (XLt̃f͎pX VertexAttr_Skin )
+constexpr uint32_t kVertexAttrMainPass = VertexAttr_Position | VertexAttr_Normal | VertexAttr_Tangent | VertexAttr_UV;
+constexpr uint32_t kVertexAttrDepthPass = VertexAttr_Position;
+
+// _Xg[̒g
+enum class VertexStreamKind : uint8_t {
+    Full,       // ModelVertex (88 oCg, S)
+    Packed,     // l߂_̈ʒu / @ / ڐ / UV (PackedVertexFloatPos / PackedVertexQuantPos)
+    Position,   // ʒu (float3 ܂ unorm16x4)
+    Attributes, // l߂_̖@ / ڐ / UV (12 oCg)
+    Skin,       // PackedSkin
+};
+
+// f̒_Xg[ 1 {B`摤͕Kvȑ𕢂Xg[Iő˂
+struct VertexStream {
+    Microsoft::WRL::ComPtr<ID3D11Buffer> buffer;
+    VertexStreamKind kind = VertexStreamKind::Full;
+    uint32_t attributes = 0; // VertexAttributeBits
+    uint32_t stride = 0;
 };
 
 // }eAʃf[^
@@ -60,16 +134,49 @@ struct AnimationClip {
 // fʃf[^
 struct ModelSharedResource {
     std::string source;
-    Microsoft::WRL::ComPtr<ID3D11Buffer> vb;
+    std::vector<VertexStream> streams; // _Xg[̕\ (SelectStreams őI)
     Microsoft::WRL::ComPtr<ID3D11Buffer> ib;
+    IndexBufferFormat indexFormat = IndexBufferFormat::UInt32;
+    size_t indexBytes = 0;
+    PackedVertexLayout vertexLayout;
     uint32_t vertexCount = 0;
     uint32_t indexCount = 0;
     std::vector<SubMesh> submeshes;
     std::vector<MaterialShared> materials;
     std::vector<Bone> bones;
     std::vector<AnimationClip> clips;
+    MeshletData meshlets; // CPU Ɏ (GPU ւ͑Ȃ)
     bool hasSkin = false;
     size_t gpuBytes = 0;
+
+    static constexpr uint32_t kMaxStreams = 4;
+
+    // attributes SĕXg[̑ĝA1 _̃oCgłȂ̂I
+    // (Ȃ{̏Ȃ)Bout փXg[ԍĖ{ԂBȂ 0
+    uint32_t SelectStreams(uint32_t attributes, uint32_t out[kMaxStreams]) const {
+        const uint32_t n = (uint32_t)std::min<size_t>(streams.size(), kMaxStreams);
+        uint32_t bestMask = 0, bestStride = UINT32_MAX, bestCount = 0;
+        for (uint32_t mask = 1; mask < (1u << n); ++mask) {
+            uint32_t covered = 0, stride = 0, count = 0;
+            for (uint32_t i = 0; i < n; ++i) {
+                if (!(mask & (1u << i))) continue;
+                covered |= streams[i].attributes;
+                stride += streams[i].stride;
+                count++;
+            }
+            if ((covered & attributes) != attributes) continue;
+            if (stride < bestStride || (stride == bestStride && count < bestCount)) {
+                bestMask = mask;
+                bestStride = stride;
+                bestCount = count;
+            }
+        }
+        uint32_t count = 0;
+        for (uint32_t i = 0; i < n; ++i) {
+            if (bestMask & (1u << i)) out[count++] = i;
+        }
+        return count;
+    }
 };
 
 // TEh\[X
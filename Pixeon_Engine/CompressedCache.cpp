@@ -0,0 +1,89 @@
+#include "CompressedCache.h"
+#include "LZ4Util.h"
+#include <cstring>
+
+std::shared_ptr<const CompressedCache::Blob> CompressedCache::Compress(const std::vector<uint8_t>& src) {
+    auto blob = std::make_shared<Blob>();
+    blob->originalSize = src.size();
+    if (!src.empty()) LZ4Util::CompressChunked(src.data(), src.size(), blob->data);
+    // 1/8 以上縮まないものは展開の手間だけ掛かるのでそのまま持つ
+    if (src.empty() || blob->data.size() > src.size() - src.size() / 8) {
+        blob->data = src;
+        blob->raw = true;
+    }
+    blob->data.shrink_to_fit();
+    return blob;
+}
+
+bool CompressedCache::Decompress(const Blob& blob, std::vector<uint8_t>& out) {
+    out.resize(blob.originalSize);
+    if (blob.raw) {
+        if (blob.originalSize) memcpy(out.data(), blob.data.data(), blob.originalSize);
+        return true;
+    }
+    return LZ4Util::DecompressChunked(blob.data.data(), blob.data.size(), out.data(), out.size());
+}
+
+void CompressedCache::SetBudget(size_t bytes) {
+    m_budget_ = bytes;
+    EvictOverBudget();
+}
+
+void CompressedCache::Put(const std::string& norm, std::shared_ptr<const Blob> blob) {
+    if (m_budget_ == 0 || blob->data.size() > m_budget_) return;
+    Erase(norm);
+    m_lru_.push_front(norm);
+    m_bytes_ += blob->data.size();
+    m_originalBytes_ += blob->originalSize;
+    m_entries_[norm] = Entry{ std::move(blob), m_lru_.begin() };
+    EvictOverBudget();
+}
+
+std::shared_ptr<const CompressedCache::Blob> CompressedCache::Find(const std::string& norm) {
+    auto it = m_entries_.find(norm);
+    if (it == m_entries_.end()) {
+        ++m_misses_;
+        return nullptr;
+    }
+    m_lru_.splice(m_lru_.begin(), m_lru_, it->second.lru);
+    ++m_hits_;
+    return it->second.blob;
+}
+
+void CompressedCache::Erase(const std::string& norm) {
+    auto it = m_entries_.find(norm);
+    if (it == m_entries_.end()) return;
+    m_bytes_ -= it->second.blob->data.size();
+    m_originalBytes_ -= it->second.blob->originalSize;
+    m_lru_.erase(it->second.lru);
+    m_entries_.erase(it);
+}
+
+void CompressedCache::Clear() {
+    m_entries_.clear();
+    m_lru_.clear();
+    m_bytes_ = 0;
+    m_originalBytes_ = 0;
+}
+
+// 展開中の Blob は呼び出し側が shared_ptr で持っているので、ここでは参照を気にせず捨てて良い
+void CompressedCache::EvictOverBudget() {
+    while (m_bytes_ > m_budget_ && !m_lru_.empty()) {
+        std::string victim = m_lru_.back();
+        Erase(victim);
+        ++m_evictions_;
+    }
+}
+
+CompressedCache::Stats CompressedCache::GetStats() const {
+    Stats st;
+    st.entries = m_entries_.size();
+    st.bytes = m_bytes_;
+    st.originalBytes = m_originalBytes_;
+    st.hits = m_hits_;
+    st.misses = m_misses_;
+    st.evictions = m_evictions_;
+    st.decodedBytes = m_decodedBytes_;
+    st.decodeNs = m_decodeNs_;
+    return st;
+}
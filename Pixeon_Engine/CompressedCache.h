@@ -0,0 +1,77 @@
+// CompressedCache
+// 生データキャッシュの 2 段目 (warm)。1 段目 (hot) から追い出したデータを LZ4 で圧縮したまま
+// メモリに置き、次に要求された時は展開して返す (ディスクから読み直すより速い)。
+// 排他は持たないので、呼び出し側のロックの中で使う。圧縮 / 展開は静的関数でロックの外で行う
+
+#ifndef COMPRESSEDCACHE_H
+#define COMPRESSEDCACHE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <list>
+#include <memory>
+#include "HashUtill.h"
+
+class CompressedCache
+{
+public:
+    // 圧縮済みデータ。縮まないデータ (圧縮済みの画像や音声など) は raw のまま持つ
+    struct Blob {
+        std::vector<uint8_t> data;
+        size_t originalSize = 0;
+        bool raw = false;
+    };
+
+    struct Stats {
+        size_t entries = 0;
+        size_t bytes = 0;          // 保持しているバイト数 (圧縮後)
+        size_t originalBytes = 0;  // 展開後のバイト数
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        uint64_t decodedBytes = 0; // Decompress で展開したバイト数
+        uint64_t decodeNs = 0;
+    };
+
+    static std::shared_ptr<const Blob> Compress(const std::vector<uint8_t>& src);
+    static bool Decompress(const Blob& blob, std::vector<uint8_t>& out);
+
+    // 上限 (バイト, 0 で無効: 何も保持しない)。超えた分は古い順に捨てる
+    void SetBudget(size_t bytes);
+    size_t GetBudget() const { return m_budget_; }
+
+    void Put(const std::string& norm, std::shared_ptr<const Blob> blob);
+    // 見つかれば最近使ったものとして扱う (hot へ上げても warm 側の複製は残す)
+    std::shared_ptr<const Blob> Find(const std::string& norm);
+    bool Contains(const std::string& norm) const { return m_entries_.find(norm) != m_entries_.end(); }
+    void Erase(const std::string& norm);
+    void Clear();
+    void AddDecodeTime(size_t bytes, uint64_t ns) { m_decodedBytes_ += bytes; m_decodeNs_ += ns; }
+
+    Stats GetStats() const;
+    template<class F> void ForEach(F&& f) const {
+        for (auto& kv : m_entries_) f(kv.first, *kv.second.blob);
+    }
+
+private:
+    void EvictOverBudget();
+
+    struct Entry {
+        std::shared_ptr<const Blob> blob;
+        std::list<std::string>::iterator lru;
+    };
+    HashUtil::StringMap<Entry> m_entries_;
+    std::list<std::string> m_lru_;
+    size_t m_bytes_ = 0;
+    size_t m_originalBytes_ = 0;
+    size_t m_budget_ = 128ull * 1024 * 1024;
+    uint64_t m_hits_ = 0;
+    uint64_t m_misses_ = 0;
+    uint64_t m_evictions_ = 0;
+    uint64_t m_decodedBytes_ = 0;
+    uint64_t m_decodeNs_ = 0;
+};
+
+#endif // COMPRESSEDCACHE_H
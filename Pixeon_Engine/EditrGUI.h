@@ -69,6 +69,8 @@ private:
 	ID3D11ShaderResourceView* archiveIcon;
 	ID3D11ShaderResourceView* ExeIcon;
 
+	std::string archiveSelfTestLog; // A[JCuEBhE̎Ȑff
+
 private:
 	static EditrGUI* instance;
 	Object* SelectedObject = nullptr;
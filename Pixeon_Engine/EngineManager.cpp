@@ -12,6 +12,8 @@
 #include "ShaderManager.h"
 #include "ComponentManager.h"
 #include "Object.h"
+#include <filesystem>
+#include <algorithm>
 
 EngineManager* EngineManager::instance_ = nullptr;
 
@@ -49,6 +51,19 @@ int EngineManager::Init(const EngineConfig& InPut){
 	SettingManager::GetInstance()->LoadConfig();
 	// AssetManager 
 	AssetManager::Instance()->SetRoot(SettingManager::GetInstance()->GetAssetsFilePath());
+	AssetManager::Instance()->SetArchivePath(SettingManager::GetInstance()->GetArchiveFilePath() + "/assets.PixAssets");
+	// pb` (assets.patchXXX.PixAssets) ͖Oɏd˂
+	{
+		std::vector<std::string> patches;
+		std::error_code ec;
+		for (auto& e : std::filesystem::directory_iterator(SettingManager::GetInstance()->GetArchiveFilePath(), ec)) {
+			std::string name = e.path().filename().string();
+			if (e.is_regular_file() && name.rfind("assets.patch", 0) == 0 && e.path().extension() == ".PixAssets")
+				patches.push_back(e.path().string());
+		}
+		std::sort(patches.begin(), patches.end());
+		for (auto& p : patches) AssetManager::Instance()->AddPatchArchive(p);
+	}
 	AssetManager::Instance()->SetLoadMode(AssetManager::LoadMode::FromSource);
 	AssetManager::Instance()->StartAutoSync(std::chrono::milliseconds(1000), true);
 	// GWp_[eNX`
@@ -30,8 +30,10 @@ std::string File::RemoveExeFromPath(const std::string& exePath){
 }
 
 // AZbgpbJ[Ăяo
-bool File::CallAssetPacker(const std::string& toolPath, const std::string& assetDir, const std::string& outputPak){
+bool File::CallAssetPacker(const std::string& toolPath, const std::string& assetDir, const std::string& outputPak,
+	const std::string& extraArgs){
 	std::string cmd = "\"" + toolPath + "\" \"" + assetDir + "\" \"" + outputPak + "\"";
+	if (!extraArgs.empty()) cmd += " " + extraArgs;
 	STARTUPINFOA si = { sizeof(si) };
 	PROCESS_INFORMATION pi;
 	BOOL result = CreateProcessA(
@@ -0,0 +1,114 @@
+#include "FileWatcher.h"
+#include <Windows.h>
+
+namespace {
+
+    class DirectoryChangeWatcher : public IFileWatchBackend
+    {
+    public:
+        ~DirectoryChangeWatcher() override { Stop(); }
+
+        const char* GetName() const override { return "ReadDirectoryChangesW"; }
+
+        bool Start(const std::string& root, bool recursive) override {
+            Stop();
+            m_dir_ = CreateFileA(root.c_str(), FILE_LIST_DIRECTORY,
+                FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+            if (m_dir_ == INVALID_HANDLE_VALUE) return false;
+            m_ov_.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+            m_wake_ = CreateEventA(nullptr, FALSE, FALSE, nullptr);
+            m_recursive_ = recursive;
+            m_buffer_.resize(64 * 1024 / sizeof(DWORD));
+            if (!m_ov_.hEvent || !m_wake_ || !IssueRead()) {
+                Stop();
+                return false;
+            }
+            return true;
+        }
+
+        void Stop() override {
+            if (m_dir_ != INVALID_HANDLE_VALUE) {
+                if (m_pending_) {
+                    CancelIoEx(m_dir_, &m_ov_);
+                    DWORD bytes = 0;
+                    GetOverlappedResult(m_dir_, &m_ov_, &bytes, TRUE);
+                    m_pending_ = false;
+                }
+                CloseHandle(m_dir_);
+                m_dir_ = INVALID_HANDLE_VALUE;
+            }
+            if (m_ov_.hEvent) { CloseHandle(m_ov_.hEvent); m_ov_.hEvent = nullptr; }
+            if (m_wake_) { CloseHandle(m_wake_); m_wake_ = nullptr; }
+        }
+
+        bool Wait(std::chrono::milliseconds timeout, std::vector<std::string>& changed, bool& needRescan) override {
+            if (m_dir_ == INVALID_HANDLE_VALUE) return false;
+            HANDLE handles[2] = { m_ov_.hEvent, m_wake_ };
+            DWORD r = WaitForMultipleObjects(2, handles, FALSE, (DWORD)timeout.count());
+            if (r != WAIT_OBJECT_0) return true; // タイムアウト / Wake
+
+            DWORD bytes = 0;
+            m_pending_ = false;
+            if (!GetOverlappedResult(m_dir_, &m_ov_, &bytes, FALSE)) return false;
+            if (bytes == 0) {
+                // 通知バッファが溢れた: 何が変わったか分からないので全体を走査し直してもらう
+                needRescan = true;
+            }
+            else {
+                Parse(bytes, changed);
+            }
+            return IssueRead();
+        }
+
+        void Wake() override {
+            if (m_wake_) SetEvent(m_wake_);
+        }
+
+    private:
+        bool IssueRead() {
+            ResetEvent(m_ov_.hEvent);
+            const DWORD filter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME |
+                FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE;
+            if (!ReadDirectoryChangesW(m_dir_, m_buffer_.data(), (DWORD)(m_buffer_.size() * sizeof(DWORD)),
+                m_recursive_ ? TRUE : FALSE, filter, nullptr, &m_ov_, nullptr)) {
+                return false;
+            }
+            m_pending_ = true;
+            return true;
+        }
+
+        void Parse(DWORD bytes, std::vector<std::string>& changed) {
+            const uint8_t* p = reinterpret_cast<const uint8_t*>(m_buffer_.data());
+            const uint8_t* end = p + bytes;
+            while (p < end) {
+                const FILE_NOTIFY_INFORMATION* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(p);
+                // CP932 の 2 バイト目が '\\' になり得るので区切り文字はワイド文字のうちに置き換える
+                std::wstring wname(info->FileName, info->FileNameLength / sizeof(wchar_t));
+                for (auto& c : wname) if (c == L'\\') c = L'/';
+                // AssetManager のキーは filesystem::path::generic_string() (ACP) なので同じコードページへ変換する
+                int len = WideCharToMultiByte(CP_ACP, 0, wname.data(), (int)wname.size(), nullptr, 0, nullptr, nullptr);
+                if (len > 0) {
+                    std::string name((size_t)len, '\0');
+                    WideCharToMultiByte(CP_ACP, 0, wname.data(), (int)wname.size(), name.data(), len, nullptr, nullptr);
+                    changed.push_back(std::move(name));
+                }
+                if (info->NextEntryOffset == 0) break;
+                p += info->NextEntryOffset;
+            }
+        }
+
+    private:
+        HANDLE m_dir_ = INVALID_HANDLE_VALUE;
+        HANDLE m_wake_ = nullptr;
+        OVERLAPPED m_ov_{};
+        bool m_pending_ = false;
+        bool m_recursive_ = true;
+        std::vector<DWORD> m_buffer_; // FILE_NOTIFY_INFORMATION は DWORD 境界が必要
+    };
+
+} // namespace
+
+std::unique_ptr<IFileWatchBackend> CreateNativeFileWatchBackend() {
+    return std::make_unique<DirectoryChangeWatcher>();
+}
@@ -0,0 +1,34 @@
+// FileWatcher
+// アセットフォルダの変更通知バックエンド。
+// AssetManager の監視スレッドは通知が来るまで Wait で眠り、通知が使えない環境ではポーリング走査に戻る
+
+#ifndef FILEWATCHER_H
+#define FILEWATCHER_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+
+class IFileWatchBackend
+{
+public:
+    virtual ~IFileWatchBackend() = default;
+
+    virtual const char* GetName() const = 0;
+    virtual bool Start(const std::string& root, bool recursive) = 0;
+    virtual void Stop() = 0;
+
+    // 変更が来るか timeout まで待つ。変更のあったパス (root からの相対, '/' 区切り) を changed に追加する。
+    // 通知を取りこぼした可能性がある場合 (バッファ溢れ等) は needRescan を true にする。
+    // バックエンドが使えなくなった場合は false
+    virtual bool Wait(std::chrono::milliseconds timeout, std::vector<std::string>& changed, bool& needRescan) = 0;
+
+    // 別スレッドから Wait を中断する
+    virtual void Wake() = 0;
+};
+
+// OS の変更通知 (ReadDirectoryChangesW) を使うバックエンドを作る
+std::unique_ptr<IFileWatchBackend> CreateNativeFileWatchBackend();
+
+#endif // FILEWATCHER_H
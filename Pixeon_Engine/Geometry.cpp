@@ -264,10 +264,11 @@ void Geometry::Draw()
 
         auto* sm = ShaderManager::GetInstance();
 
-        // VS  cbuffer ֏݁i˃x[X API zj
-        sm->SetCBufferVariable(ShaderStage::VS, _selectNowVS, "CameraCB", "world", &world, sizeof(world));
-        sm->SetCBufferVariable(ShaderStage::VS, _selectNowVS, "CameraCB", "view", &view, sizeof(view));
-        sm->SetCBufferVariable(ShaderStage::VS, _selectNowVS, "CameraCB", "proj", &proj, sizeof(proj));
+        // VS  cbuffer ֏݁i˃x[X API zjBO ID ̓RpCɋ߂Ă
+        constexpr ShaderManager::NameId kCameraCB = HashUtil::Hash64Const("CameraCB");
+        sm->SetCBufferVariable(ShaderStage::VS, _selectNowVS, kCameraCB, HashUtil::Hash64Const("world"), &world, sizeof(world));
+        sm->SetCBufferVariable(ShaderStage::VS, _selectNowVS, kCameraCB, HashUtil::Hash64Const("view"), &view, sizeof(view));
+        sm->SetCBufferVariable(ShaderStage::VS, _selectNowVS, kCameraCB, HashUtil::Hash64Const("proj"), &proj, sizeof(proj));
 
         // ύXGPUɔfoCh
         sm->CommitAndBind(ShaderStage::VS, _selectNowVS);
@@ -275,7 +276,8 @@ void Geometry::Draw()
 
     // PSMaterialCB(LineColor)Ώ
     {
-        ShaderManager::GetInstance()->SetCBufferVariable(ShaderStage::PS, _selectNowPS, "MaterialCB", "LineColor", &m_cubeColor, sizeof(m_cubeColor));
+        ShaderManager::GetInstance()->SetCBufferVariable(ShaderStage::PS, _selectNowPS,
+            HashUtil::Hash64Const("MaterialCB"), HashUtil::Hash64Const("LineColor"), &m_cubeColor, sizeof(m_cubeColor));
         ShaderManager::GetInstance()->CommitAndBind(ShaderStage::PS, _selectNowPS);
     }
 
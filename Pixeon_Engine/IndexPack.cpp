@@ -0,0 +1,251 @@
+#include "IndexPack.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+namespace {
+
+    // サブメッシュの詰めたインデックスがバッファに収まっているか
+    bool InBounds(const SubMesh& sm, size_t size) {
+        const size_t elem = sm.index16 ? sizeof(uint16_t) : sizeof(uint32_t);
+        return ((uint64_t)sm.indexStart + sm.indexCount) * elem <= size;
+    }
+
+    uint32_t ReadIndex(const uint8_t* data, const SubMesh& sm, uint32_t i) {
+        if (sm.index16) {
+            uint16_t v;
+            memcpy(&v, data + ((size_t)sm.indexStart + i) * sizeof(uint16_t), sizeof(v));
+            return v;
+        }
+        uint32_t v;
+        memcpy(&v, data + ((size_t)sm.indexStart + i) * sizeof(uint32_t), sizeof(v));
+        return v;
+    }
+
+} // namespace
+
+namespace IndexPack {
+
+    bool Pack(const uint32_t* indices, uint32_t indexCount, std::vector<SubMesh>& submeshes, bool allow16,
+        std::vector<uint8_t>& out, IndexBufferFormat& format, std::string& error) {
+
+        std::vector<SubMesh> packed = submeshes;
+        size_t total = 0;
+        uint32_t count16 = 0;
+        for (SubMesh& sm : packed) {
+            if ((uint64_t)sm.indexOffset + sm.indexCount > indexCount) {
+                error = "submesh index range out of bounds";
+                return false;
+            }
+            uint32_t lo = UINT32_MAX, hi = 0;
+            for (uint32_t i = 0; i < sm.indexCount; ++i) {
+                lo = std::min(lo, indices[sm.indexOffset + i]);
+                hi = std::max(hi, indices[sm.indexOffset + i]);
+            }
+            if (sm.indexCount == 0) lo = hi = 0;
+            if (lo > (uint32_t)INT32_MAX) {
+                error = "base vertex exceeds INT_MAX";
+                return false;
+            }
+            sm.baseVertex = lo;
+            sm.index16 = allow16 && hi - lo < kMaxRange16;
+            // 先頭は 4 バイト境界
+            total = (total + 3) & ~(size_t)3;
+            const size_t elem = sm.index16 ? sizeof(uint16_t) : sizeof(uint32_t);
+            sm.indexStart = (uint32_t)(total / elem);
+            total += (size_t)sm.indexCount * elem;
+            if (sm.index16) count16++;
+        }
+
+        out.assign((total + 3) & ~(size_t)3, 0);
+        for (const SubMesh& sm : packed) {
+            const uint32_t* src = indices + sm.indexOffset;
+            if (sm.index16) {
+                uint16_t* dst = reinterpret_cast<uint16_t*>(out.data()) + sm.indexStart;
+                for (uint32_t i = 0; i < sm.indexCount; ++i) dst[i] = (uint16_t)(src[i] - sm.baseVertex);
+            }
+            else {
+                uint32_t* dst = reinterpret_cast<uint32_t*>(out.data()) + sm.indexStart;
+                for (uint32_t i = 0; i < sm.indexCount; ++i) dst[i] = src[i] - sm.baseVertex;
+            }
+        }
+
+        if (count16 == 0) format = IndexBufferFormat::UInt32;
+        else if (count16 == packed.size()) format = IndexBufferFormat::UInt16;
+        else format = IndexBufferFormat::Mixed;
+        submeshes = std::move(packed);
+        return true;
+    }
+
+    void Unpack(const uint8_t* data, size_t size, const std::vector<SubMesh>& submeshes, std::vector<uint32_t>& out) {
+        size_t count = 0;
+        for (const SubMesh& sm : submeshes) count = std::max(count, (size_t)sm.indexOffset + sm.indexCount);
+        out.assign(count, 0);
+        for (const SubMesh& sm : submeshes) {
+            if (!InBounds(sm, size)) continue;
+            for (uint32_t i = 0; i < sm.indexCount; ++i) {
+                out[sm.indexOffset + i] = ReadIndex(data, sm, i) + sm.baseVertex;
+            }
+        }
+    }
+
+    bool CheckLayout(const std::vector<SubMesh>& submeshes, size_t size) {
+        for (const SubMesh& sm : submeshes) {
+            if (!InBounds(sm, size)) return false;
+            if (sm.index16 && (sm.indexStart * sizeof(uint16_t)) % 4 != 0) return false;
+        }
+        return true;
+    }
+
+    void Describe(uint32_t indexCount, const std::vector<SubMesh>& submeshes, size_t packedBytes,
+        IndexBufferFormat format, IndexPackReport& report) {
+        report = IndexPackReport{};
+        report.submeshCount = (uint32_t)submeshes.size();
+        report.fullBytes = (size_t)indexCount * sizeof(uint32_t);
+        report.packedBytes = packedBytes;
+        report.format = format;
+        for (const SubMesh& sm : submeshes) {
+            if (sm.index16) report.submesh16Count++;
+            report.triangleCount += sm.indexCount / 3;
+        }
+    }
+
+    bool Validate(const uint32_t* original, uint32_t indexCount, const std::vector<SubMesh>& submeshes,
+        const std::vector<uint8_t>& packed, IndexBufferFormat format, IndexPackReport& report) {
+
+        report = IndexPackReport{};
+        report.validated = true;
+        report.submeshCount = (uint32_t)submeshes.size();
+        report.fullBytes = (size_t)indexCount * sizeof(uint32_t);
+        report.packedBytes = packed.size();
+        report.format = format;
+        auto fail = [&](const std::string& what) {
+            if (report.passed) report.failure = what;
+            report.passed = false;
+        };
+
+        std::vector<uint32_t> expanded;
+        Unpack(packed.data(), packed.size(), submeshes, expanded);
+        uint32_t count16 = 0;
+        for (size_t s = 0; s < submeshes.size(); ++s) {
+            const SubMesh& sm = submeshes[s];
+            if (sm.index16) {
+                count16++;
+                if ((sm.indexStart * sizeof(uint16_t)) % 4 != 0) fail("submesh " + std::to_string(s) + " not 4-byte aligned");
+            }
+            if ((uint64_t)sm.indexOffset + sm.indexCount > indexCount || !InBounds(sm, packed.size())) {
+                fail("submesh " + std::to_string(s) + " out of bounds");
+                continue;
+            }
+            for (uint32_t i = 0; i < sm.indexCount; ++i) {
+                if (sm.index16 && ReadIndex(packed.data(), sm, i) >= kMaxRange16) {
+                    fail("submesh " + std::to_string(s) + " uses 0xFFFF");
+                    break;
+                }
+            }
+            // 三角形単位で比べる
+            for (uint32_t t = 0; t + 2 < sm.indexCount; t += 3) {
+                report.triangleCount++;
+                const uint32_t at = sm.indexOffset + t;
+                if (expanded[at] != original[at] || expanded[at + 1] != original[at + 1] || expanded[at + 2] != original[at + 2]) {
+                    if (report.mismatchedTriangles++ == 0) {
+                        fail("submesh " + std::to_string(s) + " triangle " + std::to_string(t / 3) + " differs");
+                    }
+                }
+            }
+        }
+        report.submesh16Count = count16;
+        return report.passed;
+    }
+
+    bool SelfTest(std::string& log) {
+        std::mt19937 rng(2024);
+        struct Case { const char* name; uint32_t base; uint32_t range; uint32_t indexCount; };
+        // range は最大 - 最小 (0 なら全て同じ頂点)
+        const Case cases[] = {
+            { "small",              0,      300,    900 },
+            { "far base",           100000, 1000,   3000 },
+            { "range 0xFFFE",       5,      0xFFFE, 6000 },
+            { "range 0xFFFF (u32)", 7,      0xFFFF, 6000 },
+            { "odd u16 count",      70000,  50,     5 },
+            { "empty",              0,      0,      0 },
+            { "large (u32)",        1,      500000, 9000 },
+            { "after u32",          200000, 20,     30 },
+        };
+
+        std::vector<uint32_t> indices;
+        std::vector<SubMesh> submeshes;
+        for (const Case& c : cases) {
+            SubMesh sm;
+            sm.indexOffset = (uint32_t)indices.size();
+            sm.indexCount = c.indexCount;
+            for (uint32_t i = 0; i < c.indexCount; ++i) {
+                // 最小 / 最大を必ず含める
+                uint32_t v = i == 0 ? 0 : i == 1 ? c.range : (uint32_t)(rng() % ((uint64_t)c.range + 1));
+                indices.push_back(c.base + v);
+            }
+            submeshes.push_back(sm);
+        }
+        // どのサブメッシュにも属さないインデックス (描かれないので詰めない)
+        indices.push_back(123);
+
+        bool ok = true;
+        char line[256];
+        for (int allow16 = 1; allow16 >= 0; --allow16) {
+            std::vector<SubMesh> sms = submeshes;
+            std::vector<uint8_t> packed;
+            IndexBufferFormat format;
+            std::string error;
+            IndexPackReport r;
+            bool packedOk = Pack(indices.data(), (uint32_t)indices.size(), sms, allow16 != 0, packed, format, error);
+            bool valid = packedOk && Validate(indices.data(), (uint32_t)indices.size(), sms, packed, format, r);
+            // u16 を許した時は範囲 0xFFFF 以上のサブメッシュだけが u32 になるはず
+            bool formats = packedOk;
+            for (size_t s = 0; packedOk && s < sms.size(); ++s) {
+                const bool expect16 = allow16 && cases[s].range < kMaxRange16;
+                if (sms[s].index16 != expect16 || sms[s].baseVertex != (cases[s].indexCount ? cases[s].base : 0)) formats = false;
+            }
+            ok = ok && valid && formats;
+            snprintf(line, sizeof(line), "allow16=%d %-6s %u/%u u16  %.1f KB -> %.1f KB  tris=%u  %s%s %s\n",
+                allow16, FormatName(format), r.submesh16Count, r.submeshCount,
+                r.fullBytes / 1024.0, r.packedBytes / 1024.0, r.triangleCount,
+                valid ? "PASS" : "FAIL", formats ? "" : " (format choice)",
+                packedOk ? r.failure.c_str() : error.c_str());
+            log += line;
+
+            // 1 つ書き換えたら Validate が見つけること
+            if (packedOk && !packed.empty()) {
+                std::vector<uint8_t> broken = packed;
+                broken[sms[1].indexStart * (sms[1].index16 ? 2 : 4)] ^= 1;
+                IndexPackReport br;
+                bool detected = !Validate(indices.data(), (uint32_t)indices.size(), sms, broken, format, br) && br.mismatchedTriangles == 1;
+                ok = ok && detected;
+                snprintf(line, sizeof(line), "allow16=%d corrupted index detected: %s\n", allow16, detected ? "PASS" : "FAIL");
+                log += line;
+            }
+        }
+
+        // 範囲外を指すサブメッシュは詰めない
+        {
+            std::vector<SubMesh> sms = submeshes;
+            sms.back().indexCount = (uint32_t)indices.size();
+            std::vector<uint8_t> packed;
+            IndexBufferFormat format;
+            std::string error;
+            bool rejected = !Pack(indices.data(), (uint32_t)indices.size(), sms, true, packed, format, error);
+            ok = ok && rejected;
+            log += std::string("out of range submesh rejected: ") + (rejected ? "PASS" : "FAIL") + "\n";
+        }
+        return ok;
+    }
+
+    const char* FormatName(IndexBufferFormat format) {
+        switch (format) {
+        case IndexBufferFormat::UInt16: return "u16";
+        case IndexBufferFormat::Mixed:  return "mixed";
+        default:                        return "u32";
+        }
+    }
+
+} // namespace IndexPack
@@ -0,0 +1,74 @@
+// IndexPack
+// モデルのインデックス (uint32, 頂点バッファ先頭からの番号) をサブメッシュ毎に
+// そのサブメッシュが使う最小の頂点番号 (SubMesh::baseVertex) からの相対値へ直し、
+// 範囲が 0xFFFF 未満なら uint16 で持つ。1 本のインデックスバッファに uint16 / uint32 のサブメッシュが混ざる。
+//   サブメッシュの先頭は 4 バイト境界に揃える (どちらの形式でも StartIndexLocation で指せるように)
+//   0xFFFF はストリップの切れ目と同じ値なので使わない
+// 描画は IASetIndexBuffer をサブメッシュの形式で切り替え、
+// DrawIndexed(indexCount, SubMesh::indexStart, SubMesh::baseVertex) で行う
+
+#ifndef INDEXPACK_H
+#define INDEXPACK_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "AssetTypes.h"
+
+// 詰めたインデックスを戻して元の三角形と比べた結果 (Validate)
+struct IndexPackReport {
+    uint32_t submeshCount = 0;
+    uint32_t submesh16Count = 0;        // uint16 になったサブメッシュ
+    uint32_t triangleCount = 0;
+    uint32_t mismatchedTriangles = 0;
+    size_t fullBytes = 0;               // uint32 のままのインデックスバッファ
+    size_t packedBytes = 0;
+    IndexBufferFormat format = IndexBufferFormat::UInt32;
+    bool validated = false;             // Validate を通した (読み込み時は詰めるだけで、検証は調理 / レポートで行う)
+    bool passed = true;
+    std::string failure;
+};
+
+// GPU へ渡すインデックスバッファ (Pack の出力、または .pixmesh の PackedIndices) を指すビュー。
+// サブメッシュの baseVertex / indexStart / index16 はこの配置に合わせてあること
+struct PackedIndexView {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    IndexBufferFormat format = IndexBufferFormat::UInt32;
+};
+
+namespace IndexPack {
+
+    // uint16 で持てるサブメッシュの頂点範囲 (最大 - 最小) の上限 (これ未満)
+    constexpr uint32_t kMaxRange16 = 0xFFFF;
+
+    // indices のうちサブメッシュが指す部分を詰めて out へ書く。
+    // 成功時だけ submeshes の baseVertex / indexStart / index16 を書き換える。
+    // allow16 が false なら全サブメッシュ uint32 (相対値にはする)。
+    // サブメッシュがインデックスの範囲外を指していれば false
+    bool Pack(const uint32_t* indices, uint32_t indexCount, std::vector<SubMesh>& submeshes, bool allow16,
+        std::vector<uint8_t>& out, IndexBufferFormat& format, std::string& error);
+
+    // 詰めたインデックスを元の並び (SubMesh::indexOffset の位置, 頂点バッファ先頭からの番号) へ戻す
+    void Unpack(const uint8_t* data, size_t size, const std::vector<SubMesh>& submeshes, std::vector<uint32_t>& out);
+
+    // 配置が size バイトに収まり、uint16 のサブメッシュが 4 バイト境界から始まっているか (中身は見ない)
+    bool CheckLayout(const std::vector<SubMesh>& submeshes, size_t size);
+
+    // 検証せずに配置だけから report を埋める (validated = false)
+    void Describe(uint32_t indexCount, const std::vector<SubMesh>& submeshes, size_t packedBytes,
+        IndexBufferFormat format, IndexPackReport& report);
+
+    // 詰めたインデックスを戻し、元のインデックスと三角形単位で比べる。全て一致すれば true
+    bool Validate(const uint32_t* original, uint32_t indexCount, const std::vector<SubMesh>& submeshes,
+        const std::vector<uint8_t>& packed, IndexBufferFormat format, IndexPackReport& report);
+
+    // 境界 (範囲 0xFFFE / 0xFFFF, 離れた位置のサブメッシュ, 奇数個の uint16, 空のサブメッシュ) と
+    // 乱数のインデックスで Pack → Validate し、壊したデータを Validate が見つけるかも確かめる。結果を log へ書く
+    bool SelfTest(std::string& log);
+
+    const char* FormatName(IndexBufferFormat format);
+
+} // namespace IndexPack
+
+#endif // INDEXPACK_H
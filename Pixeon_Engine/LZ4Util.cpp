@@ -0,0 +1,268 @@
+#include "LZ4Util.h"
+#include "ArchiveFormat.h"
+#include <cstring>
+
+namespace LZ4Util {
+
+    static const size_t kMinMatch = 4;
+    static const size_t kLastLiterals = 5;   // 末尾 5 バイトは必ずリテラル
+    static const size_t kMFLimit = 12;       // マッチ開始は末尾 12 バイトより前
+    static const size_t kMaxDistance = 65535;
+    static const int    kHashLog = 16;
+
+    static inline uint32_t Read32(const uint8_t* p) {
+        uint32_t v;
+        memcpy(&v, p, 4);
+        return v;
+    }
+    static inline uint32_t Hash(uint32_t v) {
+        return (v * 2654435761u) >> (32 - kHashLog);
+    }
+    static inline void WriteLength(uint8_t*& op, size_t len) {
+        while (len >= 255) { *op++ = 255; len -= 255; }
+        *op++ = (uint8_t)len;
+    }
+
+    // base[0, prefixLen) は参照だけに使う既出データ (辞書)、base[prefixLen, prefixLen + srcLen) を圧縮する。
+    // table は prefix 部分を登録済みの状態で渡す
+    static size_t CompressImpl(const uint8_t* base, size_t prefixLen, size_t srcLen,
+        uint8_t* dst, size_t dstCap, std::vector<uint32_t>& table) {
+        const uint8_t* const src = base + prefixLen;
+        const uint8_t* ip = src;
+        const uint8_t* anchor = src;
+        const uint8_t* const iend = src + srcLen;
+        uint8_t* op = dst;
+        uint8_t* const oend = dst + dstCap;
+
+        if (srcLen >= kMFLimit + 1) {
+            const uint8_t* const mflimit = iend - kMFLimit;
+            const uint8_t* const matchlimit = iend - kLastLiterals;
+            while (ip <= mflimit) {
+                uint32_t seq = Read32(ip);
+                uint32_t h = Hash(seq);
+                uint32_t ref = table[h];
+                table[h] = (uint32_t)(ip - base) + 1;
+                if (ref == 0) { ++ip; continue; }
+                const uint8_t* match = base + (ref - 1);
+                if ((size_t)(ip - match) > kMaxDistance || Read32(match) != seq) { ++ip; continue; }
+
+                // 後方へ伸ばす
+                while (ip > anchor && match > base && ip[-1] == match[-1]) { --ip; --match; }
+                // 前方へ伸ばす
+                const uint8_t* p = ip + kMinMatch;
+                const uint8_t* m = match + kMinMatch;
+                while (p < matchlimit && *p == *m) { ++p; ++m; }
+
+                size_t litLen = (size_t)(ip - anchor);
+                size_t matchLen = (size_t)(p - ip);
+                if ((size_t)(oend - op) < 1 + litLen / 255 + 1 + litLen + 2 + matchLen / 255 + 1) return 0;
+
+                uint8_t* token = op++;
+                if (litLen >= 15) { *token = 15 << 4; WriteLength(op, litLen - 15); }
+                else *token = (uint8_t)(litLen << 4);
+                memcpy(op, anchor, litLen);
+                op += litLen;
+
+                uint16_t offset = (uint16_t)(ip - match);
+                *op++ = (uint8_t)(offset & 0xFF);
+                *op++ = (uint8_t)(offset >> 8);
+
+                size_t ml = matchLen - kMinMatch;
+                if (ml >= 15) { *token |= 15; WriteLength(op, ml - 15); }
+                else *token |= (uint8_t)ml;
+
+                ip = p;
+                anchor = ip;
+                if (ip <= mflimit)
+                    table[Hash(Read32(ip - 2))] = (uint32_t)(ip - 2 - base) + 1;
+            }
+        }
+
+        // 残りはリテラルとして出力
+        size_t litLen = (size_t)(iend - anchor);
+        if ((size_t)(oend - op) < 1 + litLen / 255 + 1 + litLen) return 0;
+        uint8_t* token = op++;
+        if (litLen >= 15) { *token = 15 << 4; WriteLength(op, litLen - 15); }
+        else *token = (uint8_t)(litLen << 4);
+        memcpy(op, anchor, litLen);
+        op += litLen;
+        return (size_t)(op - dst);
+    }
+
+    size_t CompressBlock(const uint8_t* src, size_t srcLen, uint8_t* dst, size_t dstCap) {
+        // 位置 + 1 を保持 (0 は未登録)。スレッドごとに使い回す
+        thread_local std::vector<uint32_t> table;
+        table.assign((size_t)1 << kHashLog, 0);
+        return CompressImpl(src, 0, srcLen, dst, dstCap, table);
+    }
+
+    size_t CompressBlockDict(const uint8_t* dict, size_t dictLen, const uint8_t* src, size_t srcLen,
+        uint8_t* dst, size_t dstCap) {
+        if (dictLen > kLZ4DictMaxSize) {
+            dict += dictLen - kLZ4DictMaxSize;
+            dictLen = kLZ4DictMaxSize;
+        }
+        // 辞書を登録したテーブルは同じ辞書が続く間使い回す (小さいファイルでは毎回の登録の方が重い)
+        thread_local std::vector<uint32_t> dictTable;
+        thread_local const uint8_t* dictKey = nullptr;
+        thread_local size_t dictKeyLen = 0;
+        if (dictKey != dict || dictKeyLen != dictLen || dictTable.empty()) {
+            dictTable.assign((size_t)1 << kHashLog, 0);
+            for (size_t p = 0; p + kMinMatch <= dictLen; ++p)
+                dictTable[Hash(Read32(dict + p))] = (uint32_t)p + 1;
+            dictKey = dict;
+            dictKeyLen = dictLen;
+        }
+        thread_local std::vector<uint32_t> table;
+        table = dictTable;
+        // 辞書と src を連続した領域に並べ、辞書を src の直前のデータとして扱う
+        thread_local std::vector<uint8_t> joined;
+        joined.resize(dictLen + srcLen);
+        if (dictLen) memcpy(joined.data(), dict, dictLen);
+        if (srcLen) memcpy(joined.data() + dictLen, src, srcLen);
+        return CompressImpl(joined.data(), dictLen, srcLen, dst, dstCap, table);
+    }
+
+    // dict は dst の直前にあるものとして扱う (dictLen == 0 なら通常の展開)
+    static bool DecompressImpl(const uint8_t* dict, size_t dictLen,
+        const uint8_t* src, size_t srcLen, uint8_t* dst, size_t dstLen) {
+        const uint8_t* ip = src;
+        const uint8_t* const iend = src + srcLen;
+        uint8_t* op = dst;
+        uint8_t* const oend = dst + dstLen;
+
+        while (ip < iend) {
+            uint8_t token = *ip++;
+
+            size_t litLen = token >> 4;
+            if (litLen == 15) {
+                uint8_t b;
+                do {
+                    if (ip >= iend) return false;
+                    b = *ip++;
+                    litLen += b;
+                } while (b == 255);
+            }
+            if (litLen > (size_t)(iend - ip) || litLen > (size_t)(oend - op)) return false;
+            memcpy(op, ip, litLen);
+            ip += litLen;
+            op += litLen;
+            if (ip == iend) break; // 最終シーケンスはリテラルのみ
+
+            if (iend - ip < 2) return false;
+            size_t offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+            ip += 2;
+            if (offset == 0 || offset > (size_t)(op - dst) + dictLen) return false;
+
+            size_t matchLen = token & 15;
+            if (matchLen == 15) {
+                uint8_t b;
+                do {
+                    if (ip >= iend) return false;
+                    b = *ip++;
+                    matchLen += b;
+                } while (b == 255);
+            }
+            matchLen += kMinMatch;
+            if (matchLen > (size_t)(oend - op)) return false;
+
+            if (offset > (size_t)(op - dst)) {
+                // 辞書から始まるマッチ。辞書の末尾までをコピーし、残りは dst の先頭から続ける
+                size_t back = offset - (size_t)(op - dst);
+                const uint8_t* match = dict + dictLen - back;
+                size_t n = back < matchLen ? back : matchLen;
+                memcpy(op, match, n);
+                op += n;
+                matchLen -= n;
+                if (matchLen == 0) continue;
+            }
+            const uint8_t* match = op - offset;
+            if (offset >= matchLen) {
+                memcpy(op, match, matchLen);
+                op += matchLen;
+            }
+            else {
+                // 重なりのあるコピーは 1 バイトずつ
+                for (size_t i = 0; i < matchLen; ++i) *op++ = *match++;
+            }
+        }
+        return op == oend;
+    }
+
+    bool DecompressBlock(const uint8_t* src, size_t srcLen, uint8_t* dst, size_t dstLen) {
+        return DecompressImpl(nullptr, 0, src, srcLen, dst, dstLen);
+    }
+
+    bool DecompressBlockDict(const uint8_t* dict, size_t dictLen, const uint8_t* src, size_t srcLen,
+        uint8_t* dst, size_t dstLen) {
+        if (dictLen > kLZ4DictMaxSize) {
+            dict += dictLen - kLZ4DictMaxSize;
+            dictLen = kLZ4DictMaxSize;
+        }
+        return DecompressImpl(dict, dictLen, src, srcLen, dst, dstLen);
+    }
+
+    void CompressChunked(const uint8_t* src, size_t srcLen, std::vector<uint8_t>& out) {
+        out.clear();
+        out.reserve(srcLen + (srcLen / kLZ4ChunkSize + 1) * 4);
+        std::vector<uint8_t> block(CompressBound(kLZ4ChunkSize));
+        size_t pos = 0;
+        while (pos < srcLen) {
+            size_t n = srcLen - pos;
+            if (n > kLZ4ChunkSize) n = kLZ4ChunkSize;
+            size_t c = CompressBlock(src + pos, n, block.data(), block.size());
+            uint32_t header;
+            const uint8_t* payload;
+            size_t payloadLen;
+            if (c == 0 || c >= n) {
+                header = (uint32_t)n | kLZ4ChunkRawFlag;
+                payload = src + pos;
+                payloadLen = n;
+            }
+            else {
+                header = (uint32_t)c;
+                payload = block.data();
+                payloadLen = c;
+            }
+            size_t at = out.size();
+            out.resize(at + 4 + payloadLen);
+            memcpy(out.data() + at, &header, 4);
+            memcpy(out.data() + at + 4, payload, payloadLen);
+            pos += n;
+        }
+    }
+
+    bool DecompressChunkedPartial(const uint8_t* src, size_t srcLen,
+        uint8_t* dst, size_t dstLen, size_t& consumed, size_t& produced) {
+        consumed = 0;
+        produced = 0;
+        while (produced < dstLen) {
+            if (srcLen - consumed < 4) return true;
+            uint32_t header;
+            memcpy(&header, src + consumed, 4);
+            size_t len = header & ~kLZ4ChunkRawFlag;
+            if (srcLen - consumed - 4 < len) return true; // チャンク途中: 続きを待つ
+
+            size_t expect = dstLen - produced;
+            if (expect > kLZ4ChunkSize) expect = kLZ4ChunkSize;
+            const uint8_t* payload = src + consumed + 4;
+            if (header & kLZ4ChunkRawFlag) {
+                if (len != expect) return false;
+                memcpy(dst + produced, payload, len);
+            }
+            else if (!DecompressBlock(payload, len, dst + produced, expect)) {
+                return false;
+            }
+            consumed += 4 + len;
+            produced += expect;
+        }
+        return true;
+    }
+
+    bool DecompressChunked(const uint8_t* src, size_t srcLen, uint8_t* dst, size_t dstLen) {
+        size_t consumed = 0, produced = 0;
+        if (!DecompressChunkedPartial(src, srcLen, dst, dstLen, consumed, produced)) return false;
+        return consumed == srcLen && produced == dstLen;
+    }
+
+} // namespace LZ4Util
@@ -0,0 +1,60 @@
+#include "LoadTrace.h"
+#include "ErrorLog.h"
+#include <fstream>
+
+void LoadTrace::Start(const std::string& sceneName) {
+    std::lock_guard<std::mutex> lk(m_mtx_);
+    m_sections_.clear();
+    m_sections_.push_back(Section{ sceneName });
+    m_count_ = 0;
+    m_active_ = true;
+}
+
+void LoadTrace::MarkScene(const std::string& sceneName) {
+    if (!IsActive()) return;
+    std::lock_guard<std::mutex> lk(m_mtx_);
+    // 何も読まなかった区切りは残さない
+    if (!m_sections_.empty() && m_sections_.back().names.empty()) m_sections_.pop_back();
+    m_sections_.push_back(Section{ sceneName });
+}
+
+void LoadTrace::Record(const std::string& logicalName) {
+    if (!IsActive()) return;
+    std::lock_guard<std::mutex> lk(m_mtx_);
+    if (m_sections_.empty()) return;
+    Section& s = m_sections_.back();
+    if (!s.seen.emplace(logicalName, true).second) return;
+    s.names.push_back(logicalName);
+    ++m_count_;
+}
+
+bool LoadTrace::StopAndSave(const std::string& path) {
+    std::vector<Section> sections;
+    {
+        std::lock_guard<std::mutex> lk(m_mtx_);
+        m_active_ = false;
+        sections = std::move(m_sections_);
+        m_sections_.clear();
+    }
+    std::ofstream ofs(path, std::ios::binary);
+    if (!ofs) {
+        ErrorLogger::Instance().LogError("LoadTrace", "Cannot open trace file: " + path);
+        return false;
+    }
+    ofs << "# PIXTRACE 1\n";
+    for (const auto& s : sections) {
+        if (s.names.empty()) continue;
+        ofs << "@scene " << s.scene << "\n";
+        for (const auto& n : s.names) ofs << n << "\n";
+    }
+    if (!ofs) {
+        ErrorLogger::Instance().LogError("LoadTrace", "Failed to write trace file: " + path);
+        return false;
+    }
+    return true;
+}
+
+size_t LoadTrace::GetRecordCount() const {
+    std::lock_guard<std::mutex> lk(m_mtx_);
+    return m_count_;
+}
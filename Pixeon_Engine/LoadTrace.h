@@ -0,0 +1,45 @@
+// LoadTrace
+// アセットの読み込み順をシーン毎に記録する。パッカーの --trace に渡すと
+// シーン毎に初回使用順でまとめて配置したアーカイブを作れる (シーク回数を減らす)
+//
+// ファイル形式 (UTF-8 テキスト, 1 行 1 項目):
+//   # PIXTRACE 1          先頭行
+//   @scene <シーン名>      以降の行はこのシーンで初めて要求されたアセット
+//   <論理パス>             '/' 区切り。同じシーン内での 2 回目以降は記録しない
+
+#ifndef LOADTRACE_H
+#define LOADTRACE_H
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include "HashUtill.h"
+
+class LoadTrace
+{
+public:
+    // 記録を始める (記録済みの内容は捨てる)。最初の区切りは sceneName
+    void Start(const std::string& sceneName = "(startup)");
+    // 以降の記録を sceneName の区切りに入れる
+    void MarkScene(const std::string& sceneName);
+    void Record(const std::string& logicalName);
+    // 記録を止めて path へ書き出す
+    bool StopAndSave(const std::string& path);
+    bool IsActive() const { return m_active_.load(std::memory_order_relaxed); }
+    size_t GetRecordCount() const;
+
+private:
+    struct Section {
+        std::string scene;
+        std::vector<std::string> names;
+        HashUtil::StringMap<bool> seen;
+    };
+
+    mutable std::mutex m_mtx_;
+    std::atomic<bool> m_active_{ false };
+    std::vector<Section> m_sections_;
+    size_t m_count_ = 0;
+};
+
+#endif // LOADTRACE_H
@@ -0,0 +1,470 @@
+#include "MeshCook.h"
+#include <cstring>
+#include <algorithm>
+
+namespace {
+
+    constexpr char kMeshMagic[8] = { 'P','I','X','M','E','S','H','\0' };
+
+    uint64_t AlignUp(uint64_t v) { return (v + (kMeshSectionAlignment - 1)) & ~(uint64_t)(kMeshSectionAlignment - 1); }
+
+    // 書き出し中のセクション
+    struct PendingSection {
+        MeshSectionType type;
+        uint32_t count;
+        uint32_t stride;
+        const void* data;
+    };
+
+    class StringPool {
+    public:
+        MeshFileString Add(const std::string& s) {
+            MeshFileString r{ (uint32_t)m_data_.size(), (uint32_t)s.size() };
+            m_data_.insert(m_data_.end(), s.begin(), s.end());
+            return r;
+        }
+        const std::vector<char>& Data() const { return m_data_; }
+    private:
+        std::vector<char> m_data_;
+    };
+
+    bool GetString(const MeshFileString& s, const char* pool, uint64_t poolSize, std::string& out) {
+        if ((uint64_t)s.offset + s.length > poolSize) return false;
+        out.assign(pool ? pool + s.offset : "", s.length);
+        return true;
+    }
+
+    // 固定長テーブルのセクションを vector へ読む
+    template <class T>
+    bool ReadTable(const uint8_t* data, const MeshSection* sec, std::vector<T>& out) {
+        out.clear();
+        if (!sec) return true;
+        if (sec->stride != sizeof(T)) return false;
+        out.resize(sec->count);
+        if (sec->count) memcpy(out.data(), data + sec->offset, (size_t)sec->size);
+        return true;
+    }
+
+} // namespace
+
+namespace MeshCook {
+
+    void Write(const ModelMeshData& mesh, const PackedIndexView& indices, uint64_t sourceSize, uint64_t sourceHash,
+        uint64_t sourceWriteTime, std::vector<uint8_t>& out, const PackedVertices* packed) {
+        StringPool strings;
+
+        std::vector<MeshFileSubMesh> submeshes;
+        submeshes.reserve(mesh.submeshes.size());
+        for (const SubMesh& sm : mesh.submeshes) {
+            MeshFileSubMesh f{};
+            f.indexOffset = sm.indexOffset;
+            f.indexCount = sm.indexCount;
+            f.materialIndex = sm.materialIndex;
+            f.flags = (sm.skinned ? MeshSubMeshFlag_Skinned : 0) |
+                (sm.hasUV ? MeshSubMeshFlag_HasUV : 0) |
+                (sm.uvAllZero ? MeshSubMeshFlag_UVAllZero : 0);
+            submeshes.push_back(f);
+        }
+
+        std::vector<MeshFileSubMeshIndex> indexLayout;
+        indexLayout.reserve(mesh.submeshes.size());
+        for (const SubMesh& sm : mesh.submeshes) {
+            MeshFileSubMeshIndex f{};
+            f.baseVertex = sm.baseVertex;
+            f.indexStart = sm.indexStart;
+            f.flags = sm.index16 ? MeshSubMeshIndexFlag_Index16 : 0;
+            indexLayout.push_back(f);
+        }
+
+        std::vector<MeshFileMaterial> materials;
+        materials.reserve(mesh.materials.size());
+        for (const MaterialShared& m : mesh.materials) {
+            MeshFileMaterial f{};
+            f.baseColor[0] = m.baseColor.x;
+            f.baseColor[1] = m.baseColor.y;
+            f.baseColor[2] = m.baseColor.z;
+            f.baseColor[3] = m.baseColor.w;
+            f.metallic = m.metallic;
+            f.roughness = m.roughness;
+            f.baseColorTex = strings.Add(m.baseColorTex);
+            materials.push_back(f);
+        }
+
+        std::vector<MeshFileBone> bones;
+        bones.reserve(mesh.bones.size());
+        for (const Bone& b : mesh.bones) {
+            MeshFileBone f{};
+            f.name = strings.Add(b.name);
+            f.parentIndex = b.parentIndex;
+            DirectX::XMFLOAT4X4 m;
+            DirectX::XMStoreFloat4x4(&m, b.offset);
+            memcpy(f.offset, &m, sizeof(f.offset));
+            bones.push_back(f);
+        }
+
+        std::vector<MeshFileSubMeshRange> ranges;
+        ranges.reserve(mesh.submeshes.size());
+        for (const SubMesh& sm : mesh.submeshes) {
+            MeshFileSubMeshRange f{};
+            f.vertexOffset = sm.vertexOffset;
+            f.vertexCount = sm.vertexCount;
+            memcpy(f.posScale, sm.posScale, sizeof(f.posScale));
+            memcpy(f.posBias, sm.posBias, sizeof(f.posBias));
+            ranges.push_back(f);
+        }
+
+        std::vector<MeshFileMeshlet> meshlets;
+        meshlets.reserve(mesh.meshlets.meshlets.size());
+        for (const Meshlet& m : mesh.meshlets.meshlets) {
+            MeshFileMeshlet f{};
+            f.vertexOffset = m.vertexOffset;
+            f.triangleOffset = m.triangleOffset;
+            f.vertexCount = m.vertexCount;
+            f.triangleCount = m.triangleCount;
+            f.submesh = m.submesh;
+            memcpy(f.center, m.center, sizeof(f.center));
+            f.radius = m.radius;
+            memcpy(f.coneApex, m.coneApex, sizeof(f.coneApex));
+            memcpy(f.coneAxis, m.coneAxis, sizeof(f.coneAxis));
+            f.coneCutoff = m.coneCutoff;
+            meshlets.push_back(f);
+        }
+
+        std::vector<MeshFileClip> clips;
+        clips.reserve(mesh.clips.size());
+        for (const AnimationClip& c : mesh.clips) {
+            MeshFileClip f{};
+            f.name = strings.Add(c.name);
+            f.duration = c.duration;
+            f.tps = c.tps;
+            f.channelCount = 0;
+            clips.push_back(f);
+        }
+
+        const std::vector<char>& pool = strings.Data();
+        const uint32_t vertexCount = (uint32_t)mesh.vertices.size();
+        std::vector<PendingSection> sections;
+        MeshFileVertexLayout layout{};
+        if (packed) {
+            layout.flags = packed->layout.flags;
+            layout.baseStride = packed->layout.baseStride;
+            layout.skinStride = packed->layout.skinStride;
+            sections.push_back({ MeshSectionType::PackedVertexLayout, 1u, (uint32_t)sizeof(layout), &layout });
+            sections.push_back({ MeshSectionType::PackedVertices, vertexCount, layout.baseStride, packed->base.data() });
+            if (layout.skinStride) sections.push_back({ MeshSectionType::PackedSkin, vertexCount, layout.skinStride, packed->skin.data() });
+        }
+        else {
+            sections.push_back({ MeshSectionType::Vertices, vertexCount, (uint32_t)sizeof(ModelVertex), mesh.vertices.data() });
+        }
+        sections.push_back({ MeshSectionType::PackedIndices, (uint32_t)indices.size, 1u, indices.data });
+        sections.push_back({ MeshSectionType::SubMeshes, (uint32_t)submeshes.size(), (uint32_t)sizeof(MeshFileSubMesh), submeshes.data() });
+        sections.push_back({ MeshSectionType::SubMeshIndexLayout, (uint32_t)indexLayout.size(), (uint32_t)sizeof(MeshFileSubMeshIndex), indexLayout.data() });
+        sections.push_back({ MeshSectionType::SubMeshRanges, (uint32_t)ranges.size(), (uint32_t)sizeof(MeshFileSubMeshRange), ranges.data() });
+        sections.push_back({ MeshSectionType::Materials, (uint32_t)materials.size(), (uint32_t)sizeof(MeshFileMaterial), materials.data() });
+        sections.push_back({ MeshSectionType::Bones, (uint32_t)bones.size(), (uint32_t)sizeof(MeshFileBone), bones.data() });
+        sections.push_back({ MeshSectionType::Clips, (uint32_t)clips.size(), (uint32_t)sizeof(MeshFileClip), clips.data() });
+        if (!meshlets.empty()) {
+            sections.push_back({ MeshSectionType::Meshlets, (uint32_t)meshlets.size(), (uint32_t)sizeof(MeshFileMeshlet), meshlets.data() });
+            sections.push_back({ MeshSectionType::MeshletVertices, (uint32_t)mesh.meshlets.vertices.size(), (uint32_t)sizeof(uint32_t), mesh.meshlets.vertices.data() });
+            sections.push_back({ MeshSectionType::MeshletTriangles, (uint32_t)mesh.meshlets.triangles.size(), 1u, mesh.meshlets.triangles.data() });
+        }
+        sections.push_back({ MeshSectionType::Strings, (uint32_t)pool.size(), 1u, pool.data() });
+        const uint32_t sectionCount = (uint32_t)sections.size();
+
+        std::vector<MeshSection> table(sectionCount);
+        uint64_t offset = AlignUp(sizeof(MeshFileHeader) + sizeof(MeshSection) * sectionCount);
+        for (uint32_t i = 0; i < sectionCount; ++i) {
+            table[i] = MeshSection{};
+            table[i].type = (uint32_t)sections[i].type;
+            table[i].count = sections[i].count;
+            table[i].stride = sections[i].stride;
+            table[i].offset = offset;
+            table[i].size = (uint64_t)sections[i].count * sections[i].stride;
+            offset = AlignUp(offset + table[i].size);
+        }
+
+        MeshFileHeader header{};
+        memcpy(header.magic, kMeshMagic, sizeof(header.magic));
+        header.version = kMeshFormatVersion;
+        header.sectionCount = sectionCount;
+        header.fileSize = offset;
+        header.sourceSize = sourceSize;
+        header.sourceHash = sourceHash;
+        header.sourceWriteTime = sourceWriteTime;
+        header.flags = mesh.hasSkin ? MeshFileFlag_HasSkin : 0;
+        header.vertexCount = vertexCount;
+        header.indexCount = (uint32_t)mesh.indices.size();
+
+        out.assign((size_t)offset, 0);
+        memcpy(out.data(), &header, sizeof(header));
+        memcpy(out.data() + sizeof(header), table.data(), sizeof(MeshSection) * sectionCount);
+        for (uint32_t i = 0; i < sectionCount; ++i) {
+            if (table[i].size) memcpy(out.data() + table[i].offset, sections[i].data, (size_t)table[i].size);
+        }
+    }
+
+    bool Read(const uint8_t* data, size_t size, CookedMeshView& view, ModelMeshData& tables, std::string& error) {
+        view = CookedMeshView{};
+        tables = ModelMeshData{};
+        MeshFileHeader& h = view.header;
+        if (size < sizeof(h)) {
+            error = "too small";
+            return false;
+        }
+        memcpy(&h, data, sizeof(h));
+        if (memcmp(h.magic, kMeshMagic, sizeof(kMeshMagic)) != 0) {
+            error = "bad magic";
+            return false;
+        }
+        if (h.version < kMeshFormatMinVersion || h.version > kMeshFormatVersion) {
+            error = "unsupported version " + std::to_string(h.version);
+            return false;
+        }
+        if (h.fileSize != size || h.sectionCount > 1024 ||
+            sizeof(h) + (uint64_t)h.sectionCount * sizeof(MeshSection) > size) {
+            error = "corrupt header";
+            return false;
+        }
+
+        // セクション表の検証 (範囲外を指していないか)。知らない種類は読み飛ばす
+        std::vector<MeshSection> table(h.sectionCount);
+        memcpy(table.data(), data + sizeof(h), sizeof(MeshSection) * h.sectionCount);
+        const MeshSection* found[32] = {};
+        for (const MeshSection& s : table) {
+            if (s.offset > size || s.size > size - s.offset || s.size != (uint64_t)s.count * s.stride) {
+                error = "corrupt section table";
+                return false;
+            }
+            if (s.type < 32) found[s.type] = &s;
+        }
+        auto section = [&](MeshSectionType t) { return found[(uint32_t)t]; };
+
+        // 版 4 は詰めたインデックス、それより前は uint32 のインデックス
+        const MeshSection* is = section(h.version >= 4 ? MeshSectionType::PackedIndices : MeshSectionType::Indices32);
+        if (h.version >= 4) {
+            if (!is || is->stride != 1) {
+                error = "missing or mismatched index section";
+                return false;
+            }
+            view.packedIndices.data = data + is->offset;
+            view.packedIndices.size = (size_t)is->size;
+        }
+        else {
+            if (!is || is->stride != sizeof(uint32_t) || is->count != h.indexCount) {
+                error = "missing or mismatched index section";
+                return false;
+            }
+            view.indices = data + is->offset;
+        }
+
+        if (const MeshSection* ls = section(MeshSectionType::PackedVertexLayout)) {
+            MeshFileVertexLayout layout;
+            if (ls->count != 1 || ls->stride != sizeof(layout)) {
+                error = "bad vertex layout section";
+                return false;
+            }
+            memcpy(&layout, data + ls->offset, sizeof(layout));
+            const bool quantized = (layout.flags & VertexPack_QuantizedPosition) != 0;
+            const bool skinned = (layout.flags & VertexPack_Skinned) != 0;
+            const uint32_t knownFlags = VertexPack_QuantizedPosition | VertexPack_UVUnorm16 | VertexPack_Skinned |
+                (h.version >= 3 ? (uint32_t)VertexPack_SplitPosition : 0u);
+            if (layout.flags & ~knownFlags) {
+                error = "unknown vertex layout flags";
+                return false;
+            }
+            const uint32_t baseStride = quantized ? (uint32_t)sizeof(PackedVertexQuantPos) : (uint32_t)sizeof(PackedVertexFloatPos);
+            const uint32_t skinStride = skinned ? (uint32_t)sizeof(PackedSkin) : 0u;
+            const MeshSection* ps = section(MeshSectionType::PackedVertices);
+            const MeshSection* ks = section(MeshSectionType::PackedSkin);
+            if (layout.baseStride != baseStride || layout.skinStride != skinStride ||
+                !ps || ps->stride != baseStride || ps->count != h.vertexCount ||
+                (skinned && (!ks || ks->stride != skinStride || ks->count != h.vertexCount))) {
+                error = "missing or mismatched packed vertex section";
+                return false;
+            }
+            view.layout.flags = layout.flags;
+            view.layout.baseStride = layout.baseStride;
+            view.layout.skinStride = layout.skinStride;
+            view.vertices = data + ps->offset;
+            view.skin = skinned ? data + ks->offset : nullptr;
+        }
+        else {
+            const MeshSection* vs = section(MeshSectionType::Vertices);
+            if (!vs || vs->stride != sizeof(ModelVertex) || vs->count != h.vertexCount) {
+                error = "missing or mismatched vertex section";
+                return false;
+            }
+            view.vertices = data + vs->offset;
+        }
+
+        const MeshSection* ss = section(MeshSectionType::Strings);
+        const char* pool = ss ? reinterpret_cast<const char*>(data + ss->offset) : nullptr;
+        const uint64_t poolSize = ss ? ss->size : 0;
+
+        std::vector<MeshFileSubMesh> submeshes;
+        std::vector<MeshFileSubMeshRange> ranges;
+        std::vector<MeshFileSubMeshIndex> indexLayout;
+        std::vector<MeshFileMaterial> materials;
+        std::vector<MeshFileBone> bones;
+        std::vector<MeshFileClip> clips;
+        std::vector<MeshFileMeshlet> meshlets;
+        if (!ReadTable(data, section(MeshSectionType::SubMeshes), submeshes) ||
+            !ReadTable(data, section(MeshSectionType::Meshlets), meshlets) ||
+            !ReadTable(data, section(MeshSectionType::MeshletVertices), tables.meshlets.vertices) ||
+            !ReadTable(data, section(MeshSectionType::MeshletTriangles), tables.meshlets.triangles) ||
+            !ReadTable(data, section(MeshSectionType::SubMeshRanges), ranges) ||
+            !ReadTable(data, section(MeshSectionType::SubMeshIndexLayout), indexLayout) ||
+            !ReadTable(data, section(MeshSectionType::Materials), materials) ||
+            !ReadTable(data, section(MeshSectionType::Bones), bones) ||
+            !ReadTable(data, section(MeshSectionType::Clips), clips)) {
+            error = "unexpected table stride";
+            return false;
+        }
+
+        tables.hasSkin = (h.flags & MeshFileFlag_HasSkin) != 0;
+        tables.submeshes.reserve(submeshes.size());
+        for (const MeshFileSubMesh& f : submeshes) {
+            if ((uint64_t)f.indexOffset + f.indexCount > h.indexCount) {
+                error = "submesh index range out of bounds";
+                return false;
+            }
+            SubMesh sm;
+            sm.indexOffset = f.indexOffset;
+            sm.indexCount = f.indexCount;
+            sm.materialIndex = f.materialIndex;
+            sm.skinned = (f.flags & MeshSubMeshFlag_Skinned) != 0;
+            sm.hasUV = (f.flags & MeshSubMeshFlag_HasUV) != 0;
+            sm.uvAllZero = (f.flags & MeshSubMeshFlag_UVAllZero) != 0;
+            tables.submeshes.push_back(sm);
+        }
+        if (!ranges.empty() && ranges.size() != submeshes.size()) {
+            error = "submesh range count mismatch";
+            return false;
+        }
+        for (size_t i = 0; i < ranges.size(); ++i) {
+            const MeshFileSubMeshRange& f = ranges[i];
+            if ((uint64_t)f.vertexOffset + f.vertexCount > h.vertexCount) {
+                error = "submesh vertex range out of bounds";
+                return false;
+            }
+            SubMesh& sm = tables.submeshes[i];
+            sm.vertexOffset = f.vertexOffset;
+            sm.vertexCount = f.vertexCount;
+            memcpy(sm.posScale, f.posScale, sizeof(sm.posScale));
+            memcpy(sm.posBias, f.posBias, sizeof(sm.posBias));
+        }
+        if (h.version >= 4) {
+            // GPU 上の配置。インデックスの値は読み込み時には見ない (調理時に IndexPack::Validate 済み)
+            if (indexLayout.size() != submeshes.size()) {
+                error = "submesh index layout count mismatch";
+                return false;
+            }
+            uint32_t count16 = 0;
+            for (size_t i = 0; i < indexLayout.size(); ++i) {
+                SubMesh& sm = tables.submeshes[i];
+                sm.baseVertex = indexLayout[i].baseVertex;
+                sm.indexStart = indexLayout[i].indexStart;
+                sm.index16 = (indexLayout[i].flags & MeshSubMeshIndexFlag_Index16) != 0;
+                if (sm.index16) count16++;
+            }
+            if (!IndexPack::CheckLayout(tables.submeshes, view.packedIndices.size)) {
+                error = "submesh index layout out of bounds";
+                return false;
+            }
+            view.packedIndices.format = count16 == 0 ? IndexBufferFormat::UInt32 :
+                count16 == tables.submeshes.size() ? IndexBufferFormat::UInt16 : IndexBufferFormat::Mixed;
+        }
+        if (ranges.empty() && view.layout.baseStride == 0 && view.indices) {
+            // 版 1: 参照しているインデックスの最小 / 最大から頂点範囲を求める
+            for (SubMesh& sm : tables.submeshes) {
+                uint32_t lo = UINT32_MAX, hi = 0;
+                for (uint32_t i = 0; i < sm.indexCount; ++i) {
+                    uint32_t v;
+                    memcpy(&v, view.indices + ((size_t)sm.indexOffset + i) * sizeof(uint32_t), sizeof(v));
+                    lo = std::min(lo, v);
+                    hi = std::max(hi, v);
+                }
+                if (sm.indexCount && hi < h.vertexCount) {
+                    sm.vertexOffset = lo;
+                    sm.vertexCount = hi - lo + 1;
+                }
+            }
+        }
+        else if (ranges.empty()) {
+            error = "missing submesh ranges";
+            return false;
+        }
+        tables.materials.reserve(materials.size());
+        for (const MeshFileMaterial& f : materials) {
+            MaterialShared m;
+            m.baseColor = DirectX::XMFLOAT4(f.baseColor[0], f.baseColor[1], f.baseColor[2], f.baseColor[3]);
+            m.metallic = f.metallic;
+            m.roughness = f.roughness;
+            if (!GetString(f.baseColorTex, pool, poolSize, m.baseColorTex)) {
+                error = "string out of bounds";
+                return false;
+            }
+            tables.materials.push_back(std::move(m));
+        }
+        tables.bones.reserve(bones.size());
+        for (const MeshFileBone& f : bones) {
+            Bone b;
+            if (!GetString(f.name, pool, poolSize, b.name)) {
+                error = "string out of bounds";
+                return false;
+            }
+            b.parentIndex = f.parentIndex;
+            DirectX::XMFLOAT4X4 m;
+            memcpy(&m, f.offset, sizeof(f.offset));
+            b.offset = DirectX::XMLoadFloat4x4(&m);
+            tables.bones.push_back(std::move(b));
+        }
+        tables.clips.reserve(clips.size());
+        for (const MeshFileClip& f : clips) {
+            AnimationClip c;
+            if (!GetString(f.name, pool, poolSize, c.name)) {
+                error = "string out of bounds";
+                return false;
+            }
+            c.duration = f.duration;
+            c.tps = f.tps;
+            tables.clips.push_back(std::move(c));
+        }
+        // メッシュレット (任意): 参照する範囲を全て確かめる
+        tables.meshlets.meshlets.reserve(meshlets.size());
+        for (const MeshFileMeshlet& f : meshlets) {
+            if ((uint64_t)f.vertexOffset + f.vertexCount > tables.meshlets.vertices.size() ||
+                (uint64_t)f.triangleOffset + (uint64_t)f.triangleCount * 3 > tables.meshlets.triangles.size() ||
+                f.submesh >= tables.submeshes.size()) {
+                error = "bad meshlet section";
+                return false;
+            }
+            for (uint32_t i = 0; i < f.vertexCount; ++i) {
+                if (tables.meshlets.vertices[f.vertexOffset + i] >= h.vertexCount) {
+                    error = "bad meshlet section";
+                    return false;
+                }
+            }
+            for (uint32_t i = 0; i < f.triangleCount * 3; ++i) {
+                if (tables.meshlets.triangles[f.triangleOffset + i] >= f.vertexCount) {
+                    error = "bad meshlet section";
+                    return false;
+                }
+            }
+            Meshlet m;
+            m.vertexOffset = f.vertexOffset;
+            m.triangleOffset = f.triangleOffset;
+            m.vertexCount = f.vertexCount;
+            m.triangleCount = f.triangleCount;
+            m.submesh = f.submesh;
+            memcpy(m.center, f.center, sizeof(m.center));
+            m.radius = f.radius;
+            memcpy(m.coneApex, f.coneApex, sizeof(m.coneApex));
+            memcpy(m.coneAxis, f.coneAxis, sizeof(m.coneAxis));
+            m.coneCutoff = f.coneCutoff;
+            tables.meshlets.meshlets.push_back(m);
+        }
+        return true;
+    }
+
+} // namespace MeshCook
@@ -0,0 +1,55 @@
+// MeshCook
+// GPU バッファを作る前のモデルデータと、調理済みモデル (.pixmesh, MeshFormat.h) の書き出し / 読み込み
+
+#ifndef MESHCOOK_H
+#define MESHCOOK_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "AssetTypes.h"
+#include "MeshFormat.h"
+#include "VertexPack.h"
+#include "IndexPack.h"
+
+// Assimp からの読み込みと .pixmesh の読み込みのどちらもこの形を経由して ModelSharedResource を作る
+struct ModelMeshData {
+    std::vector<ModelVertex> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<SubMesh> submeshes;
+    std::vector<MaterialShared> materials; // baseColorTex はモデルに書かれたままのパス
+    std::vector<Bone> bones;
+    std::vector<AnimationClip> clips;
+    MeshletData meshlets;                  // 空なら作っていない
+    bool hasSkin = false;
+};
+
+// .pixmesh の頂点 / インデックスを指すビュー (元のバッファを指したままでコピーしない)。
+// 4 バイト境界に揃っているとは限らないので、GPU へ渡す以外で読む場合は memcpy すること
+struct CookedMeshView {
+    MeshFileHeader header{};
+    PackedVertexLayout layout;         // baseStride が 0 なら vertices は ModelVertex
+    const uint8_t* vertices = nullptr; // (ModelVertex または詰めた頂点) * header.vertexCount
+    const uint8_t* skin = nullptr;     // PackedSkin * header.vertexCount (スキン付きの詰めた頂点のみ)
+    const uint8_t* indices = nullptr;  // uint32_t * header.indexCount (版 3 までのファイル。版 4 は null)
+    PackedIndexView packedIndices;     // 版 4: 調理時に詰めたインデックス (tables.submeshes の配置に合わせてある)
+};
+
+namespace MeshCook {
+
+    // sourceSize / sourceHash / sourceWriteTime は元のモデルファイルのもの (読み込み時に古くなっていないか確かめる)。
+    // indices は GPU へ渡すインデックスバッファで、mesh.submeshes の baseVertex / indexStart / index16 はその配置。
+    // packed を渡すと mesh.vertices の代わりに詰めた頂点を書く (mesh.submeshes は Pack 後のもの)
+    void Write(const ModelMeshData& mesh, const PackedIndexView& indices, uint64_t sourceSize, uint64_t sourceHash,
+        uint64_t sourceWriteTime, std::vector<uint8_t>& out, const PackedVertices* packed = nullptr);
+
+    // ヘッダとセクション表を検証して view を作り、サブメッシュ / マテリアル / ボーン / クリップを tables へ読む。
+    // tables.vertices / indices は空のまま (view から直接使う)。
+    // 版 1 のファイルはサブメッシュの頂点範囲をインデックスから求める。
+    // 版 4 のファイルはサブメッシュのインデックス配置も読み、配置が範囲内かだけ確かめる (インデックスの値は見ない)。
+    // メッシュレットのセクションがあれば tables.meshlets へ読む (無いファイルは空のまま)
+    bool Read(const uint8_t* data, size_t size, CookedMeshView& view, ModelMeshData& tables, std::string& error);
+
+} // namespace MeshCook
+
+#endif // MESHCOOK_H
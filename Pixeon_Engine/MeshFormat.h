@@ -0,0 +1,168 @@
+#ifndef MESH_FORMAT_H
+#define MESH_FORMAT_H
+
+#include <cstdint>
+
+// 調理済みモデル (.pixmesh)
+// ModelManager が Assimp の読み込み結果 (頂点 / インデックス / サブメッシュ / マテリアル / ボーン / クリップ) を
+// そのまま書き出したもの。実行時は Assimp を通さず、マップしたファイルの頂点 / インデックスを
+// そのまま GPU バッファへ渡す。
+//
+// ファイル構成:
+//   MeshFileHeader
+//   MeshSection * sectionCount
+//   各セクションのデータ (ファイル先頭から kMeshSectionAlignment 境界)
+// 読み込み側は知らない種類のセクションを読み飛ばす (後から追加しても古い実行ファイルで読める)
+//
+// 版:
+//   1: Vertices (ModelVertex) のみ
+//   2: 詰めた頂点 (PackedVertexLayout / PackedVertices / PackedSkin, VertexPack.h) と SubMeshRanges を追加。
+//      詰めた頂点を持つファイルには Vertices が無い
+//   3: PackedVertices を位置とそれ以外の 2 面に分けた並び (VertexPack_SplitPosition) を追加
+//   4: インデックスを調理時に IndexPack で詰めた PackedIndices / SubMeshIndexLayout を追加。
+//      版 4 のファイルには Indices32 が無い (読み込み時に詰め直さず、そのまま GPU へ渡す)
+// 版に関係なく任意: Meshlets / MeshletVertices / MeshletTriangles (MeshletBuilder.h, 無ければ読み込み時に作る)
+
+constexpr uint32_t kMeshFormatVersion = 4;
+constexpr uint32_t kMeshFormatMinVersion = 1;
+constexpr uint32_t kMeshSectionAlignment = 16;
+
+#pragma pack(push,1)
+struct MeshFileHeader {
+    char     magic[8];          // "PIXMESH\0"
+    uint32_t version;           // kMeshFormatVersion
+    uint32_t sectionCount;
+    uint64_t fileSize;
+    uint64_t sourceSize;        // 元のモデルファイルのバイト数
+    uint64_t sourceHash;        // 元のモデルファイルの HashUtil::Hash64 (古くなっていないかの確認用)
+    uint32_t flags;             // MeshFileFlags
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint64_t sourceWriteTime;   // 元のモデルファイルの更新時刻 (file_time_type の刻み, 0 = 不明)。サイズと合えばハッシュを省く
+    uint8_t  reserved[4];       // 0
+};
+static_assert(sizeof(MeshFileHeader) == 64, "MeshFileHeader size");
+
+enum class MeshSectionType : uint32_t {
+    Vertices = 1,   // ModelVertex * vertexCount
+    Indices32 = 2,  // uint32_t * indexCount (モデル全体の頂点番号, 版 3 まで)
+    SubMeshes = 3,  // MeshFileSubMesh
+    Materials = 4,  // MeshFileMaterial
+    Bones = 5,      // MeshFileBone
+    Clips = 6,      // MeshFileClip
+    Strings = 7,    // 文字列プール (MeshFileString で参照, 終端 '\0' 無し)
+    SubMeshRanges = 8,        // MeshFileSubMeshRange (SubMeshes と同じ並び)
+    PackedVertexLayout = 9,   // MeshFileVertexLayout * 1
+    PackedVertices = 10,      // 詰めた頂点 (stride = baseStride) * vertexCount
+    PackedSkin = 11,          // PackedSkin * vertexCount
+    Meshlets = 12,            // MeshFileMeshlet
+    MeshletVertices = 13,     // uint32_t (モデル全体の頂点番号)
+    MeshletTriangles = 14,    // uint8_t (メッシュレット内の頂点番号 * 3)
+    PackedIndices = 15,       // uint8_t (IndexPack::Pack の出力, 版 4)
+    SubMeshIndexLayout = 16,  // MeshFileSubMeshIndex (SubMeshes と同じ並び, 版 4)
+};
+
+struct MeshSection {
+    uint32_t type;              // MeshSectionType
+    uint32_t count;             // 要素数
+    uint32_t stride;            // 1 要素のバイト数 (文字列プールは 1)
+    uint32_t reserved;          // 0
+    uint64_t offset;            // ファイル先頭から
+    uint64_t size;              // count * stride
+};
+static_assert(sizeof(MeshSection) == 32, "MeshSection size");
+
+enum MeshFileFlags : uint32_t {
+    MeshFileFlag_None = 0,
+    MeshFileFlag_HasSkin = 1 << 0,
+};
+
+struct MeshFileString {
+    uint32_t offset;
+    uint32_t length;
+};
+
+enum MeshSubMeshFlags : uint32_t {
+    MeshSubMeshFlag_Skinned = 1 << 0,
+    MeshSubMeshFlag_HasUV = 1 << 1,
+    MeshSubMeshFlag_UVAllZero = 1 << 2,
+};
+
+struct MeshFileSubMesh {
+    uint32_t indexOffset;
+    uint32_t indexCount;
+    uint32_t materialIndex;
+    uint32_t flags;             // MeshSubMeshFlags
+};
+static_assert(sizeof(MeshFileSubMesh) == 16, "MeshFileSubMesh size");
+
+enum MeshSubMeshIndexFlags : uint32_t {
+    MeshSubMeshIndexFlag_Index16 = 1 << 0,
+};
+
+// PackedIndices 上のサブメッシュの配置 (SubMesh::baseVertex / indexStart / index16)
+struct MeshFileSubMeshIndex {
+    uint32_t baseVertex;
+    uint32_t indexStart;        // index16 なら uint16, でなければ uint32 の要素単位
+    uint32_t flags;             // MeshSubMeshIndexFlags
+    uint32_t reserved;          // 0
+};
+static_assert(sizeof(MeshFileSubMeshIndex) == 16, "MeshFileSubMeshIndex size");
+
+struct MeshFileSubMeshRange {
+    uint32_t vertexOffset;
+    uint32_t vertexCount;
+    float    posScale[3];       // 量子化した位置の逆量子化 (SubMesh::posScale / posBias)
+    float    posBias[3];
+};
+static_assert(sizeof(MeshFileSubMeshRange) == 32, "MeshFileSubMeshRange size");
+
+struct MeshFileVertexLayout {
+    uint32_t flags;             // VertexPackFlags
+    uint32_t baseStride;
+    uint32_t skinStride;
+    uint32_t reserved;          // 0
+};
+static_assert(sizeof(MeshFileVertexLayout) == 16, "MeshFileVertexLayout size");
+
+struct MeshFileMeshlet {
+    uint32_t vertexOffset;      // MeshletVertices の先頭
+    uint32_t triangleOffset;    // MeshletTriangles の先頭 (バイト)
+    uint32_t vertexCount;
+    uint32_t triangleCount;
+    uint32_t submesh;
+    float    center[3];
+    float    radius;
+    float    coneApex[3];
+    float    coneAxis[3];
+    float    coneCutoff;
+};
+static_assert(sizeof(MeshFileMeshlet) == 64, "MeshFileMeshlet size");
+
+struct MeshFileMaterial {
+    float          baseColor[4];
+    float          metallic;
+    float          roughness;
+    MeshFileString baseColorTex; // モデルに書かれたままのパス (解決は読み込み時に行う)
+};
+static_assert(sizeof(MeshFileMaterial) == 32, "MeshFileMaterial size");
+
+struct MeshFileBone {
+    MeshFileString name;
+    int32_t        parentIndex;
+    uint32_t       reserved;
+    float          offset[16];  // 行優先 (XMMATRIX の r[0..3])
+};
+static_assert(sizeof(MeshFileBone) == 80, "MeshFileBone size");
+
+struct MeshFileClip {
+    MeshFileString name;
+    double         duration;
+    double         tps;
+    uint32_t       channelCount; // 0 (チャンネルは未実装)
+    uint32_t       reserved;
+};
+static_assert(sizeof(MeshFileClip) == 32, "MeshFileClip size");
+#pragma pack(pop)
+
+#endif // MESH_FORMAT_H
@@ -0,0 +1,534 @@
+#include "MeshletBuilder.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+namespace {
+
+    constexpr double kPi = 3.14159265358979323846;
+
+    struct Vec3 { double x, y, z; };
+    Vec3 Sub(const Vec3& a, const Vec3& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+    Vec3 Cross(const Vec3& a, const Vec3& b) { return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x }; }
+    double Dot(const Vec3& a, const Vec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    double Length(const Vec3& a) { return std::sqrt(Dot(a, a)); }
+    Vec3 Pos(const ModelVertex& v) { return { v.position[0], v.position[1], v.position[2] }; }
+
+    // 三角形を最小の頂点番号が先頭になるよう回す (向きは保つ)
+    std::array<uint32_t, 3> Canonical(uint32_t a, uint32_t b, uint32_t c) {
+        if (b < a && b <= c) return { b, c, a };
+        if (c < a && c < b) return { c, a, b };
+        return { a, b, c };
+    }
+
+    // 作りかけのメッシュレット
+    class MeshletAccumulator {
+    public:
+        MeshletAccumulator(uint32_t base, uint32_t range) : m_slot_(range, -1), m_base_(base) {}
+
+        // tri の頂点のうちまだ入っていない数
+        uint32_t NewVertices(const uint32_t* tri) const {
+            uint32_t n = 0;
+            for (int k = 0; k < 3; ++k) {
+                if (m_slot_[tri[k] - m_base_] < 0 && (k == 0 || tri[k] != tri[0]) && (k < 2 || tri[2] != tri[1])) n++;
+            }
+            return n;
+        }
+        bool Fits(const uint32_t* tri) const {
+            return m_triangles_.size() / 3 < MeshletBuilder::kMaxTriangles &&
+                m_vertices_.size() + NewVertices(tri) <= MeshletBuilder::kMaxVertices;
+        }
+        // 追加して、新しく入った頂点を added へ書く
+        void Add(const uint32_t* tri, std::vector<uint32_t>& added) {
+            for (int k = 0; k < 3; ++k) {
+                int32_t& slot = m_slot_[tri[k] - m_base_];
+                if (slot < 0) {
+                    slot = (int32_t)m_vertices_.size();
+                    m_vertices_.push_back(tri[k]);
+                    added.push_back(tri[k]);
+                }
+                m_triangles_.push_back((uint8_t)slot);
+            }
+        }
+        uint32_t TriangleCount() const { return (uint32_t)(m_triangles_.size() / 3); }
+
+        void Flush(uint32_t submesh, const std::vector<ModelVertex>& vertices, MeshletData& out) {
+            Meshlet m;
+            m.vertexOffset = (uint32_t)out.vertices.size();
+            m.triangleOffset = (uint32_t)out.triangles.size();
+            m.vertexCount = (uint32_t)m_vertices_.size();
+            m.triangleCount = TriangleCount();
+            m.submesh = submesh;
+            ComputeBounds(vertices, m);
+            out.vertices.insert(out.vertices.end(), m_vertices_.begin(), m_vertices_.end());
+            out.triangles.insert(out.triangles.end(), m_triangles_.begin(), m_triangles_.end());
+            out.meshlets.push_back(m);
+            for (uint32_t v : m_vertices_) m_slot_[v - m_base_] = -1;
+            m_vertices_.clear();
+            m_triangles_.clear();
+        }
+
+    private:
+        void ComputeBounds(const std::vector<ModelVertex>& vertices, Meshlet& m) const {
+            // 球: 範囲の中心から最も遠い頂点まで
+            Vec3 lo = Pos(vertices[m_vertices_[0]]), hi = lo;
+            for (uint32_t v : m_vertices_) {
+                Vec3 p = Pos(vertices[v]);
+                lo = { std::min(lo.x, p.x), std::min(lo.y, p.y), std::min(lo.z, p.z) };
+                hi = { std::max(hi.x, p.x), std::max(hi.y, p.y), std::max(hi.z, p.z) };
+            }
+            const Vec3 c = { (lo.x + hi.x) * 0.5, (lo.y + hi.y) * 0.5, (lo.z + hi.z) * 0.5 };
+            double r = 0.0;
+            for (uint32_t v : m_vertices_) r = std::max(r, Length(Sub(Pos(vertices[v]), c)));
+            m.center[0] = (float)c.x;
+            m.center[1] = (float)c.y;
+            m.center[2] = (float)c.z;
+            // float へ丸めた中心からでも包むよう少し広げる
+            m.radius = (float)(r * (1.0 + 1e-6) + 1e-6 * (std::fabs(c.x) + std::fabs(c.y) + std::fabs(c.z)));
+
+            // 円錐: 面法線の平均を軸にし、最も離れた法線との角度から cutoff を決める
+            std::vector<Vec3> normals;
+            std::vector<Vec3> corners;
+            Vec3 axis{ 0, 0, 0 };
+            for (size_t t = 0; t < m_triangles_.size(); t += 3) {
+                const Vec3 p0 = Pos(vertices[m_vertices_[m_triangles_[t]]]);
+                const Vec3 n = Cross(Sub(Pos(vertices[m_vertices_[m_triangles_[t + 1]]]), p0),
+                    Sub(Pos(vertices[m_vertices_[m_triangles_[t + 2]]]), p0));
+                const double len = Length(n);
+                if (!(len > 0.0)) continue; // 潰れた三角形はどちらからも見えない
+                normals.push_back({ n.x / len, n.y / len, n.z / len });
+                corners.push_back(p0);
+                axis = { axis.x + n.x / len, axis.y + n.y / len, axis.z + n.z / len };
+            }
+            m.coneCutoff = 1.0f;
+            const double axisLen = Length(axis);
+            if (normals.empty() || !(axisLen > 1e-9)) return;
+            axis = { axis.x / axisLen, axis.y / axisLen, axis.z / axisLen };
+            double minDot = 1.0;
+            for (const Vec3& n : normals) minDot = std::min(minDot, Dot(n, axis));
+            // 約 84 度より広がっていれば判定しない
+            if (minDot <= 0.1) return;
+            // 頂点は全ての三角形の面の裏側にある点: 中心から -axis 方向へ進めた所
+            double maxT = 0.0;
+            for (size_t i = 0; i < normals.size(); ++i) {
+                const double t = Dot(Sub(c, corners[i]), normals[i]) / Dot(axis, normals[i]);
+                maxT = std::max(maxT, t);
+            }
+            // 丸め誤差に対して保守的に (cutoff を大きく, 頂点を後ろへ)
+            const double cutoff = std::sqrt(1.0 - minDot * minDot) + 1e-4;
+            maxT += 1e-5 * (r + 1.0);
+            m.coneApex[0] = (float)(c.x - axis.x * maxT);
+            m.coneApex[1] = (float)(c.y - axis.y * maxT);
+            m.coneApex[2] = (float)(c.z - axis.z * maxT);
+            m.coneAxis[0] = (float)axis.x;
+            m.coneAxis[1] = (float)axis.y;
+            m.coneAxis[2] = (float)axis.z;
+            m.coneCutoff = (float)std::min(cutoff, 1.0);
+        }
+
+        std::vector<int32_t> m_slot_; // 頂点 → メッシュレット内の番号 (-1 は未使用)
+        std::vector<uint32_t> m_vertices_;
+        std::vector<uint8_t> m_triangles_;
+        uint32_t m_base_;
+    };
+
+    // 1 つのサブメッシュを分ける
+    void BuildSubMesh(const std::vector<ModelVertex>& vertices, const uint32_t* indices, uint32_t triangleCount,
+        uint32_t submesh, MeshletData& out) {
+        if (triangleCount == 0) return;
+        uint32_t lo = UINT32_MAX, hi = 0;
+        for (uint32_t i = 0; i < triangleCount * 3; ++i) {
+            lo = std::min(lo, indices[i]);
+            hi = std::max(hi, indices[i]);
+        }
+        const uint32_t range = hi - lo + 1;
+
+        // 頂点 → 三角形 (CSR)
+        std::vector<uint32_t> start(range + 1, 0);
+        for (uint32_t i = 0; i < triangleCount * 3; ++i) start[indices[i] - lo + 1]++;
+        for (uint32_t v = 0; v < range; ++v) start[v + 1] += start[v];
+        std::vector<uint32_t> adjacency(triangleCount * 3);
+        {
+            std::vector<uint32_t> fill(start.begin(), start.end() - 1);
+            for (uint32_t i = 0; i < triangleCount * 3; ++i) adjacency[fill[indices[i] - lo]++] = i / 3;
+        }
+
+        std::vector<uint8_t> used(triangleCount, 0);
+        std::vector<uint32_t> candidates; // 今のメッシュレットの頂点に接する三角形 (重複 / 使用済みを含む)
+        std::vector<uint32_t> added;
+        MeshletAccumulator acc(lo, range);
+        uint32_t cursor = 0;
+        uint32_t remaining = triangleCount;
+
+        auto addTriangle = [&](uint32_t t) {
+            used[t] = 1;
+            remaining--;
+            added.clear();
+            acc.Add(indices + (size_t)t * 3, added);
+            for (uint32_t v : added) {
+                for (uint32_t a = start[v - lo]; a < start[v - lo + 1]; ++a) {
+                    if (!used[adjacency[a]]) candidates.push_back(adjacency[a]);
+                }
+            }
+        };
+
+        while (remaining > 0) {
+            // 種: 前のメッシュレットに接していた三角形があればそれ (隣へ続ける), 無ければ元の順で次のもの
+            uint32_t seed = UINT32_MAX;
+            for (uint32_t t : candidates) {
+                if (!used[t]) { seed = t; break; }
+            }
+            if (seed == UINT32_MAX) {
+                while (used[cursor]) cursor++;
+                seed = cursor;
+            }
+            candidates.clear();
+            addTriangle(seed);
+
+            while (acc.TriangleCount() < MeshletBuilder::kMaxTriangles) {
+                uint32_t best = UINT32_MAX, bestNew = 4;
+                size_t write = 0;
+                for (size_t i = 0; i < candidates.size(); ++i) {
+                    const uint32_t t = candidates[i];
+                    if (used[t]) continue;
+                    candidates[write++] = t; // 使用済みを詰める
+                    if (bestNew == 0) continue;
+                    const uint32_t* tri = indices + (size_t)t * 3;
+                    if (!acc.Fits(tri)) continue;
+                    const uint32_t n = acc.NewVertices(tri);
+                    if (n < bestNew) {
+                        bestNew = n;
+                        best = t;
+                    }
+                }
+                candidates.resize(write);
+                if (best == UINT32_MAX) {
+                    // 接する三角形が入らなければ、離れていても入るものを元の順で探す
+                    while (cursor < triangleCount && used[cursor]) cursor++;
+                    if (cursor < triangleCount && acc.Fits(indices + (size_t)cursor * 3) && candidates.empty()) best = cursor;
+                    else break;
+                }
+                addTriangle(best);
+            }
+            acc.Flush(submesh, vertices, out);
+        }
+    }
+
+} // namespace
+
+namespace MeshletBuilder {
+
+    bool Build(const std::vector<ModelVertex>& vertices, const std::vector<uint32_t>& indices,
+        const std::vector<SubMesh>& submeshes, MeshletData& out, std::string& error) {
+        out = MeshletData{};
+        for (const SubMesh& sm : submeshes) {
+            if ((uint64_t)sm.indexOffset + sm.indexCount > indices.size()) {
+                error = "submesh index range out of bounds";
+                return false;
+            }
+            for (uint32_t i = 0; i < sm.indexCount; ++i) {
+                if (indices[sm.indexOffset + i] >= vertices.size()) {
+                    error = "index out of vertex range";
+                    return false;
+                }
+            }
+        }
+        for (uint32_t s = 0; s < (uint32_t)submeshes.size(); ++s) {
+            const SubMesh& sm = submeshes[s];
+            BuildSubMesh(vertices, indices.data() + sm.indexOffset, sm.indexCount / 3, s, out);
+        }
+        return true;
+    }
+
+    bool ConeCulled(const Meshlet& m, const float viewPos[3]) {
+        if (m.coneCutoff >= 1.0f) return false;
+        const double d[3] = { (double)m.coneApex[0] - viewPos[0], (double)m.coneApex[1] - viewPos[1], (double)m.coneApex[2] - viewPos[2] };
+        const double len = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+        if (!(len > 0.0)) return false;
+        const double dot = (d[0] * m.coneAxis[0] + d[1] * m.coneAxis[1] + d[2] * m.coneAxis[2]) / len;
+        return dot >= m.coneCutoff;
+    }
+
+    bool Validate(const std::vector<ModelVertex>& vertices, const std::vector<uint32_t>& indices,
+        const std::vector<SubMesh>& submeshes, const MeshletData& data, MeshletReport& report) {
+
+        const double buildMs = report.buildMs;
+        report = MeshletReport{};
+        report.buildMs = buildMs;
+        report.meshletCount = (uint32_t)data.meshlets.size();
+        auto fail = [&](const std::string& what) {
+            if (report.passed) report.failure = what;
+            report.passed = false;
+        };
+
+        // 構造: 上限と範囲
+        std::vector<std::vector<std::array<uint32_t, 3>>> built(submeshes.size());
+        uint64_t totalVertices = 0, totalTriangles = 0;
+        for (size_t i = 0; i < data.meshlets.size(); ++i) {
+            const Meshlet& m = data.meshlets[i];
+            const std::string at = "meshlet " + std::to_string(i);
+            if (m.vertexCount == 0 || m.vertexCount > kMaxVertices || m.triangleCount == 0 || m.triangleCount > kMaxTriangles) {
+                fail(at + " exceeds limits");
+                continue;
+            }
+            if ((uint64_t)m.vertexOffset + m.vertexCount > data.vertices.size() ||
+                (uint64_t)m.triangleOffset + (uint64_t)m.triangleCount * 3 > data.triangles.size() ||
+                m.submesh >= submeshes.size()) {
+                fail(at + " out of bounds");
+                continue;
+            }
+            totalVertices += m.vertexCount;
+            totalTriangles += m.triangleCount;
+            bool local = true;
+            for (uint32_t v = 0; v < m.vertexCount; ++v) {
+                if (data.vertices[m.vertexOffset + v] >= vertices.size()) local = false;
+            }
+            for (uint32_t t = 0; t < m.triangleCount * 3; ++t) {
+                if (data.triangles[m.triangleOffset + t] >= m.vertexCount) local = false;
+            }
+            if (!local) {
+                fail(at + " has out of range vertex");
+                continue;
+            }
+            for (uint32_t t = 0; t < m.triangleCount; ++t) {
+                const uint8_t* tri = &data.triangles[m.triangleOffset + t * 3];
+                built[m.submesh].push_back(Canonical(data.vertices[m.vertexOffset + tri[0]],
+                    data.vertices[m.vertexOffset + tri[1]], data.vertices[m.vertexOffset + tri[2]]));
+            }
+
+            // 球が全頂点を包むか
+            for (uint32_t v = 0; v < m.vertexCount; ++v) {
+                const ModelVertex& p = vertices[data.vertices[m.vertexOffset + v]];
+                const double d = Length(Sub(Pos(p), { m.center[0], m.center[1], m.center[2] }));
+                if (d > m.radius) {
+                    report.maxSphereExcess = std::max(report.maxSphereExcess, (d - m.radius) / std::max((double)m.radius, 1e-12));
+                }
+            }
+        }
+        if (report.maxSphereExcess > 0.0) fail("vertex outside bounding sphere");
+        if (report.meshletCount) {
+            report.avgVertices = (double)totalVertices / report.meshletCount;
+            report.avgTriangles = (double)totalTriangles / report.meshletCount;
+        }
+
+        // 網羅: 元の三角形とメッシュレットの三角形を並べて突き合わせる
+        for (size_t s = 0; s < submeshes.size(); ++s) {
+            const SubMesh& sm = submeshes[s];
+            if ((uint64_t)sm.indexOffset + sm.indexCount > indices.size()) {
+                fail("submesh " + std::to_string(s) + " out of bounds");
+                continue;
+            }
+            std::vector<std::array<uint32_t, 3>> original;
+            original.reserve(sm.indexCount / 3);
+            for (uint32_t t = 0; t + 2 < sm.indexCount; t += 3) {
+                const uint32_t* tri = &indices[sm.indexOffset + t];
+                original.push_back(Canonical(tri[0], tri[1], tri[2]));
+            }
+            report.triangleCount += (uint32_t)original.size();
+            std::vector<std::array<uint32_t, 3>>& got = built[s];
+            std::sort(original.begin(), original.end());
+            std::sort(got.begin(), got.end());
+            size_t i = 0, j = 0;
+            while (i < original.size() || j < got.size()) {
+                if (j >= got.size() || (i < original.size() && original[i] < got[j])) { report.missingTriangles++; i++; }
+                else if (i >= original.size() || got[j] < original[i]) { report.duplicatedTriangles++; j++; }
+                else { i++; j++; }
+            }
+        }
+        if (report.missingTriangles) fail(std::to_string(report.missingTriangles) + " triangles missing");
+        if (report.duplicatedTriangles) fail(std::to_string(report.duplicatedTriangles) + " triangles duplicated");
+
+        // 円錐: 裏と判定した視点から、表を向いた三角形が無いこと
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        for (const Meshlet& m : data.meshlets) {
+            if (m.coneCutoff >= 1.0f || m.vertexCount == 0 ||
+                (uint64_t)m.triangleOffset + (uint64_t)m.triangleCount * 3 > data.triangles.size() ||
+                (uint64_t)m.vertexOffset + m.vertexCount > data.vertices.size()) continue;
+            for (int k = 0; k < 16; ++k) {
+                // 球の周り (近く〜遠く) と軸の真後ろ
+                float view[3];
+                const float dist = (k == 0) ? 1.5f : (k == 1 ? 50.0f : 1.0f + 4.0f * (unit(rng) + 1.0f));
+                for (int a = 0; a < 3; ++a) {
+                    const float dir = (k < 2) ? -m.coneAxis[a] : unit(rng);
+                    view[a] = m.center[a] + dir * m.radius * dist;
+                }
+                if (!ConeCulled(m, view)) continue;
+                const Vec3 eye{ view[0], view[1], view[2] };
+                for (uint32_t t = 0; t < m.triangleCount; ++t) {
+                    const uint8_t* tri = &data.triangles[m.triangleOffset + t * 3];
+                    const Vec3 p0 = Pos(vertices[data.vertices[m.vertexOffset + tri[0]]]);
+                    const Vec3 n = Cross(Sub(Pos(vertices[data.vertices[m.vertexOffset + tri[1]]]), p0),
+                        Sub(Pos(vertices[data.vertices[m.vertexOffset + tri[2]]]), p0));
+                    // 表: 視点が面の法線側にある
+                    const Vec3 toEye = Sub(eye, p0);
+                    if (Dot(n, toEye) > 1e-7 * Length(n) * Length(toEye)) report.coneViolations++;
+                }
+            }
+        }
+        if (report.coneViolations) fail(std::to_string(report.coneViolations) + " cone violations");
+        return report.passed;
+    }
+
+    bool SelfTest(std::string& log) {
+        std::mt19937 rng(99);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        auto vertex = [](float x, float y, float z) {
+            ModelVertex v{};
+            v.position[0] = x; v.position[1] = y; v.position[2] = z;
+            return v;
+        };
+        // n x n の格子 (z に起伏)
+        auto grid = [&](uint32_t n, float ox, std::vector<ModelVertex>& vs, std::vector<uint32_t>& is) {
+            const uint32_t base = (uint32_t)vs.size();
+            for (uint32_t y = 0; y <= n; ++y) {
+                for (uint32_t x = 0; x <= n; ++x) {
+                    vs.push_back(vertex(ox + (float)x, (float)y, 0.3f * std::sin(x * 0.37f) * std::cos(y * 0.21f)));
+                }
+            }
+            for (uint32_t y = 0; y < n; ++y) {
+                for (uint32_t x = 0; x < n; ++x) {
+                    const uint32_t a = base + y * (n + 1) + x, b = a + 1, c = a + n + 1, d = c + 1;
+                    is.insert(is.end(), { a, c, b, b, c, d });
+                }
+            }
+        };
+        // 緯度経度の球
+        auto sphere = [&](uint32_t seg, std::vector<ModelVertex>& vs, std::vector<uint32_t>& is) {
+            const uint32_t base = (uint32_t)vs.size();
+            for (uint32_t i = 0; i <= seg; ++i) {
+                const double th = kPi * i / seg;
+                for (uint32_t j = 0; j <= seg * 2; ++j) {
+                    const double ph = kPi * j / seg;
+                    vs.push_back(vertex((float)(std::sin(th) * std::cos(ph)), (float)std::cos(th), (float)(std::sin(th) * std::sin(ph))));
+                }
+            }
+            const uint32_t w = seg * 2 + 1;
+            for (uint32_t i = 0; i < seg; ++i) {
+                for (uint32_t j = 0; j < seg * 2; ++j) {
+                    const uint32_t a = base + i * w + j, b = a + 1, c = a + w, d = c + 1;
+                    is.insert(is.end(), { a, b, c, b, d, c });
+                }
+            }
+        };
+
+        struct Case {
+            std::string name;
+            std::vector<ModelVertex> vertices;
+            std::vector<uint32_t> indices;
+            std::vector<SubMesh> submeshes;
+        };
+        std::vector<Case> cases;
+        auto single = [](Case& c) {
+            SubMesh sm;
+            sm.indexCount = (uint32_t)c.indices.size();
+            sm.vertexCount = (uint32_t)c.vertices.size();
+            c.submeshes = { sm };
+        };
+        { Case c; c.name = "grid 64x64"; grid(64, 0.0f, c.vertices, c.indices); single(c); cases.push_back(std::move(c)); }
+        { Case c; c.name = "sphere 48"; sphere(48, c.vertices, c.indices); single(c); cases.push_back(std::move(c)); }
+        {
+            // 乱雑な三角形 (隣り合わない, 頂点を共有しない物も多い)
+            Case c; c.name = "random soup";
+            for (int i = 0; i < 3000; ++i) c.vertices.push_back(vertex(unit(rng) * 10, unit(rng) * 10, unit(rng) * 10));
+            for (int i = 0; i < 6000; ++i) c.indices.push_back(rng() % 3000);
+            single(c); cases.push_back(std::move(c));
+        }
+        {
+            // 潰れた三角形 (同じ頂点 / 一直線) と 1 つだけの三角形
+            Case c; c.name = "degenerate";
+            grid(8, 0.0f, c.vertices, c.indices);
+            c.indices.insert(c.indices.end(), { 0, 0, 0, 1, 1, 2, 0, 1, 2 });
+            single(c);
+            SubMesh one;
+            one.indexOffset = (uint32_t)c.indices.size();
+            c.indices.insert(c.indices.end(), { 3, 4, 12 });
+            one.indexCount = 3;
+            c.submeshes.push_back(one);
+            cases.push_back(std::move(c));
+        }
+        {
+            // 複数サブメッシュ (離れた頂点範囲, 空, 3 の倍数でない余り)
+            Case c; c.name = "3 submeshes";
+            for (int s = 0; s < 3; ++s) {
+                SubMesh sm;
+                sm.indexOffset = (uint32_t)c.indices.size();
+                sm.vertexOffset = (uint32_t)c.vertices.size();
+                if (s != 1) grid(20 + s * 7, 100.0f * s, c.vertices, c.indices);
+                sm.indexCount = (uint32_t)c.indices.size() - sm.indexOffset;
+                sm.vertexCount = (uint32_t)c.vertices.size() - sm.vertexOffset;
+                c.submeshes.push_back(sm);
+            }
+            c.indices.push_back(0); // どの三角形にも入らない余り
+            cases.push_back(std::move(c));
+        }
+
+        bool ok = true;
+        char line[256];
+        for (const Case& c : cases) {
+            MeshletData data;
+            std::string error;
+            MeshletReport r;
+            const bool built = Build(c.vertices, c.indices, c.submeshes, data, error);
+            const bool valid = built && Validate(c.vertices, c.indices, c.submeshes, data, r);
+            ok = ok && valid;
+            snprintf(line, sizeof(line), "%-14s %6u tris -> %5u meshlets (avg %.1f v / %.1f t)  %s %s\n",
+                c.name.c_str(), r.triangleCount, r.meshletCount, r.avgVertices, r.avgTriangles,
+                valid ? "PASS" : "FAIL", built ? r.failure.c_str() : error.c_str());
+            log += line;
+        }
+
+        // 壊したものを見つけるか
+        {
+            const Case& c = cases[0];
+            MeshletData data;
+            std::string error;
+            Build(c.vertices, c.indices, c.submeshes, data, error);
+            struct Corruption { const char* name; void (*apply)(MeshletData&); };
+            const Corruption corruptions[] = {
+                { "dropped triangle", [](MeshletData& d) { d.meshlets[0].triangleCount--; } },
+                { "duplicated triangle", [](MeshletData& d) { memcpy(&d.triangles[d.meshlets[0].triangleOffset + 3], &d.triangles[d.meshlets[0].triangleOffset], 3); } },
+                { "flipped winding", [](MeshletData& d) { std::swap(d.triangles[d.meshlets[1].triangleOffset + 1], d.triangles[d.meshlets[1].triangleOffset + 2]); } },
+                { "shrunk sphere", [](MeshletData& d) { d.meshlets[2].radius *= 0.9f; } },
+                { "inverted cone", [](MeshletData& d) { for (float& a : d.meshlets[3].coneAxis) a = -a; } },
+            };
+            for (const Corruption& k : corruptions) {
+                MeshletData broken = data;
+                k.apply(broken);
+                MeshletReport r;
+                const bool detected = !Validate(c.vertices, c.indices, c.submeshes, broken, r);
+                ok = ok && detected;
+                snprintf(line, sizeof(line), "%-20s detected: %s (%s)\n", k.name, detected ? "PASS" : "FAIL", r.failure.c_str());
+                log += line;
+            }
+        }
+
+        // 作成時間 (大きな格子, 3 回の最小)
+        {
+            std::vector<ModelVertex> vs;
+            std::vector<uint32_t> is;
+            grid(512, 0.0f, vs, is);
+            std::vector<SubMesh> sms(1);
+            sms[0].indexCount = (uint32_t)is.size();
+            sms[0].vertexCount = (uint32_t)vs.size();
+            double best = 1e30;
+            MeshletData data;
+            for (int round = 0; round < 3; ++round) {
+                std::string error;
+                const auto t0 = std::chrono::steady_clock::now();
+                Build(vs, is, sms, data, error);
+                best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count());
+            }
+            const double tris = is.size() / 3.0;
+            snprintf(line, sizeof(line), "benchmark grid 512x512: %.0f tris -> %zu meshlets in %.1f ms (%.2f Mtris/s)\n",
+                tris, data.meshlets.size(), best, best > 0.0 ? tris / best / 1000.0 : 0.0);
+            log += line;
+        }
+        return ok;
+    }
+
+} // namespace MeshletBuilder
@@ -0,0 +1,58 @@
+// MeshletBuilder
+// サブメッシュの三角形を最大 kMaxVertices 頂点 / kMaxTriangles 三角形のメッシュレットへ分け、
+// メッシュレット毎に包む球と法線の円錐を求める (MeshletData, AssetTypes.h)。
+//   分け方: まだ使っていない三角形から始め、今のメッシュレットの頂点を共有する三角形のうち
+//           新しく増える頂点の少ないものを順に足す (隣り合う三角形がまとまるように)
+//   円錐  : 三角形の面法線 (p1 - p0) x (p2 - p0) の向き。表裏の向きは描画側の表面の定義と合わせて使う
+// 調理済みモデル (.pixmesh) に保存し、CPU でのカリング (ConeCulled / 球と視錐台) に使う
+
+#ifndef MESHLETBUILDER_H
+#define MESHLETBUILDER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "AssetTypes.h"
+
+// メッシュレットを元の三角形と比べた結果 (Validate)
+struct MeshletReport {
+    uint32_t meshletCount = 0;
+    uint32_t triangleCount = 0;          // 元の三角形
+    uint32_t missingTriangles = 0;       // どのメッシュレットにも入っていない
+    uint32_t duplicatedTriangles = 0;    // 2 回以上入っている / 元に無い
+    double avgVertices = 0.0;
+    double avgTriangles = 0.0;
+    double maxSphereExcess = 0.0;        // 球の外に出た頂点の距離 (半径比)
+    uint32_t coneViolations = 0;         // 裏と判定した視点から表が見える三角形
+    double buildMs = 0.0;                // ModelManager が測った作成時間
+    bool validated = false;              // Validate を通した (調理時は作るだけで、検証はレポート / 自己診断で行う)
+    bool passed = true;
+    std::string failure;
+};
+
+namespace MeshletBuilder {
+
+    constexpr uint32_t kMaxVertices = 64;
+    constexpr uint32_t kMaxTriangles = 124;
+
+    // 全サブメッシュのメッシュレットを作る (Meshlet::submesh にサブメッシュ番号)。
+    // サブメッシュがインデックス / 頂点の範囲外を指していれば false
+    bool Build(const std::vector<ModelVertex>& vertices, const std::vector<uint32_t>& indices,
+        const std::vector<SubMesh>& submeshes, MeshletData& out, std::string& error);
+
+    // viewPos (モデル空間) から見てメッシュレットの三角形が全て裏向きなら true
+    bool ConeCulled(const Meshlet& m, const float viewPos[3]);
+
+    // 全ての三角形がちょうど 1 回ずつ (同じ向きで) 入っているか、上限、球が頂点を包むか、
+    // 乱数の視点で円錐の判定が保守的かを調べる
+    bool Validate(const std::vector<ModelVertex>& vertices, const std::vector<uint32_t>& indices,
+        const std::vector<SubMesh>& submeshes, const MeshletData& data, MeshletReport& report);
+
+    // 格子 / 球 / 乱雑な三角形 / 潰れた三角形 / 複数サブメッシュを Build → Validate し、
+    // 三角形を抜く / 重ねる等で壊したものを Validate が見つけるかも確かめる。
+    // 大きな格子で作成時間も測る。結果を log へ書く
+    bool SelfTest(std::string& log);
+
+} // namespace MeshletBuilder
+
+#endif // MESHLETBUILDER_H
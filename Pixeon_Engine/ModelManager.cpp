@@ -11,6 +11,10 @@
 #include "IMGUI/imgui.h"
 #include <filesystem>
 #include <unordered_set>
+#include <fstream>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
 
 #if _MSC_VER >= 1930
 #ifdef _DEBUG
@@ -62,39 +66,150 @@ void ModelManager::DeleteInstance() {
 void ModelManager::UnInit() {
     std::lock_guard<std::mutex> lk(m_mtx);
     m_cache.clear();
+    m_loading.clear();
     m_frame = 0;
 }
 
 std::shared_ptr<ModelSharedResource> ModelManager::LoadOrGet(const std::string& logicalName) {
-    std::lock_guard<std::mutex> lk(m_mtx);
-    m_frame++;
-
-    auto it = m_cache.find(logicalName);
-    if (it != m_cache.end()) {
-        if (auto sp = it->second.weak.lock()) {
-            it->second.lastUse = m_frame;
-            return sp;
+    std::shared_future<std::shared_ptr<ModelSharedResource>> pending;
+    std::promise<std::shared_ptr<ModelSharedResource>> promise;
+    {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        m_frame++;
+
+        auto it = m_cache.find(logicalName);
+        if (it != m_cache.end()) {
+            if (auto sp = it->second.weak.lock()) {
+                it->second.lastUse = m_frame;
+                return sp;
+            }
         }
+        auto lt = m_loading.find(logicalName);
+        if (lt != m_loading.end()) pending = lt->second;
+        else m_loading[logicalName] = promise.get_future().share();
     }
+    // 他スレッドが読み込み中なら完了を待つ (他のモデルの検索はブロックしない)
+    if (pending.valid()) return pending.get();
 
+    // Assimp の読み込みと GPU バッファ生成はロックの外で行う
     auto res = LoadInternal(logicalName);
-    if (res) {
-        Entry e;
-        e.weak = res;
-        e.lastUse = m_frame;
-        e.gpuBytes = res->gpuBytes;
-        m_cache[logicalName] = e;
+    {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        if (res) {
+            Entry e;
+            e.weak = res;
+            e.lastUse = m_frame;
+            e.gpuBytes = res->gpuBytes;
+            m_cache[logicalName] = e;
+        }
+        m_loading.erase(logicalName);
     }
+    promise.set_value(res);
     return res;
 }
 
 std::shared_ptr<ModelSharedResource> ModelManager::LoadInternal(const std::string& logicalName) {
-    std::vector<uint8_t> data;
-    if (!AssetManager::Instance()->LoadAsset(logicalName, data) || data.empty()) {
+    // 調理済みモデルがあれば Assimp を通さない
+    if (m_useCooked) {
+        if (auto res = LoadCooked(logicalName)) return res;
+    }
+
+    AssetView data = AssetManager::Instance()->AcquireAsset(logicalName);
+    if (!data || data.empty()) {
 		ErrorLogger::Instance().LogError("ModelManager", "Failed to load model asset: " + logicalName);
         return nullptr;
     }
 
+    ModelMeshData mesh;
+    if (!ImportWithAssimp(logicalName, data, mesh)) return nullptr;
+    m_assimpLoads++;
+    // メッシュレットは書き出す .pixmesh のためだけに作る (描画ではまだ使わない)
+    const bool cook = m_autoCook && AssetManager::Instance()->GetLoadMode() == AssetManager::LoadMode::FromSource;
+    if (cook && m_buildMeshlets) BuildMeshlets(logicalName, mesh);
+
+    PackedVertices packed;
+    const bool usePacked = m_vertexPacking && PackMesh(logicalName, mesh, packed);
+
+    // 詰めたインデックスの検証は .pixmesh へ書く時だけ行う
+    const uint32_t vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+    const uint32_t indexCount = static_cast<uint32_t>(mesh.indices.size());
+    std::vector<uint8_t> packedIndices;
+    const PackedIndexView indices = PrepareIndices(logicalName, mesh.indices.data(), indexCount, mesh.submeshes, packedIndices, cook);
+
+    if (cook) {
+        WriteCooked(logicalName, data, mesh, indices, usePacked ? &packed : nullptr);
+    }
+
+    if (usePacked) {
+        return BuildResource(logicalName, mesh, packed.base.data(), vertexCount, indices, indexCount,
+            packed.layout, packed.skin.empty() ? nullptr : packed.skin.data());
+    }
+    return BuildResource(logicalName, mesh, mesh.vertices.data(), vertexCount, indices, indexCount);
+}
+
+bool ModelManager::PackMesh(const std::string& logicalName, ModelMeshData& mesh, PackedVertices& packed) {
+    std::string error;
+    std::vector<SubMesh> submeshes = mesh.submeshes;
+    if (!VertexPack::Pack(mesh.vertices, mesh.indices, submeshes, mesh.hasSkin, m_quantizePositions, m_splitPositionStream, packed, error)) {
+        OutputDebugStringA(("[ModelManager] Vertex packing skipped: " + logicalName + " (" + error + ")\n").c_str());
+        return false;
+    }
+    VertexPackReport report;
+    const bool ok = VertexPack::Validate(mesh.vertices, submeshes, packed, report);
+    {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        m_packReports[logicalName] = report;
+    }
+    if (!ok) {
+        OutputDebugStringA(("[ModelManager] Vertex packing exceeded tolerance: " + logicalName + " (" + report.failure + ")\n").c_str());
+        return false;
+    }
+    mesh.submeshes = std::move(submeshes);
+    return true;
+}
+
+bool ModelManager::BuildMeshlets(const std::string& logicalName, ModelMeshData& mesh, bool validate) {
+    MeshletReport report;
+    std::string error;
+    const auto t0 = std::chrono::steady_clock::now();
+    if (!MeshletBuilder::Build(mesh.vertices, mesh.indices, mesh.submeshes, mesh.meshlets, error)) {
+        report.passed = false;
+        report.failure = error;
+    }
+    else {
+        report.buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        if (validate) {
+            report.validated = true;
+            MeshletBuilder::Validate(mesh.vertices, mesh.indices, mesh.submeshes, mesh.meshlets, report);
+        }
+        else {
+            // 検証しない時も表に出す数だけは数える
+            report.meshletCount = (uint32_t)mesh.meshlets.meshlets.size();
+            uint64_t vertices = 0, triangles = 0;
+            for (const Meshlet& m : mesh.meshlets.meshlets) {
+                vertices += m.vertexCount;
+                triangles += m.triangleCount;
+            }
+            report.triangleCount = (uint32_t)triangles;
+            if (report.meshletCount) {
+                report.avgVertices = (double)vertices / report.meshletCount;
+                report.avgTriangles = (double)triangles / report.meshletCount;
+            }
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        m_meshletReports[logicalName] = report;
+    }
+    if (!report.passed) {
+        OutputDebugStringA(("[ModelManager] Meshlet build failed: " + logicalName + " (" + report.failure + ")\n").c_str());
+        mesh.meshlets = MeshletData{};
+        return false;
+    }
+    return true;
+}
+
+bool ModelManager::ImportWithAssimp(const std::string& logicalName, const AssetView& data, ModelMeshData& mesh) {
     Assimp::Importer importer;
     const aiScene* scene = importer.ReadFileFromMemory(
         data.data(), data.size(),
@@ -110,32 +225,356 @@ std::shared_ptr<ModelSharedResource> ModelManager::LoadInternal(const std::strin
     if (!scene || !scene->mRootNode) {
         ErrorLogger::Instance().LogError("ModelManager", "Assimp parse failed: " + logicalName + 
 			(importer.GetErrorString()[0] ? (" (" + std::string(importer.GetErrorString()) + ")") : ""));
-        return nullptr;
+        return false;
     }
 
+    ProcessNode(scene->mRootNode, scene, mesh);
+
+    ProcessMaterials(scene, mesh);
+
+    ProcessBones(scene, mesh);
+
+    ProcessAnimations(scene, mesh);
+    return true;
+}
+
+std::shared_ptr<ModelSharedResource> ModelManager::BuildResource(const std::string& logicalName, ModelMeshData& tables,
+    const void* vertices, uint32_t vertexCount, const PackedIndexView& indices, uint32_t indexCount,
+    const PackedVertexLayout& layout, const void* skin) {
+
     auto shared = std::make_shared<ModelSharedResource>();
     shared->source = logicalName;
+    shared->indexFormat = indices.format;
 
-    std::vector<ModelVertex> vertices;
-    std::vector<uint32_t> indices;
+    if (!CreateGPUBuffers(vertices, vertexCount, indices.data, indexCount, indices.size, layout, skin, shared)) {
+		ErrorLogger::Instance().LogError("ModelManager", "GPU buffer creation failed: " + logicalName);
+        return nullptr;
+    }
 
-    ProcessNode(scene->mRootNode, scene, vertices, indices, shared);
+    // テクスチャのパスはモデルに書かれたまま持っているので、ここで論理名へ解決する
+    for (auto& m : tables.materials) {
+        m.baseColorTex = ResolveTexturePath(logicalName, m.baseColorTex);
+    }
+    shared->submeshes = std::move(tables.submeshes);
+    shared->materials = std::move(tables.materials);
+    shared->bones = std::move(tables.bones);
+    shared->clips = std::move(tables.clips);
+    shared->meshlets = std::move(tables.meshlets);
+    shared->hasSkin = tables.hasSkin;
+
+    size_t vertexStride = 0;
+    for (const VertexStream& stream : shared->streams) vertexStride += stream.stride;
+    shared->gpuBytes = (size_t)vertexCount * vertexStride + shared->indexBytes;
+    return shared;
+}
 
-    if (!CreateGPUBuffers(vertices, indices, shared)) {
-		ErrorLogger::Instance().LogError("ModelManager", "GPU buffer creation failed: " + logicalName);
+PackedIndexView ModelManager::PrepareIndices(const std::string& logicalName, const uint32_t* indices, uint32_t indexCount,
+    std::vector<SubMesh>& submeshes, std::vector<uint8_t>& packed, bool validate) {
+    packed.clear();
+    IndexBufferFormat format = IndexBufferFormat::UInt32;
+    if (m_indexPacking) {
+        std::vector<SubMesh> sms = submeshes;
+        std::string error;
+        IndexPackReport report;
+        if (!IndexPack::Pack(indices, indexCount, sms, true, packed, format, error)) {
+            report.passed = false;
+            report.failure = error;
+        }
+        else if (validate) {
+            IndexPack::Validate(indices, indexCount, sms, packed, format, report);
+        }
+        else {
+            IndexPack::Describe(indexCount, sms, packed.size(), format, report);
+        }
+        {
+            std::lock_guard<std::mutex> lk(m_mtx);
+            m_indexReports[logicalName] = report;
+        }
+        if (report.passed) {
+            submeshes = std::move(sms);
+            return PackedIndexView{ packed.data(), packed.size(), format };
+        }
+        OutputDebugStringA(("[ModelManager] Index packing skipped: " + logicalName + " (" + report.failure + ")\n").c_str());
+        packed.clear();
+        format = IndexBufferFormat::UInt32;
+    }
+    // 元の uint32 (頂点バッファ先頭からの番号) のまま
+    for (SubMesh& sm : submeshes) {
+        sm.baseVertex = 0;
+        sm.indexStart = sm.indexOffset;
+        sm.index16 = false;
+    }
+    return PackedIndexView{ reinterpret_cast<const uint8_t*>(indices), (size_t)indexCount * sizeof(uint32_t), format };
+}
+
+std::shared_ptr<ModelSharedResource> ModelManager::LoadCooked(const std::string& logicalName) {
+    AssetManager* am = AssetManager::Instance();
+    const std::string cookedName = CookedName(logicalName);
+    if (!am->Exists(cookedName)) return nullptr;
+
+    AssetView view = am->AcquireAsset(cookedName);
+    if (!view || view.empty()) return nullptr;
+
+    CookedMeshView cooked;
+    ModelMeshData tables;
+    std::string error;
+    if (!MeshCook::Read(view.data(), view.size(), cooked, tables, error)) {
+        m_cookedRejected++;
+        OutputDebugStringA(("[ModelManager] Cooked mesh rejected: " + cookedName + " (" + error + ")\n").c_str());
+        return nullptr;
+    }
+    if (!IsCookedCurrent(logicalName, cooked.header)) {
+        m_cookedRejected++;
+        OutputDebugStringA(("[ModelManager] Cooked mesh is stale: " + cookedName + "\n").c_str());
         return nullptr;
     }
 
-    ProcessMaterials(scene, shared);
+    // 頂点 / インデックスはアセットのビューからそのまま GPU バッファへ渡す。
+    // ファイルの頂点形式と今の設定 (詰める / 詰めない) が違う時だけ変換する
+    const uint32_t vertexCount = cooked.header.vertexCount;
+    const uint32_t indexCount = cooked.header.indexCount;
+    // メッシュレットの無いファイル (作る前に調理したもの) は読み込みでは作らない。
+    // 自動調理が有効なら使わずに Assimp から読み直し、書き出す時に作る (それ以外は空のまま使う)
+    if (m_buildMeshlets && tables.meshlets.meshlets.empty() && !tables.submeshes.empty() && m_autoCook &&
+        am->GetLoadMode() == AssetManager::LoadMode::FromSource && am->Exists(logicalName)) {
+        m_cookedRejected++;
+        OutputDebugStringA(("[ModelManager] Cooked mesh has no meshlets, re-cooking: " + cookedName + "\n").c_str());
+        return nullptr;
+    }
+    // インデックス。版 4 は調理時に詰めて検証した配置のまま GPU へ渡す (詰めない設定で u16 を含む時だけ戻す)。
+    // 版 3 までは uint32 のインデックスを 4 バイト境界のバッファへ写してから詰める (検証はしない)
+    PackedIndexView indices = cooked.packedIndices;
+    std::vector<uint8_t> packedIndices;
+    auto loadAbsoluteIndices = [&] {
+        if (!tables.indices.empty() || indexCount == 0) return;
+        if (cooked.indices) {
+            tables.indices.resize(indexCount);
+            memcpy(tables.indices.data(), cooked.indices, (size_t)indexCount * sizeof(uint32_t));
+        }
+        else {
+            IndexPack::Unpack(cooked.packedIndices.data, cooked.packedIndices.size, tables.submeshes, tables.indices);
+            tables.indices.resize(indexCount);
+        }
+    };
+    if (indices.data && (m_indexPacking || indices.format == IndexBufferFormat::UInt32)) {
+        if (m_indexPacking) {
+            IndexPackReport report;
+            IndexPack::Describe(indexCount, tables.submeshes, indices.size, indices.format, report);
+            std::lock_guard<std::mutex> lk(m_mtx);
+            m_indexReports[logicalName] = report;
+        }
+    }
+    else {
+        loadAbsoluteIndices();
+        indices = PrepareIndices(logicalName, tables.indices.data(), indexCount, tables.submeshes, packedIndices, false);
+    }
 
-    ProcessBones(scene, shared);
+    std::shared_ptr<ModelSharedResource> res;
+    if (cooked.layout.baseStride != 0 && !m_vertexPacking) {
+        VertexPack::Unpack(cooked.layout, cooked.vertices, cooked.skin, vertexCount, tables.submeshes, tables.vertices);
+        res = BuildResource(logicalName, tables, tables.vertices.data(), vertexCount, indices, indexCount);
+    }
+    else if (cooked.layout.baseStride == 0 && m_vertexPacking) {
+        tables.vertices.resize(vertexCount);
+        memcpy(tables.vertices.data(), cooked.vertices, (size_t)vertexCount * sizeof(ModelVertex));
+        loadAbsoluteIndices();
+        PackedVertices packed;
+        if (PackMesh(logicalName, tables, packed)) {
+            res = BuildResource(logicalName, tables, packed.base.data(), vertexCount, indices, indexCount,
+                packed.layout, packed.skin.empty() ? nullptr : packed.skin.data());
+        }
+        else {
+            res = BuildResource(logicalName, tables, cooked.vertices, vertexCount, indices, indexCount);
+        }
+    }
+    else if (cooked.layout.baseStride != 0 &&
+        ((cooked.layout.flags & VertexPack_SplitPosition) != 0) != m_splitPositionStream) {
+        // 位置の分け方だけが違う (並べ替えのみ)
+        PackedVertexLayout layout;
+        std::vector<uint8_t> base;
+        VertexPack::SetSplitPosition(cooked.layout, cooked.vertices, vertexCount, m_splitPositionStream, layout, base);
+        res = BuildResource(logicalName, tables, base.data(), vertexCount, indices, indexCount,
+            layout, cooked.skin);
+    }
+    else {
+        res = BuildResource(logicalName, tables, cooked.vertices, vertexCount, indices, indexCount,
+            cooked.layout, cooked.skin);
+    }
+    if (res) m_cookedLoads++;
+    return res;
+}
 
-    ProcessAnimations(scene, shared);
+static uint64_t MM_SourceWriteTime(const std::filesystem::path& path) {
+    std::error_code ec;
+    const auto t = std::filesystem::last_write_time(path, ec);
+    return ec ? 0 : (uint64_t)t.time_since_epoch().count();
+}
 
-    shared->gpuBytes = vertices.size() * sizeof(ModelVertex) + indices.size() * sizeof(uint32_t);
+bool ModelManager::IsCookedCurrent(const std::string& logicalName, const MeshFileHeader& header, bool* hashed) {
+    if (hashed) *hashed = false;
+    AssetManager* am = AssetManager::Instance();
+    // アーカイブは同じ時点のソースから作られているので、元のモデルと比べずに使う
+    if (am->GetLoadMode() == AssetManager::LoadMode::FromArchive) return true;
+
+    // ソースフォルダでは元のモデルが書き換えられていないか、サイズと更新時刻で確かめる。
+    // 更新時刻が違う (触っただけ / コピーし直した) か記録の無い古いファイルの時だけ中身をハッシュする
+    std::error_code ec;
+    const std::filesystem::path sourcePath = std::filesystem::path(am->GetRoot()) / logicalName;
+    if (!std::filesystem::exists(sourcePath, ec)) return true; // 調理済みだけ置いてある
+    const uintmax_t size = std::filesystem::file_size(sourcePath, ec);
+    if (ec || size != header.sourceSize) return false;
+    if (header.sourceWriteTime != 0 && MM_SourceWriteTime(sourcePath) == header.sourceWriteTime) return true;
+
+    if (hashed) *hashed = true;
+    AssetView source = am->AcquireAsset(logicalName);
+    if (!source) return false;
+    return HashUtil::Hash64(source.data(), source.size()) == header.sourceHash;
+}
 
-	//ErrorLogger::Instance().LogError("ModelManager", "Load OK: " + logicalName, false, 5);
-    return shared;
+bool ModelManager::WriteCooked(const std::string& logicalName, const AssetView& source, const ModelMeshData& mesh,
+    const PackedIndexView& indices, const PackedVertices* packed) {
+    AssetManager* am = AssetManager::Instance();
+    if (am->GetLoadMode() != AssetManager::LoadMode::FromSource || am->GetRoot().empty()) return false;
+
+    std::vector<uint8_t> bytes;
+    MeshCook::Write(mesh, indices, source.size(), HashUtil::Hash64(source.data(), source.size()),
+        MM_SourceWriteTime(std::filesystem::path(am->GetRoot()) / logicalName), bytes, packed);
+
+    // 書きかけのファイルを読まれないように一時ファイルへ書いてから置き換える
+    const std::filesystem::path outPath = std::filesystem::path(am->GetRoot()) / CookedName(logicalName);
+    std::filesystem::path tmpPath = outPath;
+    tmpPath += ".tmp";
+    {
+        std::ofstream ofs(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!ofs) {
+            ErrorLogger::Instance().LogError("ModelManager", "Failed to write cooked mesh: " + tmpPath.string());
+            return false;
+        }
+        ofs.write(reinterpret_cast<const char*>(bytes.data()), (std::streamsize)bytes.size());
+        if (!ofs) {
+            ErrorLogger::Instance().LogError("ModelManager", "Failed to write cooked mesh: " + tmpPath.string());
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, outPath, ec);
+    if (ec) {
+        std::filesystem::remove(tmpPath, ec);
+        ErrorLogger::Instance().LogError("ModelManager", "Failed to replace cooked mesh: " + outPath.string());
+        return false;
+    }
+    OutputDebugStringA(("[ModelManager] Cooked " + logicalName + " (" + std::to_string(bytes.size()) + " bytes)\n").c_str());
+    return true;
+}
+
+bool ModelManager::CookModel(const std::string& logicalName) {
+    AssetManager* am = AssetManager::Instance();
+    if (am->GetLoadMode() != AssetManager::LoadMode::FromSource) {
+        ErrorLogger::Instance().LogError("ModelManager", "CookModel requires FromSource mode: " + logicalName);
+        return false;
+    }
+    AssetView data = am->AcquireAsset(logicalName);
+    if (!data || data.empty()) {
+        ErrorLogger::Instance().LogError("ModelManager", "Failed to load model asset: " + logicalName);
+        return false;
+    }
+    ModelMeshData mesh;
+    if (!ImportWithAssimp(logicalName, data, mesh)) return false;
+    if (m_buildMeshlets) BuildMeshlets(logicalName, mesh);
+    PackedVertices packed;
+    const bool usePacked = m_vertexPacking && PackMesh(logicalName, mesh, packed);
+    std::vector<uint8_t> packedIndices;
+    const PackedIndexView indices = PrepareIndices(logicalName, mesh.indices.data(), (uint32_t)mesh.indices.size(),
+        mesh.submeshes, packedIndices, true);
+    return WriteCooked(logicalName, data, mesh, indices, usePacked ? &packed : nullptr);
+}
+
+void ModelManager::ReportVertexPacking() {
+    for (const std::string& name : AssetManager::Instance()->GetCachedAssetNames(true)) {
+        AssetView data = AssetManager::Instance()->AcquireAsset(name);
+        if (!data || data.empty()) continue;
+        ModelMeshData mesh;
+        if (!ImportWithAssimp(name, data, mesh)) continue;
+        PackedVertices packed;
+        PackMesh(name, mesh, packed); // 結果は m_packReports へ入る
+    }
+}
+
+void ModelManager::ReportIndexPacking() {
+    for (const std::string& name : AssetManager::Instance()->GetCachedAssetNames(true)) {
+        AssetView data = AssetManager::Instance()->AcquireAsset(name);
+        if (!data || data.empty()) continue;
+        ModelMeshData mesh;
+        if (!ImportWithAssimp(name, data, mesh)) continue;
+        std::vector<uint8_t> packed;
+        PrepareIndices(name, mesh.indices.data(), (uint32_t)mesh.indices.size(), mesh.submeshes, packed, true); // 結果は m_indexReports へ入る
+    }
+}
+
+void ModelManager::ReportMeshlets() {
+    for (const std::string& name : AssetManager::Instance()->GetCachedAssetNames(true)) {
+        AssetView data = AssetManager::Instance()->AcquireAsset(name);
+        if (!data || data.empty()) continue;
+        ModelMeshData mesh;
+        if (!ImportWithAssimp(name, data, mesh)) continue;
+        BuildMeshlets(name, mesh, true); // 結果は m_meshletReports へ入る
+    }
+}
+
+size_t ModelManager::CookAllModels() {
+    size_t cooked = 0;
+    for (const std::string& name : AssetManager::Instance()->GetCachedAssetNames(true)) {
+        if (CookModel(name)) cooked++;
+    }
+    return cooked;
+}
+
+std::vector<ModelManager::CookBenchResult> ModelManager::BenchmarkCooked(int rounds) {
+    using Clock = std::chrono::steady_clock;
+    auto elapsedMs = [](Clock::time_point t0) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    };
+    if (rounds < 1) rounds = 1;
+
+    std::vector<CookBenchResult> results;
+    AssetManager* am = AssetManager::Instance();
+    for (const std::string& name : am->GetCachedAssetNames(true)) {
+        const std::string cookedName = CookedName(name);
+        if (!am->Exists(cookedName)) continue;
+        // ファイルの読み込みは計測から外す (両方ともメモリ上のデータから始める)
+        AssetView source = am->AcquireAsset(name);
+        AssetView cookedData = am->AcquireAsset(cookedName);
+        if (!source || !cookedData) continue;
+
+        CookBenchResult r;
+        r.name = name;
+        r.sourceBytes = source.size();
+        r.cookedBytes = cookedData.size();
+        r.assimpMs = r.cookedMs = 1e300;
+        bool ok = true;
+        for (int i = 0; i < rounds && ok; ++i) {
+            auto t0 = Clock::now();
+            ModelMeshData mesh;
+            ok = ImportWithAssimp(name, source, mesh);
+            r.assimpMs = std::min(r.assimpMs, elapsedMs(t0));
+
+            // .pixmesh は GPU へ渡す頂点 / インデックスをビューのまま使うので、表の読み込みと
+            // LoadCooked と同じ鮮度の確認 (ソースフォルダなら元のモデルのサイズ / 更新時刻、違えばハッシュ) までを測る
+            t0 = Clock::now();
+            CookedMeshView view;
+            ModelMeshData tables;
+            std::string error;
+            ok = ok && MeshCook::Read(cookedData.data(), cookedData.size(), view, tables, error);
+            const bool current = ok && IsCookedCurrent(name, view.header, &r.sourceHashed);
+            r.cookedMs = std::min(r.cookedMs, elapsedMs(t0));
+            r.stale = ok && !current;
+        }
+        if (ok) results.push_back(std::move(r));
+    }
+
+    std::lock_guard<std::mutex> lk(m_mtx);
+    m_benchResults = results;
+    return results;
 }
 
 std::string ModelManager::ResolveTexturePath(const std::string& modelLogical, const std::string& rawPath){
@@ -185,25 +624,21 @@ std::string ModelManager::ResolveTexturePath(const std::string& modelLogical, co
     return {};
 }
 
-void ModelManager::ProcessNode(aiNode* node, const aiScene* scene,
-    std::vector<ModelVertex>& vertices,
-    std::vector<uint32_t>& indices,
-    std::shared_ptr<ModelSharedResource> shared) {
+void ModelManager::ProcessNode(aiNode* node, const aiScene* scene, ModelMeshData& mesh) {
 
     for (uint32_t i = 0; i < node->mNumMeshes; i++) {
-        aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-        ProcessMesh(mesh, scene, vertices, indices, shared);
+        aiMesh* m = scene->mMeshes[node->mMeshes[i]];
+        ProcessMesh(m, scene, mesh);
     }
 
     for (uint32_t i = 0; i < node->mNumChildren; i++) {
-        ProcessNode(node->mChildren[i], scene, vertices, indices, shared);
+        ProcessNode(node->mChildren[i], scene, mesh);
     }
 }
 
-void ModelManager::ProcessMesh(aiMesh* mesh, const aiScene* scene,
-    std::vector<ModelVertex>& vertices,
-    std::vector<uint32_t>& indices,
-    std::shared_ptr<ModelSharedResource> shared) {
+void ModelManager::ProcessMesh(aiMesh* mesh, const aiScene* scene, ModelMeshData& out) {
+    std::vector<ModelVertex>& vertices = out.vertices;
+    std::vector<uint32_t>& indices = out.indices;
 
     SubMesh subMesh;
     subMesh.indexOffset = static_cast<uint32_t>(indices.size());
@@ -331,45 +766,82 @@ void ModelManager::ProcessMesh(aiMesh* mesh, const aiScene* scene,
 
 
     subMesh.indexCount = static_cast<uint32_t>(indices.size()) - subMesh.indexOffset;
-    shared->submeshes.push_back(subMesh);
+    subMesh.vertexOffset = vertexOffset;
+    subMesh.vertexCount = mesh->mNumVertices;
+    out.submeshes.push_back(subMesh);
 }
 
-bool ModelManager::CreateGPUBuffers(const std::vector<ModelVertex>& vertices,
-    const std::vector<uint32_t>& indices,
+bool ModelManager::CreateGPUBuffers(const void* vertices, uint32_t vertexCount,
+    const void* indices, uint32_t indexCount, size_t indexBytes,
+    const PackedVertexLayout& layout, const void* skin,
     std::shared_ptr<ModelSharedResource> shared) {
 
     auto device = DirectX11::GetInstance()->GetDevice();
     if (!device) return false;
 
-    D3D11_BUFFER_DESC vbDesc = {};
-    vbDesc.Usage = D3D11_USAGE_DEFAULT;
-    vbDesc.ByteWidth = static_cast<UINT>(vertices.size() * sizeof(ModelVertex));
-    vbDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-
-    D3D11_SUBRESOURCE_DATA vbData = {};
-    vbData.pSysMem = vertices.data();
-
-    HRESULT hr = device->CreateBuffer(&vbDesc, &vbData, shared->vb.GetAddressOf());
-    if (FAILED(hr)) return false;
+    auto addStream = [&](const void* data, VertexStreamKind kind, uint32_t attributes, uint32_t stride) {
+        D3D11_BUFFER_DESC vbDesc = {};
+        vbDesc.Usage = D3D11_USAGE_DEFAULT;
+        vbDesc.ByteWidth = static_cast<UINT>((size_t)vertexCount * stride);
+        vbDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+
+        D3D11_SUBRESOURCE_DATA vbData = {};
+        vbData.pSysMem = data;
+
+        VertexStream stream;
+        stream.kind = kind;
+        stream.attributes = attributes;
+        stream.stride = stride;
+        if (FAILED(device->CreateBuffer(&vbDesc, &vbData, stream.buffer.GetAddressOf()))) return false;
+        shared->streams.push_back(std::move(stream));
+        return true;
+    };
+
+    constexpr uint32_t kSurface = VertexAttr_Normal | VertexAttr_Tangent | VertexAttr_UV;
+    const uint8_t* base = static_cast<const uint8_t*>(vertices);
+    if (layout.baseStride == 0) {
+        if (!addStream(vertices, VertexStreamKind::Full, VertexAttr_Position | kSurface | VertexAttr_Skin, sizeof(ModelVertex))) return false;
+        // 深度だけの描画用に位置を詰めたストリームを別に持つ (ModelVertex の 88 バイトを読まずに済む)
+        if (m_splitPositionStream) {
+            std::vector<float> positions((size_t)vertexCount * 3);
+            const ModelVertex* mv = static_cast<const ModelVertex*>(vertices);
+            for (uint32_t i = 0; i < vertexCount; ++i) memcpy(&positions[(size_t)i * 3], mv[i].position, sizeof(float) * 3);
+            if (!addStream(positions.data(), VertexStreamKind::Position, VertexAttr_Position, sizeof(float) * 3)) return false;
+        }
+    }
+    else if (layout.flags & VertexPack_SplitPosition) {
+        // base は [位置 * 頂点数][法線 / 接線 / UV * 頂点数]
+        const uint32_t posStride = VertexPack::PositionStride(layout);
+        if (!addStream(base, VertexStreamKind::Position, VertexAttr_Position, posStride)) return false;
+        if (!addStream(base + (size_t)vertexCount * posStride, VertexStreamKind::Attributes, kSurface, layout.baseStride - posStride)) return false;
+    }
+    else {
+        if (!addStream(base, VertexStreamKind::Packed, VertexAttr_Position | kSurface, layout.baseStride)) return false;
+    }
+    if (layout.skinStride) {
+        if (!addStream(skin, VertexStreamKind::Skin, VertexAttr_Skin, layout.skinStride)) return false;
+    }
 
     D3D11_BUFFER_DESC ibDesc = {};
     ibDesc.Usage = D3D11_USAGE_DEFAULT;
-    ibDesc.ByteWidth = static_cast<UINT>(indices.size() * sizeof(uint32_t));
+    ibDesc.ByteWidth = static_cast<UINT>(indexBytes);
     ibDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
 
     D3D11_SUBRESOURCE_DATA ibData = {};
-    ibData.pSysMem = indices.data();
+    ibData.pSysMem = indices;
 
-    hr = device->CreateBuffer(&ibDesc, &ibData, shared->ib.GetAddressOf());
+    HRESULT hr = device->CreateBuffer(&ibDesc, &ibData, shared->ib.GetAddressOf());
     if (FAILED(hr)) return false;
 
-    shared->vertexCount = static_cast<uint32_t>(vertices.size());
-    shared->indexCount = static_cast<uint32_t>(indices.size());
+    shared->vertexLayout = layout;
+    shared->vertexCount = vertexCount;
+    shared->indexCount = indexCount;
+    shared->indexBytes = indexBytes;
 
     return true;
 }
 
-void ModelManager::ProcessMaterials(const aiScene* scene, std::shared_ptr<ModelSharedResource> shared) {
+void ModelManager::ProcessMaterials(const aiScene* scene, ModelMeshData& mesh) {
     for (uint32_t i = 0; i < scene->mNumMaterials; i++) {
         aiMaterial* mat = scene->mMaterials[i];
         MaterialShared material;
@@ -395,13 +867,13 @@ void ModelManager::ProcessMaterials(const aiScene* scene, std::shared_ptr<ModelS
         bool foundTexture = false;
         for (aiTextureType texType : texTypes) {
             if (AI_SUCCESS == mat->GetTexture(texType, 0, &texPath)) {
-                std::string resolved = ResolveTexturePath(shared->source, texPath.C_Str());
-                material.baseColorTex = resolved;
+                // パスの解決は BuildResource で行う (.pixmesh にはモデルに書かれたまま入れる)
+                material.baseColorTex = texPath.C_Str();
                 foundTexture = true;
                 // デバッグ用: どのテクスチャタイプで見つかったかログ出力
                 OutputDebugStringA(("[ModelManager] Material " + std::to_string(i) + 
                     " texture found in type " + std::to_string(texType) + 
-                    ": " + resolved + "\n").c_str());
+                    ": " + material.baseColorTex + "\n").c_str());
                 break; // 最初に見つかったテクスチャを使用
             }
         }
@@ -411,22 +883,22 @@ void ModelManager::ProcessMaterials(const aiScene* scene, std::shared_ptr<ModelS
                 " has no texture in any supported type\n").c_str());
         }
 
-        shared->materials.push_back(material);
+        mesh.materials.push_back(material);
     }
 }
 
-void ModelManager::ProcessBones(const aiScene* scene, std::shared_ptr<ModelSharedResource> shared) {
+void ModelManager::ProcessBones(const aiScene* scene, ModelMeshData& mesh) {
 
-    shared->hasSkin = false;
+    mesh.hasSkin = false;
     for (uint32_t i = 0; i < scene->mNumMeshes; i++) {
         if (scene->mMeshes[i]->HasBones()) {
-            shared->hasSkin = true;
+            mesh.hasSkin = true;
             break;
         }
     }
 }
 
-void ModelManager::ProcessAnimations(const aiScene* scene, std::shared_ptr<ModelSharedResource> shared) {
+void ModelManager::ProcessAnimations(const aiScene* scene, ModelMeshData& mesh) {
     for (uint32_t i = 0; i < scene->mNumAnimations; i++) {
         aiAnimation* anim = scene->mAnimations[i];
         AnimationClip clip;
@@ -434,7 +906,7 @@ void ModelManager::ProcessAnimations(const aiScene* scene, std::shared_ptr<Model
         clip.duration = anim->mDuration;
         clip.tps = anim->mTicksPerSecond != 0.0 ? anim->mTicksPerSecond : 25.0;
 
-        shared->clips.push_back(clip);
+        mesh.clips.push_back(clip);
     }
 }
 
@@ -450,38 +922,305 @@ void ModelManager::GarbageCollect() {
     }
 }
 
+void ModelManager::AccountDraw(bool depthOnly, uint64_t vertexBytes, uint64_t fullBytes, uint64_t indexBytes) {
+    BandwidthCounters& c = m_bandwidth[depthOnly ? 1 : 0];
+    c.draws.fetch_add(1, std::memory_order_relaxed);
+    c.vertexBytes.fetch_add(vertexBytes, std::memory_order_relaxed);
+    c.fullBytes.fetch_add(fullBytes, std::memory_order_relaxed);
+    c.indexBytes.fetch_add(indexBytes, std::memory_order_relaxed);
+}
+
 void ModelManager::DrawDebugGUI() {
-    std::lock_guard<std::mutex> lk(m_mtx);
-    ImGui::TextUnformatted("ModelManager");
-    ImGui::Separator();
-    size_t alive = 0;
-    size_t totalGPU = 0;
-    for (auto& kv : m_cache) {
-        if (!kv.second.weak.expired()) {
-            alive++;
-            totalGPU += kv.second.gpuBytes;
-        }
-    }
-    ImGui::Text("Cached: %zu (alive=%zu)", m_cache.size(), alive);
-    ImGui::Text("GPU Approx Total: %.2f MB", totalGPU / (1024.0 * 1024.0));
-    static char filter[128] = "";
-    ImGui::InputText("Filter##Model", filter, sizeof(filter));
-    if (ImGui::Button("GC Dead")) {
-        for (auto it = m_cache.begin(); it != m_cache.end();) {
-            if (it->second.weak.expired()) it = m_cache.erase(it);
-            else ++it;
-        }
-    }
-    ImGui::Separator();
-    ImGui::BeginChild("ModelList", ImVec2(0, 160), true);
-    for (auto& kv : m_cache) {
-        if (filter[0] && kv.first.find(filter) == std::string::npos) continue;
-        bool aliveRes = !kv.second.weak.expired();
-        ImGui::Text("%s | %s | %.2f KB | lastUse=%llu",
-            kv.first.c_str(),
-            aliveRes ? "alive" : "dead",
-            kv.second.gpuBytes / 1024.0,
-            (unsigned long long)kv.second.lastUse);
-    }
-    ImGui::EndChild();
-}
\ No newline at end of file
+    // 調理とベンチマークは AssetManager / Assimp を呼ぶので m_mtx を離してから行う
+    bool cookAll = false;
+    bool runBench = false;
+    bool runPackReport = false;
+    bool runPackSelfTest = false;
+    bool runIndexSelfTest = false;
+    bool runIndexReport = false;
+    bool runMeshletSelfTest = false;
+    bool runMeshletReport = false;
+    {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        ImGui::TextUnformatted("ModelManager");
+        ImGui::Separator();
+        size_t alive = 0;
+        size_t totalGPU = 0;
+        for (auto& kv : m_cache) {
+            if (!kv.second.weak.expired()) {
+                alive++;
+                totalGPU += kv.second.gpuBytes;
+            }
+        }
+        ImGui::Text("Cached: %zu (alive=%zu, loading=%zu)", m_cache.size(), alive, m_loading.size());
+        ImGui::Text("GPU Approx Total: %.2f MB", totalGPU / (1024.0 * 1024.0));
+        static char filter[128] = "";
+        ImGui::InputText("Filter##Model", filter, sizeof(filter));
+        if (ImGui::Button("GC Dead")) {
+            for (auto it = m_cache.begin(); it != m_cache.end();) {
+                if (it->second.weak.expired()) it = m_cache.erase(it);
+                else ++it;
+            }
+        }
+        ImGui::Separator();
+        ImGui::BeginChild("ModelList", ImVec2(0, 160), true);
+        for (auto& kv : m_cache) {
+            if (filter[0] && kv.first.find(filter) == std::string::npos) continue;
+            bool aliveRes = !kv.second.weak.expired();
+            ImGui::Text("%s | %s | %.2f KB | lastUse=%llu",
+                kv.first.c_str(),
+                aliveRes ? "alive" : "dead",
+                kv.second.gpuBytes / 1024.0,
+                (unsigned long long)kv.second.lastUse);
+        }
+        ImGui::EndChild();
+
+        ImGui::Separator();
+        ImGui::TextUnformatted("Cooked Mesh (.pixmesh)");
+        bool useCooked = m_useCooked;
+        if (ImGui::Checkbox("Use Cooked", &useCooked)) m_useCooked = useCooked;
+        ImGui::SameLine();
+        bool autoCook = m_autoCook;
+        if (ImGui::Checkbox("Auto Cook On Import", &autoCook)) m_autoCook = autoCook;
+        ImGui::Text("Loads: cooked=%llu assimp=%llu rejected=%llu",
+            (unsigned long long)m_cookedLoads.load(),
+            (unsigned long long)m_assimpLoads.load(),
+            (unsigned long long)m_cookedRejected.load());
+        cookAll = ImGui::Button("Cook All Models");
+        ImGui::SameLine();
+        runBench = ImGui::Button("Benchmark Assimp vs Cooked");
+        if (!m_benchResults.empty() && ImGui::BeginTable("CookBench", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+            ImGui::TableSetupColumn("Model");
+            ImGui::TableSetupColumn("Source KB");
+            ImGui::TableSetupColumn("Cooked KB");
+            ImGui::TableSetupColumn("Assimp ms");
+            ImGui::TableSetupColumn("Cooked ms");
+            ImGui::TableSetupColumn("Source Check");
+            ImGui::TableHeadersRow();
+            for (const auto& r : m_benchResults) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(r.name.c_str());
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", r.sourceBytes / 1024.0);
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", r.cookedBytes / 1024.0);
+                ImGui::TableNextColumn(); ImGui::Text("%.2f", r.assimpMs);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f (x%.0f)", r.cookedMs, r.cookedMs > 0.0 ? r.assimpMs / r.cookedMs : 0.0);
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(r.stale ? "stale" : (r.sourceHashed ? "hashed" : "size+time"));
+            }
+            ImGui::EndTable();
+        }
+
+        ImGui::Separator();
+        ImGui::TextUnformatted("Vertex Packing");
+        bool packing = m_vertexPacking;
+        if (ImGui::Checkbox("Pack Vertices", &packing)) m_vertexPacking = packing;
+        ImGui::SameLine();
+        bool quantize = m_quantizePositions;
+        if (ImGui::Checkbox("Quantize Positions", &quantize)) m_quantizePositions = quantize;
+        runPackReport = ImGui::Button("Pack Report (all models)");
+        ImGui::SameLine();
+        runPackSelfTest = ImGui::Button("Encode/Decode Self Test");
+        if (!m_packSelfTestLog.empty()) {
+            ImGui::BeginChild("PackSelfTest", ImVec2(0, 120), true, ImGuiWindowFlags_HorizontalScrollbar);
+            ImGui::TextUnformatted(m_packSelfTestLog.c_str());
+            ImGui::EndChild();
+        }
+        if (!m_packReports.empty() && ImGui::BeginTable("PackReport", 10, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollX)) {
+            ImGui::TableSetupColumn("Model");
+            ImGui::TableSetupColumn("Layout");
+            ImGui::TableSetupColumn("Verts");
+            ImGui::TableSetupColumn("Full KB");
+            ImGui::TableSetupColumn("Packed KB");
+            ImGui::TableSetupColumn("Saved");
+            ImGui::TableSetupColumn("Pos (rel)");
+            ImGui::TableSetupColumn("N / T deg");
+            ImGui::TableSetupColumn("UV / W");
+            ImGui::TableSetupColumn("Result");
+            ImGui::TableHeadersRow();
+            size_t totalFull = 0, totalPacked = 0;
+            for (const auto& kv : m_packReports) {
+                const VertexPackReport& r = kv.second;
+                totalFull += r.fullBytes;
+                totalPacked += r.packedBytes;
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(kv.first.c_str());
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(VertexPack::LayoutName(r.layout).c_str());
+                ImGui::TableNextColumn(); ImGui::Text("%u", r.vertexCount);
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", r.fullBytes / 1024.0);
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", r.packedBytes / 1024.0);
+                ImGui::TableNextColumn(); ImGui::Text("%.1f%%", r.fullBytes ? 100.0 * (1.0 - (double)r.packedBytes / r.fullBytes) : 0.0);
+                ImGui::TableNextColumn(); ImGui::Text("%.2e", r.maxPositionErrorRel);
+                ImGui::TableNextColumn(); ImGui::Text("%.4f / %.3f", r.maxNormalDeg, r.maxTangentDeg);
+                ImGui::TableNextColumn(); ImGui::Text("%.1e / %.1e", r.maxUVError, r.maxWeightError);
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(r.passed ? "OK" : r.failure.c_str());
+            }
+            ImGui::EndTable();
+            ImGui::Text("Total: %.2f MB -> %.2f MB (%.2f MB saved)",
+                totalFull / (1024.0 * 1024.0), totalPacked / (1024.0 * 1024.0), (totalFull - totalPacked) / (1024.0 * 1024.0));
+        }
+
+        ImGui::Separator();
+        ImGui::TextUnformatted("Vertex Streams");
+        bool split = m_splitPositionStream;
+        if (ImGui::Checkbox("Split Position Stream", &split)) m_splitPositionStream = split;
+        // 前回の GUI からの差分 (GUI は毎フレーム描くので 1 フレーム分)
+        if (ImGui::BeginTable("Bandwidth", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+            ImGui::TableSetupColumn("Pass");
+            ImGui::TableSetupColumn("Draws");
+            ImGui::TableSetupColumn("Vertex KB");
+            ImGui::TableSetupColumn("as ModelVertex KB");
+            ImGui::TableSetupColumn("Index KB");
+            ImGui::TableHeadersRow();
+            const char* passNames[2] = { "Main", "Depth" };
+            for (int p = 0; p < 2; ++p) {
+                BandwidthSnapshot now;
+                now.draws = m_bandwidth[p].draws.load(std::memory_order_relaxed);
+                now.vertexBytes = m_bandwidth[p].vertexBytes.load(std::memory_order_relaxed);
+                now.fullBytes = m_bandwidth[p].fullBytes.load(std::memory_order_relaxed);
+                now.indexBytes = m_bandwidth[p].indexBytes.load(std::memory_order_relaxed);
+                const BandwidthSnapshot& last = m_bandwidthLast[p];
+                const uint64_t fetched = now.vertexBytes - last.vertexBytes;
+                const uint64_t full = now.fullBytes - last.fullBytes;
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(passNames[p]);
+                ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)(now.draws - last.draws));
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", fetched / 1024.0);
+                ImGui::TableNextColumn(); ImGui::Text("%.1f (%.0f%%)", full / 1024.0, full ? 100.0 * fetched / full : 0.0);
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", (now.indexBytes - last.indexBytes) / 1024.0);
+                m_bandwidthLast[p] = now;
+            }
+            ImGui::EndTable();
+        }
+        if (ImGui::BeginTable("Streams", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+            ImGui::TableSetupColumn("Model");
+            ImGui::TableSetupColumn("Streams");
+            ImGui::TableSetupColumn("Main B/vtx");
+            ImGui::TableSetupColumn("Depth B/vtx");
+            ImGui::TableHeadersRow();
+            for (auto& kv : m_cache) {
+                auto res = kv.second.weak.lock();
+                if (!res) continue;
+                if (filter[0] && kv.first.find(filter) == std::string::npos) continue;
+                auto bytesPerVertex = [&](uint32_t attributes) {
+                    uint32_t sel[ModelSharedResource::kMaxStreams];
+                    const uint32_t n = res->SelectStreams(attributes, sel);
+                    uint32_t stride = 0;
+                    for (uint32_t i = 0; i < n; ++i) stride += res->streams[sel[i]].stride;
+                    return stride;
+                };
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(kv.first.c_str());
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(VertexPack::StreamsName(*res).c_str());
+                ImGui::TableNextColumn(); ImGui::Text("%u", bytesPerVertex(kVertexAttrMainPass | (res->hasSkin ? VertexAttr_Skin : 0u)));
+                ImGui::TableNextColumn(); ImGui::Text("%u / %u", bytesPerVertex(kVertexAttrDepthPass), (unsigned)sizeof(ModelVertex));
+            }
+            ImGui::EndTable();
+        }
+
+        ImGui::Separator();
+        ImGui::TextUnformatted("Index Packing");
+        bool indexPacking = m_indexPacking;
+        if (ImGui::Checkbox("16-bit Indices", &indexPacking)) m_indexPacking = indexPacking;
+        ImGui::SameLine();
+        runIndexSelfTest = ImGui::Button("Index Self Test");
+        ImGui::SameLine();
+        runIndexReport = ImGui::Button("Index Report (all models)");
+        if (!m_indexSelfTestLog.empty()) {
+            ImGui::BeginChild("IndexSelfTest", ImVec2(0, 90), true, ImGuiWindowFlags_HorizontalScrollbar);
+            ImGui::TextUnformatted(m_indexSelfTestLog.c_str());
+            ImGui::EndChild();
+        }
+        if (!m_indexReports.empty() && ImGui::BeginTable("IndexReport", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+            ImGui::TableSetupColumn("Model");
+            ImGui::TableSetupColumn("Format");
+            ImGui::TableSetupColumn("u16 SubMeshes");
+            ImGui::TableSetupColumn("u32 KB");
+            ImGui::TableSetupColumn("Packed KB");
+            ImGui::TableSetupColumn("Triangles Checked");
+            ImGui::TableHeadersRow();
+            size_t totalFull = 0, totalPacked = 0;
+            for (const auto& kv : m_indexReports) {
+                const IndexPackReport& r = kv.second;
+                if (filter[0] && kv.first.find(filter) == std::string::npos) continue;
+                totalFull += r.fullBytes;
+                totalPacked += r.passed ? r.packedBytes : r.fullBytes;
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(kv.first.c_str());
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(r.passed ? IndexPack::FormatName(r.format) : "u32");
+                ImGui::TableNextColumn(); ImGui::Text("%u / %u", r.submesh16Count, r.submeshCount);
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", r.fullBytes / 1024.0);
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", r.packedBytes / 1024.0);
+                ImGui::TableNextColumn();
+                if (r.passed && r.validated) ImGui::Text("%u OK", r.triangleCount);
+                else if (r.passed) ImGui::Text("%u (not validated)", r.triangleCount);
+                else ImGui::TextUnformatted(r.failure.c_str());
+            }
+            ImGui::EndTable();
+            ImGui::Text("Total: %.2f MB -> %.2f MB", totalFull / (1024.0 * 1024.0), totalPacked / (1024.0 * 1024.0));
+        }
+
+        ImGui::Separator();
+        ImGui::TextUnformatted("Meshlets");
+        bool buildMeshlets = m_buildMeshlets;
+        if (ImGui::Checkbox("Build Meshlets", &buildMeshlets)) m_buildMeshlets = buildMeshlets;
+        ImGui::SameLine();
+        runMeshletReport = ImGui::Button("Meshlet Report (all models)");
+        ImGui::SameLine();
+        runMeshletSelfTest = ImGui::Button("Meshlet Self Test / Benchmark");
+        ImGui::Text("Limits: %u vertices / %u triangles", MeshletBuilder::kMaxVertices, MeshletBuilder::kMaxTriangles);
+        if (!m_meshletSelfTestLog.empty()) {
+            ImGui::BeginChild("MeshletSelfTest", ImVec2(0, 120), true, ImGuiWindowFlags_HorizontalScrollbar);
+            ImGui::TextUnformatted(m_meshletSelfTestLog.c_str());
+            ImGui::EndChild();
+        }
+        if (!m_meshletReports.empty() && ImGui::BeginTable("MeshletReport", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+            ImGui::TableSetupColumn("Model");
+            ImGui::TableSetupColumn("Meshlets");
+            ImGui::TableSetupColumn("avg V / T");
+            ImGui::TableSetupColumn("Build ms");
+            ImGui::TableSetupColumn("Triangles");
+            ImGui::TableSetupColumn("Result");
+            ImGui::TableHeadersRow();
+            for (const auto& kv : m_meshletReports) {
+                const MeshletReport& r = kv.second;
+                if (filter[0] && kv.first.find(filter) == std::string::npos) continue;
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(kv.first.c_str());
+                ImGui::TableNextColumn(); ImGui::Text("%u", r.meshletCount);
+                ImGui::TableNextColumn(); ImGui::Text("%.1f / %.1f", r.avgVertices, r.avgTriangles);
+                ImGui::TableNextColumn(); ImGui::Text("%.2f", r.buildMs);
+                ImGui::TableNextColumn(); ImGui::Text("%u", r.triangleCount);
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(!r.passed ? r.failure.c_str() : r.validated ? "OK" : "built (not validated)");
+            }
+            ImGui::EndTable();
+        }
+    }
+    if (runMeshletSelfTest) {
+        std::string log;
+        bool ok = MeshletBuilder::SelfTest(log);
+        log += ok ? "ALL PASS" : "FAILED";
+        std::lock_guard<std::mutex> lk(m_mtx);
+        m_meshletSelfTestLog = std::move(log);
+    }
+    if (runMeshletReport) ReportMeshlets();
+    if (runIndexReport) ReportIndexPacking();
+    if (runIndexSelfTest) {
+        std::string log;
+        bool ok = IndexPack::SelfTest(log);
+        log += ok ? "ALL PASS" : "FAILED";
+        std::lock_guard<std::mutex> lk(m_mtx);
+        m_indexSelfTestLog = std::move(log);
+    }
+    if (runPackSelfTest) {
+        std::string log;
+        bool ok = VertexPack::SelfTest(log);
+        log += ok ? "ALL PASS" : "FAILED";
+        std::lock_guard<std::mutex> lk(m_mtx);
+        m_packSelfTestLog = std::move(log);
+    }
+    if (runPackReport) ReportVertexPacking();
+    if (cookAll) {
+        size_t n = CookAllModels();
+        OutputDebugStringA(("[ModelManager] Cooked " + std::to_string(n) + " models\n").c_str());
+    }
+    if (runBench) BenchmarkCooked();
+}
@@ -4,12 +4,21 @@
 #define MODELMANAGER_H
 
 #include "AssetTypes.h"
+#include "MeshCook.h"
+#include "IndexPack.h"
+#include "MeshletBuilder.h"
+#include "HashUtill.h"
 #include "assimp/Importer.hpp"
 #include "assimp/scene.h"
 #include "assimp/postprocess.h"
 #include <unordered_map>
 #include <memory>
 #include <mutex>
+#include <future>
+#include <atomic>
+#include <map>
+
+class AssetView;
 
 class ModelManager {
 public:
@@ -19,33 +28,129 @@ public:
     void UnInit();
     void GarbageCollect();
     void DrawDebugGUI();
+
+    // ς݃f (<f>.pixmesh, MeshFormat.h)B
+    // LȂ烂f̓ǂݍݎ .pixmesh TA Assimp ʂɓǂ
+    void SetUseCooked(bool use) { m_useCooked = use; }
+    bool GetUseCooked() const { return m_useCooked; }
+    // Assimp œǂݍ񂾎 .pixmesh \[XtH_֏o (FromSource ̂)
+    void SetAutoCook(bool enable) { m_autoCook = enable; }
+    // Assimp œǂݍ .pixmesh \[XtH_֏oBpbNOɎsĂƃA[JCuɂ
+    bool CookModel(const std::string& logicalName);
+    size_t CookAllModels();
+    static std::string CookedName(const std::string& logicalName) { return logicalName + ".pixmesh"; }
+
+    // .pixmesh ̂郂fɂ Assimp  .pixmesh ̓ǂݍݎ (GPU obt@) ׂ
+    struct CookBenchResult {
+        std::string name;
+        size_t sourceBytes = 0;
+        size_t cookedBytes = 0;
+        double assimpMs = 0.0;  // rounds ̍ŏl
+        double cookedMs = 0.0;  // \̓ǂݍ + IsCookedCurrent
+        bool sourceHashed = false; // Nx̊mFŌ̃fnbV
+        bool stale = false;        // ̃fƍȂ (LoadCooked ȂgȂ)
+    };
+    std::vector<CookBenchResult> BenchmarkCooked(int rounds = 3);
+
+    // _l߂` (VertexPack.h)  GPU ֒uBȍ~ɓǂݍރf
+    void SetVertexPacking(bool enable) { m_vertexPacking = enable; }
+    bool GetVertexPacking() const { return m_vertexPacking; }
+    // ʒuTubV͈̔͂ unorm16 ɗʎq
+    void SetQuantizePositions(bool enable) { m_quantizePositions = enable; }
+    // Sf Assimp œǂŋl߁A덷ƍ팸oCg𒲂ׂ (GUI ̕\ɏo)
+    void ReportVertexPacking();
+    // Sf̃CfbNX Assimp lߒČƓ˂킹 (ǂݍݎ͌؂Ȃ)
+    void ReportIndexPacking();
+    // ʒu̒_Xg[ʂɍ ([x / e̕`͈ʒuǂ)Bȍ~ɓǂݍރf
+    void SetSplitPositionStream(bool enable) { m_splitPositionStream = enable; }
+    bool GetSplitPositionStream() const { return m_splitPositionStream; }
+    // _͈͂܂TubṼCfbNX uint16 Ŏ (IndexPack.h)Bȍ~ɓǂݍރf
+    void SetIndexPacking(bool enable) { m_indexPacking = enable; }
+    bool GetIndexPacking() const { return m_indexPacking; }
+    //  (CookModel / ) ̎ɃbVbg (MeshletBuilder.h)  .pixmesh ֏oB
+    // ǂݍݎɂ͍ȂBbVbg̖Â .pixmesh ͎LȂ璲AȊO͋̂܂܎g
+    void SetBuildMeshlets(bool enable) { m_buildMeshlets = enable; }
+    bool GetBuildMeshlets() const { return m_buildMeshlets; }
+    // Sf Assimp œǂŃbVbgA쐬Ԃƌ،ʂ𒲂ׂ (GUI ̕\ɏo)
+    void ReportMeshlets();
+
+    // `œǂޒ_ / CfbNX̃oCg (CPU ̌ς)BModelRenderComponent `斈ɌĂԁB
+    // fullBytes ͓_ ModelVertex ̂܂ܓǂ񂾏ꍇ̃oCg
+    void AccountDraw(bool depthOnly, uint64_t vertexBytes, uint64_t fullBytes, uint64_t indexBytes);
+
 private:
     std::string ResolveTexturePath(const std::string& modelLogical, const std::string& rawPath);
-    void ProcessNode(aiNode* node, const aiScene* scene,
-        std::vector<ModelVertex>& vertices,
-        std::vector<uint32_t>& indices,
-        std::shared_ptr<ModelSharedResource> shared);
+    bool ImportWithAssimp(const std::string& logicalName, const AssetView& data, ModelMeshData& mesh);
+    void ProcessNode(aiNode* node, const aiScene* scene, ModelMeshData& mesh);
+    void ProcessMesh(aiMesh* mesh, const aiScene* scene, ModelMeshData& out);
 
-    void ProcessMesh(aiMesh* mesh, const aiScene* scene,
-        std::vector<ModelVertex>& vertices,
-        std::vector<uint32_t>& indices,
+    bool CreateGPUBuffers(const void* vertices, uint32_t vertexCount,
+        const void* indices, uint32_t indexCount, size_t indexBytes,
+        const PackedVertexLayout& layout, const void* skin,
         std::shared_ptr<ModelSharedResource> shared);
 
-    bool CreateGPUBuffers(const std::vector<ModelVertex>& vertices,
-        const std::vector<uint32_t>& indices,
-        std::shared_ptr<ModelSharedResource> shared);
+    void ProcessMaterials(const aiScene* scene, ModelMeshData& mesh);
+    void ProcessBones(const aiScene* scene, ModelMeshData& mesh);
+    void ProcessAnimations(const aiScene* scene, ModelMeshData& mesh);
 
-    void ProcessMaterials(const aiScene* scene, std::shared_ptr<ModelSharedResource> shared);
-    void ProcessBones(const aiScene* scene, std::shared_ptr<ModelSharedResource> shared);
-    void ProcessAnimations(const aiScene* scene, std::shared_ptr<ModelSharedResource> shared);
+    // tables ̃TubV / }eAƁA_ / CfbNX̔z񂩂狤L\[X
+    std::shared_ptr<ModelSharedResource> BuildResource(const std::string& logicalName, ModelMeshData& tables,
+        const void* vertices, uint32_t vertexCount, const PackedIndexView& indices, uint32_t indexCount,
+        const PackedVertexLayout& layout = {}, const void* skin = nullptr);
+    // mesh ̒_l߂ČƔׂBe덷𒴂 false (ModelVertex ̂܂܎g)
+    bool PackMesh(const std::string& logicalName, ModelMeshData& mesh, PackedVertices& packed);
+    // CfbNXTubV̑Βl (\Ȃ uint16) ֋l߂ČƔׂB
+    // l߂Ȃ / s submeshes  uint32 ̂܂ܕ`zuɂ
+    // validate Ȃ IndexPack::Validate ʂ ( / ReportIndexPacking ̂)B߂l packed  indices w
+    PackedIndexView PrepareIndices(const std::string& logicalName, const uint32_t* indices, uint32_t indexCount,
+        std::vector<SubMesh>& submeshes, std::vector<uint8_t>& packed, bool validate);
+    // mesh.vertices / indices (̃CfbNX) 烁bVbg mesh.meshlets ֓B
+    // validate Ȃ MeshletBuilder::Validate ʂ (ReportMeshlets ̂)Bŝ܂ false
+    bool BuildMeshlets(const std::string& logicalName, ModelMeshData& mesh, bool validate = false);
+    std::shared_ptr<ModelSharedResource> LoadCooked(const std::string& logicalName);
+    // hashed ɂ͌̃fǂŃnbVԂ (TCY / XVŌ܂ false)
+    bool IsCookedCurrent(const std::string& logicalName, const MeshFileHeader& header, bool* hashed = nullptr);
+    bool WriteCooked(const std::string& logicalName, const AssetView& source, const ModelMeshData& mesh,
+        const PackedIndexView& indices, const PackedVertices* packed);
 
     ModelManager() = default;
     std::shared_ptr<ModelSharedResource> LoadInternal(const std::string& logicalName);
 
     struct Entry { std::weak_ptr<ModelSharedResource> weak; uint64_t lastUse = 0; size_t gpuBytes = 0; };
-    std::unordered_map<std::string, Entry> m_cache;
+    HashUtil::StringMap<Entry> m_cache;
+    // ǂݍݒ̃fBfvXbh͊҂ČʂL
+    HashUtil::StringMap<std::shared_future<std::shared_ptr<ModelSharedResource>>> m_loading;
     uint64_t m_frame = 0;
     std::mutex m_mtx;
+
+    std::atomic<bool> m_useCooked{ true };
+    std::atomic<bool> m_autoCook{ false };
+    std::atomic<uint64_t> m_cookedLoads{ 0 };   // .pixmesh ǂ񂾉
+    std::atomic<uint64_t> m_assimpLoads{ 0 };   // Assimp œǂ񂾉
+    std::atomic<uint64_t> m_cookedRejected{ 0 }; // .pixmesh Â / ĂĎgȂ
+    std::vector<CookBenchResult> m_benchResults; // m_mtx ŕی
+
+    std::atomic<bool> m_vertexPacking{ true };
+    std::atomic<bool> m_quantizePositions{ false };
+    std::map<std::string, VertexPackReport> m_packReports; // m_mtx ŕی
+    std::string m_packSelfTestLog;                         // m_mtx ŕی
+
+    std::atomic<bool> m_splitPositionStream{ true };
+    std::atomic<bool> m_indexPacking{ true };
+    std::map<std::string, IndexPackReport> m_indexReports; // m_mtx ŕی
+    std::string m_indexSelfTestLog;                        // m_mtx ŕی
+    std::atomic<bool> m_buildMeshlets{ true };
+    std::map<std::string, MeshletReport> m_meshletReports; // m_mtx ŕی
+    std::string m_meshletSelfTestLog;                      // m_mtx ŕی
+    struct BandwidthCounters {
+        std::atomic<uint64_t> draws{ 0 };
+        std::atomic<uint64_t> vertexBytes{ 0 };
+        std::atomic<uint64_t> fullBytes{ 0 };
+        std::atomic<uint64_t> indexBytes{ 0 };
+    };
+    struct BandwidthSnapshot { uint64_t draws = 0, vertexBytes = 0, fullBytes = 0, indexBytes = 0; };
+    BandwidthCounters m_bandwidth[2];     // [0] pX, [1] [x
+    BandwidthSnapshot m_bandwidthLast[2]; // O GUI `̒l (m_mtx ŕی)
 	static ModelManager* s_instance;
 };
 
@@ -15,6 +15,8 @@ using namespace DirectX;
 Microsoft::WRL::ComPtr<ID3D11SamplerState>       ModelRenderComponent::s_linearSmp;
 Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> ModelRenderComponent::s_whiteTexSRV;
 Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> ModelRenderComponent::s_magentaTexSRV;
+const std::string ModelRenderComponent::s_packedVSName = "VS_ModelPacked";
+const std::string ModelRenderComponent::s_depthVSName = "VS_ModelDepth";
 
 void ModelRenderComponent::Init(Object* owner) {
     _Parent = owner;
@@ -31,6 +33,8 @@ bool ModelRenderComponent::SetModel(const std::string& logicalPath) {
         return false;
     }
     RefreshMaterialCache();
+    SelectModelStreams();
+    m_depthLayout.Reset();
     if (!EnsureShaders(true)) return false;
     if (!EnsureConstantBuffer()) return false;
     m_texIssueReported.assign(m_model->submeshes.size(), 0);
@@ -53,18 +57,23 @@ void ModelRenderComponent::RefreshMaterialCache() {
     }
 }
 
+const std::string& ModelRenderComponent::ActiveVSName() const {
+    return IsPacked() ? s_packedVSName : m_vsName;
+}
+
 bool ModelRenderComponent::EnsureShaders(bool forceRecreateLayout) {
     auto* sm = ShaderManager::GetInstance();
+    const std::string& vsName = ActiveVSName();
 
-    ID3D11VertexShader* vs = sm->GetVertexShader(m_vsName);
+    ID3D11VertexShader* vs = sm->GetVertexShader(vsName);
     ID3D11PixelShader* ps = sm->GetPixelShader(m_psName);
 
     if (!vs || !ps) {
         sm->UpdateAndCompileShaders();
-        vs = sm->GetVertexShader(m_vsName);
+        vs = sm->GetVertexShader(vsName);
         ps = sm->GetPixelShader(m_psName);
         if (!vs || !ps) {
-            std::string msg = "[ModelRenderComponent] VF[_擾s: " + m_vsName + ", " + m_psName + "\n";
+            std::string msg = "[ModelRenderComponent] VF[_擾s: " + vsName + ", " + m_psName + "\n";
             OutputDebugStringA(msg.c_str());
             return false;
         }
@@ -99,7 +108,7 @@ void ModelRenderComponent::RecreateInputLayout() {
     m_layout.Reset();
     const void* bc = nullptr;
     size_t bcSize = 0;
-    if (!ShaderManager::GetInstance()->GetVSBytecode(m_vsName, &bc, &bcSize)) {
+    if (!ShaderManager::GetInstance()->GetVSBytecode(ActiveVSName(), &bc, &bcSize)) {
         OutputDebugStringA("[ModelRenderComponent] VS bytecode 擾s(InputLayout)\n");
         return;
     }
@@ -108,35 +117,149 @@ void ModelRenderComponent::RecreateInputLayout() {
 
 bool ModelRenderComponent::EnsureInputLayout(const void* vsBytecode, size_t size) {
     if (m_layout) return true;
-    D3D11_INPUT_ELEMENT_DESC desc[] = {
-        { "POSITION",0, DXGI_FORMAT_R32G32B32_FLOAT,    0,(UINT)offsetof(ModelVertex,position),    D3D11_INPUT_PER_VERTEX_DATA,0 },
-        { "NORMAL",  0, DXGI_FORMAT_R32G32B32_FLOAT,    0,(UINT)offsetof(ModelVertex,normal),      D3D11_INPUT_PER_VERTEX_DATA,0 },
-        { "TANGENT", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0,(UINT)offsetof(ModelVertex,tangent),     D3D11_INPUT_PER_VERTEX_DATA,0 },
-        { "TEXCOORD",0, DXGI_FORMAT_R32G32_FLOAT,       0,(UINT)offsetof(ModelVertex,uv),          D3D11_INPUT_PER_VERTEX_DATA,0 },
-        { "BLENDINDICES",0, DXGI_FORMAT_R32G32B32A32_UINT, 0,(UINT)offsetof(ModelVertex,boneIndices), D3D11_INPUT_PER_VERTEX_DATA,0 },
-        { "BLENDWEIGHT", 0, DXGI_FORMAT_R32G32B32A32_FLOAT,0,(UINT)offsetof(ModelVertex,boneWeights), D3D11_INPUT_PER_VERTEX_DATA,0 },
-    };
-    auto dev = DirectX11::GetInstance()->GetDevice();
-    HRESULT hr = dev->CreateInputLayout(desc, _countof(desc), vsBytecode, size, m_layout.GetAddressOf());
-    if (FAILED(hr)) {
+    if (!CreateStreamLayout(m_mainStreams, m_mainStreamCount, vsBytecode, size, m_layout)) {
         OutputDebugStringA("[ModelRenderComponent] InputLayout 쐬s\n");
         return false;
     }
     return true;
 }
 
+bool ModelRenderComponent::CreateStreamLayout(const uint32_t* streams, uint32_t count, const void* vsBytecode, size_t size,
+    Microsoft::WRL::ComPtr<ID3D11InputLayout>& out) {
+    if (!m_model || count == 0) return false;
+    const PackedVertexLayout& pl = m_model->vertexLayout;
+    const DXGI_FORMAT uvFormat = (pl.flags & VertexPack_UVUnorm16) ? DXGI_FORMAT_R16G16_UNORM : DXGI_FORMAT_R16G16_FLOAT;
+    const D3D11_INPUT_CLASSIFICATION perVertex = D3D11_INPUT_PER_VERTEX_DATA;
+
+    // ɑ˂Xg[͌̃Xg[Ȃ
+    std::vector<D3D11_INPUT_ELEMENT_DESC> desc;
+    uint32_t covered = 0;
+    for (uint32_t slot = 0; slot < count; ++slot) {
+        const VertexStream& st = m_model->streams[streams[slot]];
+        const uint32_t take = st.attributes & ~covered;
+        covered |= st.attributes;
+        auto add = [&](uint32_t attr, const char* semantic, DXGI_FORMAT format, UINT offset) {
+            if (take & attr) desc.push_back({ semantic, 0, format, slot, offset, perVertex, 0 });
+        };
+        switch (st.kind) {
+        case VertexStreamKind::Full:
+            add(VertexAttr_Position, "POSITION", DXGI_FORMAT_R32G32B32_FLOAT, (UINT)offsetof(ModelVertex, position));
+            add(VertexAttr_Normal, "NORMAL", DXGI_FORMAT_R32G32B32_FLOAT, (UINT)offsetof(ModelVertex, normal));
+            add(VertexAttr_Tangent, "TANGENT", DXGI_FORMAT_R32G32B32A32_FLOAT, (UINT)offsetof(ModelVertex, tangent));
+            add(VertexAttr_UV, "TEXCOORD", DXGI_FORMAT_R32G32_FLOAT, (UINT)offsetof(ModelVertex, uv));
+            add(VertexAttr_Skin, "BLENDINDICES", DXGI_FORMAT_R32G32B32A32_UINT, (UINT)offsetof(ModelVertex, boneIndices));
+            add(VertexAttr_Skin, "BLENDWEIGHT", DXGI_FORMAT_R32G32B32A32_FLOAT, (UINT)offsetof(ModelVertex, boneWeights));
+            break;
+        case VertexStreamKind::Packed:
+        case VertexStreamKind::Position:
+        case VertexStreamKind::Attributes: {
+            // VertexPack.h  PackedVertexFloatPos / PackedVertexQuantPos (Attributes ͈ʒu㔼)
+            const UINT posBytes = (pl.flags & VertexPack_QuantizedPosition) ? 8 : 12;
+            const UINT attrBase = st.kind == VertexStreamKind::Attributes ? 0 : posBytes;
+            add(VertexAttr_Position, "POSITION", posBytes == 8 ? DXGI_FORMAT_R16G16B16A16_UNORM : DXGI_FORMAT_R32G32B32_FLOAT, 0);
+            add(VertexAttr_Normal, "NORMAL", DXGI_FORMAT_R16G16_SNORM, attrBase);
+            add(VertexAttr_Tangent, "TANGENT", DXGI_FORMAT_R8G8B8A8_SNORM, attrBase + 4);
+            add(VertexAttr_UV, "TEXCOORD", uvFormat, attrBase + 8);
+            break;
+        }
+        case VertexStreamKind::Skin:
+            add(VertexAttr_Skin, "BLENDINDICES", DXGI_FORMAT_R8G8B8A8_UINT, 0);
+            add(VertexAttr_Skin, "BLENDWEIGHT", DXGI_FORMAT_R8G8B8A8_UNORM, 4);
+            break;
+        }
+    }
+    auto dev = DirectX11::GetInstance()->GetDevice();
+    HRESULT hr = dev->CreateInputLayout(desc.data(), (UINT)desc.size(), vsBytecode, size, out.ReleaseAndGetAddressOf());
+    return SUCCEEDED(hr);
+}
+
+void ModelRenderComponent::SelectModelStreams() {
+    m_mainStreamCount = m_depthStreamCount = 0;
+    if (!m_model) return;
+    // XLt̃f̓XL̃Xg[˂ (΃XLŕ`)
+    if (m_model->hasSkin) m_mainStreamCount = m_model->SelectStreams(kVertexAttrMainPass | VertexAttr_Skin, m_mainStreams);
+    if (m_mainStreamCount == 0) m_mainStreamCount = m_model->SelectStreams(kVertexAttrMainPass, m_mainStreams);
+    m_depthStreamCount = m_model->SelectStreams(kVertexAttrDepthPass, m_depthStreams);
+}
+
+uint32_t ModelRenderComponent::BindStreams(ID3D11DeviceContext* ctx, const uint32_t* streams, uint32_t count) {
+    ID3D11Buffer* vbs[ModelSharedResource::kMaxStreams] = {};
+    UINT strides[ModelSharedResource::kMaxStreams] = {};
+    UINT offsets[ModelSharedResource::kMaxStreams] = {};
+    uint32_t stride = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        const VertexStream& st = m_model->streams[streams[i]];
+        vbs[i] = st.buffer.Get();
+        strides[i] = st.stride;
+        stride += st.stride;
+    }
+    ctx->IASetVertexBuffers(0, count, vbs, strides, offsets);
+    ctx->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    return stride; // 1 _ɓǂރoCg
+}
+
+void ModelRenderComponent::DrawSubMesh(ID3D11DeviceContext* ctx, const SubMesh& sm, DXGI_FORMAT& boundFormat) {
+    const DXGI_FORMAT format = sm.index16 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+    if (format != boundFormat) {
+        ctx->IASetIndexBuffer(m_model->ib.Get(), format, 0);
+        boundFormat = format;
+    }
+    ctx->DrawIndexed(sm.indexCount, sm.indexStart, (INT)sm.baseVertex);
+}
+
+void ModelRenderComponent::SetPositionDequant(ID3D11DeviceContext* ctx, const SubMesh* sm) {
+    // ʎqʒu̓TubVAȊO͍ŏ 1 񂾂Pʕϊ
+    const bool quantized = (m_model->vertexLayout.flags & VertexPack_QuantizedPosition) != 0;
+    if (quantized != (sm != nullptr)) return;
+    PackCBData pcb{ XMFLOAT4(1, 1, 1, 0), XMFLOAT4(0, 0, 0, 0) };
+    if (sm) {
+        pcb.PosScale = XMFLOAT4(sm->posScale[0], sm->posScale[1], sm->posScale[2], 0);
+        pcb.PosBias = XMFLOAT4(sm->posBias[0], sm->posBias[1], sm->posBias[2], 0);
+    }
+    ctx->UpdateSubresource(m_packCb.Get(), 0, nullptr, &pcb, 0, 0);
+}
+
+bool ModelRenderComponent::EnsureDepthShader() {
+    auto* sm = ShaderManager::GetInstance();
+    ID3D11VertexShader* vs = sm->GetVertexShader(s_depthVSName);
+    if (!vs) {
+        sm->UpdateAndCompileShaders();
+        vs = sm->GetVertexShader(s_depthVSName);
+        if (!vs) {
+            OutputDebugStringA(("[ModelRenderComponent] VF[_擾s: " + s_depthVSName + "\n").c_str());
+            return false;
+        }
+    }
+    if (m_depthVs.Get() == vs && m_depthLayout) return true;
+    m_depthVs = vs;
+    const void* bc = nullptr;
+    size_t bcSize = 0;
+    if (!sm->GetVSBytecode(s_depthVSName, &bc, &bcSize) ||
+        !CreateStreamLayout(m_depthStreams, m_depthStreamCount, bc, bcSize, m_depthLayout)) {
+        OutputDebugStringA("[ModelRenderComponent] InputLayout 쐬s (depth)\n");
+        return false;
+    }
+    return true;
+}
+
 bool ModelRenderComponent::EnsureConstantBuffer() {
-    if (m_cb) return true;
+    if (m_cb && m_packCb) return true;
     auto dev = DirectX11::GetInstance()->GetDevice();
     D3D11_BUFFER_DESC bd{};
     bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
     bd.ByteWidth = sizeof(CBData);
     bd.Usage = D3D11_USAGE_DEFAULT;
-    HRESULT hr = dev->CreateBuffer(&bd, nullptr, m_cb.GetAddressOf());
+    HRESULT hr = m_cb ? S_OK : dev->CreateBuffer(&bd, nullptr, m_cb.GetAddressOf());
     if (FAILED(hr)) {
         OutputDebugStringA("[ModelRenderComponent] 萔obt@쐬s\n");
         return false;
     }
+    bd.ByteWidth = sizeof(PackCBData);
+    hr = dev->CreateBuffer(&bd, nullptr, m_packCb.GetAddressOf());
+    if (FAILED(hr)) {
+        OutputDebugStringA("[ModelRenderComponent] 萔obt@쐬s (packed)\n");
+        return false;
+    }
     return true;
 }
 
@@ -287,25 +410,23 @@ void ModelRenderComponent::Draw() {
     auto ctx = DirectX11::GetInstance()->GetContext();
     ctx->UpdateSubresource(m_cb.Get(), 0, nullptr, &cbd, 0, 0);
 
-    UINT stride = sizeof(ModelVertex);
-    UINT offset = 0;
-    ID3D11Buffer* vb = m_model->vb.Get();
-    ID3D11Buffer* ib = m_model->ib.Get();
-    ctx->IASetVertexBuffers(0, 1, &vb, &stride, &offset);
-    ctx->IASetIndexBuffer(ib, DXGI_FORMAT_R32_UINT, 0);
+    // pXɗv鑮𕢂Xg[𑩂˂ (SelectModelStreams)
+    const bool packed = IsPacked();
+    const uint32_t vertexStride = BindStreams(ctx, m_mainStreams, m_mainStreamCount);
     ctx->IASetInputLayout(m_layout.Get());
-    ctx->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
     ctx->VSSetShader(m_vs.Get(), nullptr, 0);
     ctx->PSSetShader(m_ps.Get(), nullptr, 0);
-    ID3D11Buffer* cbs[] = { m_cb.Get() };
-    ctx->VSSetConstantBuffers(0, 1, cbs);
+    ID3D11Buffer* cbs[] = { m_cb.Get(), m_packCb.Get() };
+    ctx->VSSetConstantBuffers(0, packed ? 2 : 1, cbs);
+    if (packed) SetPositionDequant(ctx, nullptr);
     ctx->PSSetConstantBuffers(0, 1, cbs);
     ID3D11SamplerState* smp = s_linearSmp.Get();
     ctx->PSSetSamplers(0, 1, &smp);
 
     EnsureDebugFallbackTextures();
 
+    DXGI_FORMAT boundFormat = DXGI_FORMAT_UNKNOWN;
     for (size_t i = 0; i < m_model->submeshes.size(); ++i) {
         const SubMesh& sm = m_model->submeshes[i];
         size_t matIndex = sm.materialIndex;
@@ -338,7 +459,10 @@ void ModelRenderComponent::Draw() {
         }
 
         ctx->PSSetShaderResources(0, 1, &srv);
-        ctx->DrawIndexed(sm.indexCount, sm.indexOffset, 0);
+        if (packed) SetPositionDequant(ctx, &sm);
+        DrawSubMesh(ctx, sm, boundFormat);
+        ModelManager::Instance()->AccountDraw(false, (uint64_t)sm.vertexCount * vertexStride,
+            (uint64_t)sm.vertexCount * sizeof(ModelVertex), (uint64_t)sm.indexCount * (sm.index16 ? 2 : 4));
 
         if (usedWhite || usedMagenta) {
             DiagnoseAndReportTextureIssue(i, sm, matPtr, srv, usedMagenta, usedWhite);
@@ -346,6 +470,37 @@ void ModelRenderComponent::Draw() {
     }
 }
 
+void ModelRenderComponent::DrawDepthOnly(const XMMATRIX& view, const XMMATRIX& proj) {
+    if (!m_ready || !m_model || m_depthStreamCount == 0) return;
+    if (!EnsureDepthShader()) return;
+
+    CBData cbd;
+    cbd.World = XMMatrixTranspose(BuildWorldMatrix());
+    cbd.View = XMMatrixTranspose(view);
+    cbd.Proj = XMMatrixTranspose(proj);
+    cbd.BaseColor = m_color;
+
+    auto ctx = DirectX11::GetInstance()->GetContext();
+    ctx->UpdateSubresource(m_cb.Get(), 0, nullptr, &cbd, 0, 0);
+
+    // ʒũXg[𑩂˂ (ĂȂf͈ʒu܂ރXg[Ɠǂ)
+    const uint32_t vertexStride = BindStreams(ctx, m_depthStreams, m_depthStreamCount);
+    ctx->IASetInputLayout(m_depthLayout.Get());
+    ctx->VSSetShader(m_depthVs.Get(), nullptr, 0);
+    ctx->PSSetShader(nullptr, nullptr, 0);
+    ID3D11Buffer* cbs[] = { m_cb.Get(), m_packCb.Get() };
+    ctx->VSSetConstantBuffers(0, 2, cbs);
+    SetPositionDequant(ctx, nullptr);
+
+    DXGI_FORMAT boundFormat = DXGI_FORMAT_UNKNOWN;
+    for (const SubMesh& sm : m_model->submeshes) {
+        SetPositionDequant(ctx, &sm);
+        DrawSubMesh(ctx, sm, boundFormat);
+        ModelManager::Instance()->AccountDraw(true, (uint64_t)sm.vertexCount * vertexStride,
+            (uint64_t)sm.vertexCount * sizeof(ModelVertex), (uint64_t)sm.indexCount * (sm.index16 ? 2 : 4));
+    }
+}
+
 void ModelRenderComponent::SaveToFile(std::ostream& out) {
     out << m_modelPath << "\n";
     out << m_color.x << " " << m_color.y << " " << m_color.z << " " << m_color.w << "\n";
@@ -381,6 +536,21 @@ void ModelRenderComponent::DrawInspector() {
     if (ImGui::Button(SJ("fI...").c_str())) ImGui::OpenPopup("ModelSelectPopup");
     ShowModelSelectPopup();
 
+    if (IsPacked()) {
+        ImGui::Text("%s %s (VS: %s)", SJ("_`:").c_str(),
+            VertexPack::LayoutName(m_model->vertexLayout).c_str(), s_packedVSName.c_str());
+    }
+    if (m_model) {
+        uint32_t mainBytes = 0, depthBytes = 0;
+        for (uint32_t i = 0; i < m_mainStreamCount; ++i) mainBytes += m_model->streams[m_mainStreams[i]].stride;
+        for (uint32_t i = 0; i < m_depthStreamCount; ++i) depthBytes += m_model->streams[m_depthStreams[i]].stride;
+        ImGui::Text("%s %s (main %u B, depth %u B)", SJ("_Xg[:").c_str(),
+            VertexPack::StreamsName(*m_model).c_str(), mainBytes, depthBytes);
+        ImGui::Text("%s %s (%.1f KB)", SJ("CfbNX:").c_str(),
+            IndexPack::FormatName(m_model->indexFormat), m_model->indexBytes / 1024.0);
+        ImGui::Text("%s %zu", SJ("bVbg:").c_str(), m_model->meshlets.meshlets.size());
+    }
+
     if (ImGui::TreeNode(SJ("VF[_ݒ").c_str())) {
         auto* sm = ShaderManager::GetInstance();
         static std::vector<std::string> vsList;
@@ -40,6 +40,9 @@ public:
     void SetColor(const DirectX::XMFLOAT4& c) { m_color = c; }
     DirectX::XMFLOAT4 GetColor() const { return m_color; }
 
+    // ʒuǂŐ[x (e / [x̐s`p)B`Ɛ[xobt@͌ĂяoŐݒ肷
+    void DrawDepthOnly(const DirectX::XMMATRIX& view, const DirectX::XMMATRIX& proj);
+
     void SaveToFile(std::ostream& out) override;
     void LoadFromFile(std::istream& in) override;
 
@@ -50,6 +53,11 @@ private:
         DirectX::XMMATRIX Proj;
         DirectX::XMFLOAT4 BaseColor;
     };
+    // l߂_̈ʒűtʎq (VS_ModelPacked  b1)
+    struct PackCBData {
+        DirectX::XMFLOAT4 PosScale;
+        DirectX::XMFLOAT4 PosBias;
+    };
     struct MaterialRuntime {
         std::string                          texName;
         std::shared_ptr<TextureResource>     tex;
@@ -58,6 +66,16 @@ private:
 
     bool EnsureShaders(bool forceRecreateLayout = false);
     bool EnsureInputLayout(const void* vsBytecode, size_t size);
+    bool EnsureDepthShader();
+    // m_model->streams I񂾃Xg[ 0 Ԃ珇ɑ˂̓CAEg
+    bool CreateStreamLayout(const uint32_t* streams, uint32_t count, const void* vsBytecode, size_t size,
+        Microsoft::WRL::ComPtr<ID3D11InputLayout>& out);
+    void SelectModelStreams();
+    // I񂾃Xg[𑩂˂āATubVɓǂރoCg ModelManager ֋L^鏀
+    uint32_t BindStreams(ID3D11DeviceContext* ctx, const uint32_t* streams, uint32_t count);
+    void SetPositionDequant(ID3D11DeviceContext* ctx, const SubMesh* sm);
+    // TubṼCfbNX` (uint16 / uint32) ̑˕ƈႦΑ˒ĕ`
+    void DrawSubMesh(ID3D11DeviceContext* ctx, const SubMesh& sm, DXGI_FORMAT& boundFormat);
     bool EnsureConstantBuffer();
     void RefreshMaterialCache();
 
@@ -65,6 +83,9 @@ private:
     void ShowTextureSelectPopup(int materialIndex);
 
     void RecreateInputLayout();
+    // l߂_̃f m_vsName Ɋ֌WȂ VS_ModelPacked ŕ`
+    bool IsPacked() const { return m_model && m_model->vertexLayout.baseStride != 0; }
+    const std::string& ActiveVSName() const;
     DirectX::XMMATRIX BuildWorldMatrix() const;
 
     bool EnsureWhiteTexture();
@@ -85,15 +106,26 @@ private:
     DirectX::XMFLOAT4 m_color{ 1,1,1,1 };
 
     Microsoft::WRL::ComPtr<ID3D11Buffer>        m_cb;
+    Microsoft::WRL::ComPtr<ID3D11Buffer>        m_packCb;
 
     // ȑO static ̂CX^Xo
     Microsoft::WRL::ComPtr<ID3D11VertexShader>  m_vs;
     Microsoft::WRL::ComPtr<ID3D11PixelShader>   m_ps;
     Microsoft::WRL::ComPtr<ID3D11InputLayout>   m_layout;
+    Microsoft::WRL::ComPtr<ID3D11VertexShader>  m_depthVs;
+    Microsoft::WRL::ComPtr<ID3D11InputLayout>   m_depthLayout;
+
+    // pX / [x̃pXő˂Xg[ (ModelSharedResource::SelectStreams)
+    uint32_t m_mainStreams[ModelSharedResource::kMaxStreams] = {};
+    uint32_t m_mainStreamCount = 0;
+    uint32_t m_depthStreams[ModelSharedResource::kMaxStreams] = {};
+    uint32_t m_depthStreamCount = 0;
 
     // VF[_ێ
     std::string m_vsName = "VS_ModelStatic";
     std::string m_psName = "PS_ModelStatic";
+    static const std::string s_packedVSName;
+    static const std::string s_depthVSName;
 
     // Lŗǂ̂ static ̂܂
     static Microsoft::WRL::ComPtr<ID3D11SamplerState>        s_linearSmp;
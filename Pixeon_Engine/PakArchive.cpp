@@ -0,0 +1,709 @@
+#include "PakArchive.h"
+#include "ErrorLog.h"
+#include "LZ4Util.h"
+#include "HashUtill.h"
+#include <algorithm>
+#include <cstring>
+
+PakArchive::~PakArchive() {
+    Close();
+}
+
+// 先頭の "./" と "/" を取り除く ('\\' も '/' とみなす)
+static std::string_view StripKeyPrefix(std::string_view s) {
+    for (;;) {
+        if (s.size() >= 2 && s[0] == '.' && (s[1] == '/' || s[1] == '\\')) s.remove_prefix(2);
+        else if (!s.empty() && (s[0] == '/' || s[0] == '\\')) s.remove_prefix(1);
+        else return s;
+    }
+}
+
+static char NormalizeKeyChar(char c) {
+    if (c == '\\') return '/';
+    return (char)tolower((unsigned char)c);
+}
+
+// ペイロードがヘッダと TOC の間に収まっているか (v3 はマウント時に検証しないので読み出し時に確認する)
+static bool EntryInRange(const PakHeader& header, const PakArchive::Entry& entry) {
+    return entry.offset >= sizeof(PakHeader) && entry.storedSize <= header.tocOffset &&
+        entry.offset <= header.tocOffset - entry.storedSize;
+}
+
+uint64_t PakArchive::HashKey(std::string_view logicalName) {
+    std::string_view s = StripKeyPrefix(logicalName);
+    return PakPathHash(s.data(), s.size());
+}
+
+bool PakArchive::KeyEquals(std::string_view logicalName, std::string_view path) {
+    std::string_view s = StripKeyPrefix(logicalName);
+    if (s.size() != path.size()) return false;
+    for (size_t i = 0; i < s.size(); ++i) {
+        if (NormalizeKeyChar(s[i]) != NormalizeKeyChar(path[i])) return false;
+    }
+    return true;
+}
+
+bool PakArchive::Open(const std::string& archivePath) {
+    Close();
+
+    m_file_ = CreateFileA(archivePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (m_file_ == INVALID_HANDLE_VALUE) {
+        ErrorLogger::Instance().LogError("PakArchive", "Failed to open archive: " + archivePath);
+        return false;
+    }
+    LARGE_INTEGER li{};
+    if (!GetFileSizeEx(m_file_, &li)) {
+        ErrorLogger::Instance().LogError("PakArchive", "GetFileSizeEx failed: " + archivePath);
+        Close();
+        return false;
+    }
+    m_fileSize_ = (uint64_t)li.QuadPart;
+
+    // ヘッダ
+    if (m_fileSize_ < sizeof(PakHeader) || !ReadAt(0, &m_header_, sizeof(PakHeader))) {
+        ErrorLogger::Instance().LogError("PakArchive", "Header read failed: " + archivePath);
+        Close();
+        return false;
+    }
+    if (memcmp(m_header_.magic, "PIXPAK\0", 8) != 0) {
+        ErrorLogger::Instance().LogError("PakArchive", "Invalid magic: " + archivePath);
+        Close();
+        return false;
+    }
+    if (m_header_.version < 1 || m_header_.version > 3) {
+        ErrorLogger::Instance().LogError("PakArchive", "Unsupported version " +
+            std::to_string(m_header_.version) + ": " + archivePath);
+        Close();
+        return false;
+    }
+    if (m_header_.tocOffset < sizeof(PakHeader) || m_header_.tocOffset > m_fileSize_) {
+        ErrorLogger::Instance().LogError("PakArchive", "Invalid TOC offset: " + archivePath);
+        Close();
+        return false;
+    }
+
+    // v3 はマップした TOC をそのまま使うので先にマップする
+    MapView();
+
+    if (m_header_.version >= 3) {
+        if (!LoadTOCv3()) {
+            ErrorLogger::Instance().LogError("PakArchive", "TOC v3 load failed: " + archivePath);
+            Close();
+            return false;
+        }
+    }
+    else {
+        // v1 / v2 の TOC はファイル末尾まで一括で読み込んでから v3 と同じ形へ変換する
+        std::vector<uint8_t> toc((size_t)(m_fileSize_ - m_header_.tocOffset));
+        if (!toc.empty() && !ReadAt(m_header_.tocOffset, toc.data(), toc.size())) {
+            ErrorLogger::Instance().LogError("PakArchive", "TOC read failed: " + archivePath);
+            Close();
+            return false;
+        }
+        if (!ParseLegacyTOC(toc)) {
+            ErrorLogger::Instance().LogError("PakArchive", "TOC parse failed: " + archivePath);
+            Close();
+            return false;
+        }
+    }
+
+    if (!LoadDictionary()) {
+        ErrorLogger::Instance().LogError("PakArchive", "Dictionary load failed: " + archivePath);
+        Close();
+        return false;
+    }
+
+    // セクタ境界に揃えて書かれたアーカイブだけ非バッファリングで読める
+    if (m_header_.alignment >= kDirectSector && m_header_.alignment % kDirectSector == 0) {
+        m_direct_ = CreateFileA(archivePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_FLAG_NO_BUFFERING | FILE_FLAG_OVERLAPPED, nullptr);
+        if (m_direct_ == INVALID_HANDLE_VALUE) {
+            OutputDebugStringA("[PakArchive] Unbuffered open failed, using buffered reads only.\n");
+        }
+    }
+
+    HashUtil::InitCRC32();
+
+    m_path_ = archivePath;
+    char dbg[256];
+    sprintf_s(dbg, "[PakArchive] Mounted %s (v%u, %u files, mapped=%d)\n",
+        archivePath.c_str(), m_header_.version, m_header_.fileCount, IsMapped() ? 1 : 0);
+    OutputDebugStringA(dbg);
+    return true;
+}
+
+void PakArchive::MapView() {
+    // 32bit ビルドなどでアドレス空間が足りない場合はマップせず ReadFile 経路のみ使う
+    if (m_fileSize_ == 0 || m_fileSize_ > (uint64_t)SIZE_MAX) return;
+    m_mapping_ = CreateFileMappingA(m_file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_mapping_) {
+        OutputDebugStringA("[PakArchive] CreateFileMapping failed, falling back to ReadFile.\n");
+        return;
+    }
+    m_base_ = static_cast<const uint8_t*>(MapViewOfFile(m_mapping_, FILE_MAP_READ, 0, 0, 0));
+    if (!m_base_) {
+        OutputDebugStringA("[PakArchive] MapViewOfFile failed, falling back to ReadFile.\n");
+        CloseHandle(m_mapping_);
+        m_mapping_ = nullptr;
+    }
+}
+
+void PakArchive::Close() {
+    if (m_base_) {
+        UnmapViewOfFile(m_base_);
+        m_base_ = nullptr;
+    }
+    if (m_mapping_) {
+        CloseHandle(m_mapping_);
+        m_mapping_ = nullptr;
+    }
+    if (m_file_ != INVALID_HANDLE_VALUE) {
+        CloseHandle(m_file_);
+        m_file_ = INVALID_HANDLE_VALUE;
+    }
+    if (m_direct_ != INVALID_HANDLE_VALUE) {
+        CloseHandle(m_direct_);
+        m_direct_ = INVALID_HANDLE_VALUE;
+    }
+    m_fileSize_ = 0;
+    m_header_ = PakHeader{};
+    m_path_.clear();
+    m_table_ = nullptr;
+    m_count_ = 0;
+    m_pool_ = nullptr;
+    m_poolSize_ = 0;
+    m_tocBuf_.clear();
+    m_verifyState_.reset();
+    m_payloadOwner_.clear();
+    m_sharedCount_ = 0;
+    m_legacyEntries_.clear();
+    m_legacyPool_.clear();
+    m_dict_.clear();
+}
+
+bool PakArchive::LoadDictionary() {
+    m_dict_.clear();
+    if (!HasFlag((uint16_t)m_header_.flags, AssetFlag_Dictionary)) return true;
+    const uint64_t size = m_header_.dictSize;
+    if (size == 0 || size > kLZ4DictMaxSize || size > m_header_.tocOffset || m_header_.dictOffset < sizeof(PakHeader) ||
+        m_header_.dictOffset > m_header_.tocOffset - size) return false;
+    m_dict_.resize((size_t)size);
+    if (!ReadAt(m_header_.dictOffset, m_dict_.data(), size)) return false;
+    // 辞書が壊れていると全ての LZ4Dict エントリが化けるので、検証の設定に関係なく確かめる
+    HashUtil::InitCRC32();
+    return HashUtil::CalcCRC32(m_dict_.data(), m_dict_.size()) == m_header_.dictCrc32;
+}
+
+bool PakArchive::LoadTOCv3() {
+    const uint64_t tocSize = m_fileSize_ - m_header_.tocOffset;
+    if (tocSize < sizeof(PakTocHeaderV3) || m_header_.tocOffset % alignof(Entry) != 0) return false;
+
+    const uint8_t* toc = nullptr;
+    if (m_base_) {
+        toc = m_base_ + m_header_.tocOffset;
+    }
+    else {
+        m_tocBuf_.resize((size_t)tocSize);
+        if (!ReadAt(m_header_.tocOffset, m_tocBuf_.data(), tocSize)) return false;
+        toc = m_tocBuf_.data();
+    }
+
+    PakTocHeaderV3 th{};
+    memcpy(&th, toc, sizeof(th));
+    if (th.entryStride != sizeof(Entry) || th.entryCount != m_header_.fileCount) return false;
+    const uint64_t tableEnd = sizeof(th) + (uint64_t)th.entryCount * sizeof(Entry);
+    if (tableEnd > tocSize || th.stringPoolOffset < tableEnd ||
+        th.stringPoolSize > tocSize - th.stringPoolOffset) return false;
+
+    // エントリ毎の検証は読み出し時に行う (マウント時に全エントリへ触れない)
+    m_table_ = reinterpret_cast<const Entry*>(toc + sizeof(th));
+    m_count_ = th.entryCount;
+    m_pool_ = reinterpret_cast<const char*>(toc + th.stringPoolOffset);
+    m_poolSize_ = th.stringPoolSize;
+    return true;
+}
+
+bool PakArchive::ParseLegacyTOC(const std::vector<uint8_t>& toc) {
+    // TOC v1: (nameLen, name, compression, 3*res, crc32, originalSize, storedSize, offset)
+    // TOC v2: 上記 + sha256[32]
+    const size_t fixedSize = 1 + 3 + 4 + 8 + 8 + 8 + (m_header_.version >= 2 ? 32 : 0);
+    const uint8_t* p = toc.data();
+    const uint8_t* end = p + toc.size();
+
+    m_legacyEntries_.clear();
+    m_legacyEntries_.reserve(m_header_.fileCount);
+    m_legacyPool_.clear();
+
+    for (uint32_t i = 0; i < m_header_.fileCount; ++i) {
+        if ((size_t)(end - p) < sizeof(uint16_t)) return false;
+        uint16_t nameLen = 0;
+        memcpy(&nameLen, p, sizeof(nameLen));
+        p += sizeof(nameLen);
+        if ((size_t)(end - p) < nameLen + fixedSize) return false;
+
+        Entry e{};
+        e.nameOffset = (uint32_t)m_legacyPool_.size();
+        e.nameLen = nameLen;
+        e.pathHash = PakPathHash(reinterpret_cast<const char*>(p), nameLen);
+        m_legacyPool_.insert(m_legacyPool_.end(), p, p + nameLen);
+        p += nameLen;
+        e.compression = *p;
+        p += 1 + 3;
+        memcpy(&e.crc32, p, 4);         p += 4;
+        memcpy(&e.originalSize, p, 8);  p += 8;
+        memcpy(&e.storedSize, p, 8);    p += 8;
+        memcpy(&e.offset, p, 8);        p += 8;
+        if (m_header_.version >= 2) {
+            memcpy(e.sha256, p, 32);
+            p += 32;
+        }
+
+        if (e.offset + e.storedSize > m_header_.tocOffset) return false;
+        m_legacyEntries_.push_back(e);
+    }
+
+    m_pool_ = m_legacyPool_.data();
+    m_poolSize_ = m_legacyPool_.size();
+    std::sort(m_legacyEntries_.begin(), m_legacyEntries_.end(), [this](const Entry& a, const Entry& b) {
+        if (a.pathHash != b.pathHash) return a.pathHash < b.pathHash;
+        return GetEntryPath(a) < GetEntryPath(b);
+    });
+    m_table_ = m_legacyEntries_.data();
+    m_count_ = m_legacyEntries_.size();
+    return true;
+}
+
+const PakArchive::Entry* PakArchive::Find(std::string_view logicalName) const {
+    const uint64_t h = HashKey(logicalName);
+    const Entry* end = m_table_ + m_count_;
+    const Entry* it = std::lower_bound(m_table_, end, h,
+        [](const Entry& e, uint64_t key) { return e.pathHash < key; });
+    for (; it != end && it->pathHash == h; ++it) {
+        if (KeyEquals(logicalName, GetEntryPath(*it))) return it;
+    }
+    return nullptr;
+}
+
+std::string_view PakArchive::GetEntryPath(const Entry& entry) const {
+    if ((uint64_t)entry.nameOffset + entry.nameLen > m_poolSize_) return {};
+    return std::string_view(m_pool_ + entry.nameOffset, entry.nameLen);
+}
+
+const uint8_t* PakArchive::GetMappedData(const Entry& entry) const {
+    if (!m_base_) return nullptr;
+    if (entry.compression != (uint8_t)AssetCompression::None) return nullptr;
+    if (!EntryInRange(m_header_, entry)) return nullptr;
+    if (!VerifyFirstRead(entry, m_base_ + entry.offset, (size_t)entry.storedSize)) return nullptr;
+    return m_base_ + entry.offset;
+}
+
+// 同じ格納データを指すエントリをまとめ、最も前に並ぶエントリを検証状態の持ち主にする。
+// TOC 全体の並べ替えになるので、検証を初めて有効にした時だけ作る
+void PakArchive::BuildPayloadOwners() {
+    m_payloadOwner_.clear();
+    m_sharedCount_ = 0;
+    if (m_count_ < 2) return;
+    std::vector<uint32_t> order(m_count_);
+    for (size_t i = 0; i < m_count_; ++i) order[i] = (uint32_t)i;
+    std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+        const Entry& ea = m_table_[a];
+        const Entry& eb = m_table_[b];
+        if (ea.offset != eb.offset) return ea.offset < eb.offset;
+        if (ea.storedSize != eb.storedSize) return ea.storedSize < eb.storedSize;
+        return a < b;
+    });
+    for (size_t i = 1; i < order.size(); ++i) {
+        const Entry& prev = m_table_[order[i - 1]];
+        const Entry& cur = m_table_[order[i]];
+        if (cur.offset != prev.offset || cur.storedSize != prev.storedSize) continue;
+        if (m_payloadOwner_.empty()) {
+            m_payloadOwner_.resize(m_count_);
+            for (size_t k = 0; k < m_count_; ++k) m_payloadOwner_[k] = (uint32_t)k;
+        }
+        m_payloadOwner_[order[i]] = m_payloadOwner_[order[i - 1]];
+        ++m_sharedCount_;
+    }
+}
+
+size_t PakArchive::VerifyIndex(const Entry& entry) const {
+    size_t index = (size_t)(&entry - m_table_);
+    if (index < m_payloadOwner_.size()) return m_payloadOwner_[index];
+    return index;
+}
+
+bool PakArchive::IsSharedPayload(const Entry& entry) const {
+    size_t index = (size_t)(&entry - m_table_);
+    return index < m_payloadOwner_.size() && m_payloadOwner_[index] != index;
+}
+
+void PakArchive::SetVerify(bool enable) {
+    // 検証しないマウントでは確保しない
+    if (enable && !m_verifyState_) {
+        BuildPayloadOwners();
+        m_verifyState_ = std::make_unique<std::atomic<uint8_t>[]>(m_count_);
+    }
+    m_verify_.store(enable);
+}
+
+PakArchive::VerifyState PakArchive::GetVerifyState(const Entry& entry) const {
+    size_t index = VerifyIndex(entry);
+    if (!m_verifyState_ || index >= m_count_) return VerifyState::Unchecked;
+    return (VerifyState)m_verifyState_[index].load(std::memory_order_acquire);
+}
+
+void PakArchive::MarkVerified(const Entry& entry, bool ok) const {
+    size_t index = VerifyIndex(entry);
+    if (!m_verifyState_ || index >= m_count_) return;
+    m_verifyState_[index].store((uint8_t)(ok ? VerifyState::Ok : VerifyState::Corrupt), std::memory_order_release);
+}
+
+// 検証が有効なら未確認のエントリだけ CRC32 を計算する (同時に初回読み込みが来ても結果は同じなので排他しない)
+bool PakArchive::VerifyFirstRead(const Entry& entry, const uint8_t* data, size_t size) const {
+    if (!m_verify_.load(std::memory_order_relaxed)) return true;
+    VerifyState state = GetVerifyState(entry);
+    if (state == VerifyState::Ok) return true;
+    if (state == VerifyState::Corrupt) {
+        ErrorLogger::Instance().LogError("PakArchive", "Corrupt entry: " + std::string(GetEntryPath(entry)));
+        return false;
+    }
+    bool ok = HashUtil::CalcCRC32(data, size) == entry.crc32;
+    MarkVerified(entry, ok);
+    if (!ok) {
+        ErrorLogger::Instance().LogError("PakArchive", "CRC32 mismatch: " + std::string(GetEntryPath(entry)) +
+            " (" + m_path_ + ")");
+    }
+    return ok;
+}
+
+bool PakArchive::Read(const Entry& entry, std::vector<uint8_t>& outData) const {
+    if (!IsOpen()) return false;
+    if (!EntryInRange(m_header_, entry)) {
+        ErrorLogger::Instance().LogError("PakArchive", "Entry out of range: " + std::string(GetEntryPath(entry)));
+        return false;
+    }
+    if (entry.compression == (uint8_t)AssetCompression::LZ4) {
+        return ReadLZ4(entry, outData) && VerifyFirstRead(entry, outData.data(), outData.size());
+    }
+    if (entry.compression == (uint8_t)AssetCompression::LZ4Dict) {
+        return ReadDict(entry, outData) && VerifyFirstRead(entry, outData.data(), outData.size());
+    }
+    if (entry.compression != (uint8_t)AssetCompression::None) {
+        ErrorLogger::Instance().LogError("PakArchive", "Unsupported compression: " + std::string(GetEntryPath(entry)));
+        return false;
+    }
+    outData.resize((size_t)entry.storedSize);
+    if (entry.storedSize == 0) return true;
+    if (CanReadDirect(entry)) {
+        std::shared_ptr<uint8_t> block;
+        size_t skip = 0;
+        if (ReadDirectRange(entry.offset, entry.storedSize, block, skip)) {
+            memcpy(outData.data(), block.get() + skip, (size_t)entry.storedSize);
+            return VerifyFirstRead(entry, outData.data(), outData.size());
+        }
+    }
+    if (!ReadAt(entry.offset, outData.data(), entry.storedSize)) {
+        ErrorLogger::Instance().LogError("PakArchive", "Read failed: " + std::string(GetEntryPath(entry)));
+        return false;
+    }
+    return VerifyFirstRead(entry, outData.data(), outData.size());
+}
+
+bool PakArchive::ReadLZ4(const Entry& entry, std::vector<uint8_t>& outData) const {
+    outData.resize((size_t)entry.originalSize);
+    if (entry.originalSize == 0) return true;
+
+    // 大きいエントリは圧縮データをページキャッシュを通さずに読んでから展開する
+    if (CanReadDirect(entry)) {
+        std::shared_ptr<uint8_t> block;
+        size_t skip = 0;
+        if (ReadDirectRange(entry.offset, entry.storedSize, block, skip)) {
+            if (!LZ4Util::DecompressChunked(block.get() + skip, (size_t)entry.storedSize,
+                outData.data(), outData.size())) {
+                ErrorLogger::Instance().LogError("PakArchive", "LZ4 decode failed: " + std::string(GetEntryPath(entry)));
+                return false;
+            }
+            return true;
+        }
+    }
+
+    // マップ済みならページ上から直接展開する (中間バッファ無し)
+    if (m_base_) {
+        if (!LZ4Util::DecompressChunked(m_base_ + entry.offset, (size_t)entry.storedSize,
+            outData.data(), outData.size())) {
+            ErrorLogger::Instance().LogError("PakArchive", "LZ4 decode failed: " + std::string(GetEntryPath(entry)));
+            return false;
+        }
+        return true;
+    }
+
+    // 未マップ時は 1MB 単位で読みながら展開する。途中までのチャンクは次の読み込みへ持ち越す
+    const size_t kWindow = 1024 * 1024;
+    std::vector<uint8_t> buf;
+    buf.reserve(kWindow + kLZ4ChunkSize + 4);
+    uint64_t readPos = 0;
+    size_t produced = 0;
+    while (produced < outData.size()) {
+        size_t n = (size_t)std::min<uint64_t>(kWindow, entry.storedSize - readPos);
+        if (n == 0) break;
+        size_t at = buf.size();
+        buf.resize(at + n);
+        if (!ReadAt(entry.offset + readPos, buf.data() + at, n)) {
+            ErrorLogger::Instance().LogError("PakArchive", "Read failed: " + std::string(GetEntryPath(entry)));
+            return false;
+        }
+        readPos += n;
+
+        size_t consumed = 0, made = 0;
+        if (!LZ4Util::DecompressChunkedPartial(buf.data(), buf.size(),
+            outData.data() + produced, outData.size() - produced, consumed, made)) {
+            ErrorLogger::Instance().LogError("PakArchive", "LZ4 decode failed: " + std::string(GetEntryPath(entry)));
+            return false;
+        }
+        produced += made;
+        buf.erase(buf.begin(), buf.begin() + consumed);
+    }
+    if (produced != outData.size() || readPos != entry.storedSize || !buf.empty()) {
+        ErrorLogger::Instance().LogError("PakArchive", "LZ4 size mismatch: " + std::string(GetEntryPath(entry)));
+        return false;
+    }
+    return true;
+}
+
+// LZ4Dict は小さいファイル用の 1 ブロックなので、格納データをまとめて読んで展開する
+bool PakArchive::ReadDict(const Entry& entry, std::vector<uint8_t>& outData) const {
+    outData.resize((size_t)entry.originalSize);
+    if (m_base_) return DecodeDict(entry, m_base_ + entry.offset, outData.data());
+    std::vector<uint8_t> stored((size_t)entry.storedSize);
+    if (!ReadAt(entry.offset, stored.data(), entry.storedSize)) {
+        ErrorLogger::Instance().LogError("PakArchive", "Read failed: " + std::string(GetEntryPath(entry)));
+        return false;
+    }
+    return DecodeDict(entry, stored.data(), outData.data());
+}
+
+bool PakArchive::DecodeDict(const Entry& entry, const uint8_t* stored, uint8_t* dst) const {
+    if (m_dict_.empty() || entry.originalSize > kLZ4ChunkSize || !LZ4Util::DecompressBlockDict(m_dict_.data(),
+        m_dict_.size(), stored, (size_t)entry.storedSize, dst, (size_t)entry.originalSize)) {
+        ErrorLogger::Instance().LogError("PakArchive", "LZ4Dict decode failed: " + std::string(GetEntryPath(entry)));
+        return false;
+    }
+    return true;
+}
+
+bool PakArchive::Stream(const Entry& entry, const std::function<bool(const uint8_t*, size_t)>& sink) const {
+    if (!IsOpen() || !EntryInRange(m_header_, entry)) return false;
+    if (entry.compression == (uint8_t)AssetCompression::LZ4Dict) {
+        std::vector<uint8_t> data;
+        return ReadDict(entry, data) && sink(data.data(), data.size());
+    }
+    const bool lz4 = entry.compression == (uint8_t)AssetCompression::LZ4;
+    if (!lz4 && entry.compression != (uint8_t)AssetCompression::None) return false;
+
+    const size_t kWindow = 1024 * 1024;
+    std::vector<uint8_t> in;
+    std::vector<uint8_t> out;
+    in.reserve(kWindow + kLZ4ChunkSize + 4);
+    if (lz4) out.resize(kWindow);
+    uint64_t readPos = 0;
+    uint64_t produced = 0;
+    for (;;) {
+        // LZ4: 読み込み済みの範囲で展開できるチャンクを先に渡す
+        if (lz4 && produced < entry.originalSize) {
+            size_t consumed = 0, made = 0;
+            size_t want = (size_t)std::min<uint64_t>(out.size(), entry.originalSize - produced);
+            if (!LZ4Util::DecompressChunkedPartial(in.data(), in.size(), out.data(), want, consumed, made)) {
+                ErrorLogger::Instance().LogError("PakArchive", "LZ4 decode failed: " + std::string(GetEntryPath(entry)));
+                return false;
+            }
+            if (made > 0) {
+                in.erase(in.begin(), in.begin() + consumed);
+                produced += made;
+                if (!sink(out.data(), made)) return false;
+                continue;
+            }
+        }
+        if (readPos >= entry.storedSize) break;
+
+        size_t n = (size_t)std::min<uint64_t>(kWindow, entry.storedSize - readPos);
+        size_t at = lz4 ? in.size() : 0;
+        in.resize(at + n);
+        // 巡回などの一度きりの読み込みでゲーム側のページキャッシュを追い出さないよう、可能なら非バッファリングで読む
+        bool read = false;
+        if (HasDirectHandle()) {
+            std::shared_ptr<uint8_t> block;
+            size_t skip = 0;
+            if (ReadDirectRange(entry.offset + readPos, n, block, skip)) {
+                memcpy(in.data() + at, block.get() + skip, n);
+                read = true;
+            }
+        }
+        if (!read && !ReadAt(entry.offset + readPos, in.data() + at, n)) {
+            ErrorLogger::Instance().LogError("PakArchive", "Read failed: " + std::string(GetEntryPath(entry)));
+            return false;
+        }
+        readPos += n;
+        if (!lz4) {
+            produced += n;
+            if (!sink(in.data(), n)) return false;
+        }
+    }
+    if (produced != entry.originalSize || (lz4 && !in.empty())) {
+        ErrorLogger::Instance().LogError("PakArchive", "Stream size mismatch: " + std::string(GetEntryPath(entry)));
+        return false;
+    }
+    return true;
+}
+
+bool PakArchive::CanReadDirect(const Entry& entry) const {
+    return m_directEnabled_ && m_direct_ != INVALID_HANDLE_VALUE && entry.storedSize >= kDirectReadMin &&
+        EntryInRange(m_header_, entry);
+}
+
+bool PakArchive::ReadDirect(const Entry& entry, std::shared_ptr<const void>& outOwner, const uint8_t*& outData) const {
+    if (entry.compression != (uint8_t)AssetCompression::None || !CanReadDirect(entry)) return false;
+    std::shared_ptr<uint8_t> block;
+    size_t skip = 0;
+    if (!ReadDirectRange(entry.offset, entry.storedSize, block, skip)) return false;
+    if (!VerifyFirstRead(entry, block.get() + skip, (size_t)entry.storedSize)) return false;
+    outData = block.get() + skip;
+    outOwner = std::move(block);
+    return true;
+}
+
+bool PakArchive::ReadRange(uint64_t offset, uint64_t size, std::vector<uint8_t>& scratch, const uint8_t*& outData) const {
+    if (!IsOpen() || offset < sizeof(PakHeader) || size > m_header_.tocOffset || offset > m_header_.tocOffset - size) return false;
+    if (m_base_) {
+        // ページフォルトを 1 ページずつ待たずに、範囲全体の読み込みを先に発行しておく
+        WIN32_MEMORY_RANGE_ENTRY range{ const_cast<uint8_t*>(m_base_ + offset), (SIZE_T)size };
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+        outData = m_base_ + offset;
+        return true;
+    }
+    if (scratch.size() < size) scratch.resize((size_t)size);
+    if (!ReadAt(offset, scratch.data(), size)) {
+        ErrorLogger::Instance().LogError("PakArchive", "Range read failed: " + m_path_);
+        return false;
+    }
+    outData = scratch.data();
+    return true;
+}
+
+bool PakArchive::Decode(const Entry& entry, const uint8_t* stored, std::vector<uint8_t>& outData) const {
+    if (entry.compression == (uint8_t)AssetCompression::LZ4) {
+        outData.resize((size_t)entry.originalSize);
+        if (entry.originalSize > 0 && !LZ4Util::DecompressChunked(stored, (size_t)entry.storedSize,
+            outData.data(), outData.size())) {
+            ErrorLogger::Instance().LogError("PakArchive", "LZ4 decode failed: " + std::string(GetEntryPath(entry)));
+            return false;
+        }
+    }
+    else if (entry.compression == (uint8_t)AssetCompression::LZ4Dict) {
+        outData.resize((size_t)entry.originalSize);
+        if (!DecodeDict(entry, stored, outData.data())) return false;
+    }
+    else if (entry.compression == (uint8_t)AssetCompression::None) {
+        outData.assign(stored, stored + entry.storedSize);
+    }
+    else {
+        ErrorLogger::Instance().LogError("PakArchive", "Unsupported compression: " + std::string(GetEntryPath(entry)));
+        return false;
+    }
+    return VerifyFirstRead(entry, outData.data(), outData.size());
+}
+
+// [offset, offset + size) を含むセクタ境界の範囲を VirtualAlloc した領域へ読む。
+// 1MB ずつ最大 kDepth 本の要求を同時に発行してデバイスのキューを切らさない。
+// outSkip は領域先頭から offset までのバイト数 (小ファイルをまとめたブロック内のエントリは 0 にならない)
+bool PakArchive::ReadDirectRange(uint64_t offset, uint64_t size, std::shared_ptr<uint8_t>& outBlock, size_t& outSkip) const {
+    const uint64_t begin = offset & ~(kDirectSector - 1);
+    const uint64_t end = (offset + size + kDirectSector - 1) & ~(kDirectSector - 1);
+    const size_t total = (size_t)(end - begin);
+    uint8_t* mem = static_cast<uint8_t*>(VirtualAlloc(nullptr, total, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+    if (!mem) return false;
+    std::shared_ptr<uint8_t> block(mem, [](uint8_t* p) { VirtualFree(p, 0, MEM_RELEASE); });
+
+    const size_t kSegment = 1024 * 1024;
+    const int kDepth = 4;
+    struct Request {
+        OVERLAPPED ov;
+        size_t pos;
+        DWORD len;
+    };
+    Request reqs[kDepth] = {};
+    HANDLE events[kDepth] = {};
+    bool ok = true;
+    for (int i = 0; i < kDepth && ok; ++i) {
+        events[i] = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+        ok = events[i] != nullptr;
+    }
+
+    size_t issuePos = 0;
+    int head = 0;
+    int inFlight = 0;
+    while (ok && (issuePos < total || inFlight > 0)) {
+        while (ok && inFlight < kDepth && issuePos < total) {
+            int slot = (head + inFlight) % kDepth;
+            Request& r = reqs[slot];
+            r = Request{};
+            r.ov.hEvent = events[slot];
+            uint64_t at = begin + issuePos;
+            r.ov.Offset = (DWORD)at;
+            r.ov.OffsetHigh = (DWORD)(at >> 32);
+            r.pos = issuePos;
+            r.len = (DWORD)std::min<size_t>(kSegment, total - issuePos);
+            if (!ReadFile(m_direct_, mem + issuePos, r.len, nullptr, &r.ov) && GetLastError() != ERROR_IO_PENDING) {
+                ok = false;
+                break;
+            }
+            issuePos += r.len;
+            ++inFlight;
+        }
+        if (!ok || inFlight == 0) break;
+
+        Request& r = reqs[head];
+        DWORD got = 0;
+        if (!GetOverlappedResult(m_direct_, &r.ov, &got, TRUE) && GetLastError() != ERROR_HANDLE_EOF) ok = false;
+        head = (head + 1) % kDepth;
+        --inFlight;
+        // ファイル末尾のセクタは短く読める。エントリの範囲まで届いていれば良い
+        uint64_t need = std::min<uint64_t>(begin + r.pos + r.len, offset + size);
+        if (begin + r.pos + got < need) ok = false;
+    }
+    // 失敗時も発行済みの要求は完了を待ってからバッファを解放する
+    while (inFlight > 0) {
+        Request& r = reqs[head];
+        DWORD got = 0;
+        CancelIoEx(m_direct_, &r.ov);
+        GetOverlappedResult(m_direct_, &r.ov, &got, TRUE);
+        head = (head + 1) % kDepth;
+        --inFlight;
+    }
+    for (HANDLE ev : events) {
+        if (ev) CloseHandle(ev);
+    }
+    if (!ok) {
+        OutputDebugStringA("[PakArchive] Unbuffered read failed, falling back to buffered read.\n");
+        return false;
+    }
+    outBlock = std::move(block);
+    outSkip = (size_t)(offset - begin);
+    return true;
+}
+
+bool PakArchive::ReadAt(uint64_t offset, void* dst, uint64_t size) const {
+    // OVERLAPPED でオフセットを指定するのでシーク不要 (複数スレッドから同時に呼べる)
+    uint8_t* out = static_cast<uint8_t*>(dst);
+    while (size > 0) {
+        DWORD chunk = (DWORD)std::min<uint64_t>(size, 64ull * 1024 * 1024);
+        OVERLAPPED ov{};
+        ov.Offset = (DWORD)(offset & 0xFFFFFFFFu);
+        ov.OffsetHigh = (DWORD)(offset >> 32);
+        DWORD read = 0;
+        if (!ReadFile(m_file_, out, chunk, &read, &ov) || read != chunk) return false;
+        out += chunk;
+        offset += chunk;
+        size -= chunk;
+    }
+    return true;
+}
@@ -0,0 +1,136 @@
+// PakArchive
+// PIXPAK アーカイブ (.PixAssets) の読み込みを行うクラス
+// ファイルハンドルは Open 時に一度だけ開き、以降は offset/size 指定で読み出す
+
+#ifndef PAKARCHIVE_H
+#define PAKARCHIVE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <atomic>
+#include <memory>
+#include <functional>
+#include <cstdint>
+#include <Windows.h>
+#include "ArchiveFormat.h"
+
+class PakArchive
+{
+public:
+    // TOC エントリ。v3 はマップした TOC をそのまま参照し、v1 / v2 は Open 時に同じ形へ変換する
+    using Entry = PakTocEntryV3;
+
+    PakArchive() = default;
+    ~PakArchive();
+    PakArchive(const PakArchive&) = delete;
+    PakArchive& operator=(const PakArchive&) = delete;
+
+    bool Open(const std::string& archivePath);
+    void Close();
+    bool IsOpen() const { return m_file_ != INVALID_HANDLE_VALUE; }
+
+    // pathHash で二分探索する (文字列の確保は行わない)
+    const Entry* Find(std::string_view logicalName) const;
+    // 圧縮エントリは展開後のデータを返す
+    bool Read(const Entry& entry, std::vector<uint8_t>& outData) const;
+
+    // マップ済みページ上のエントリ先頭を返す (未マップ / 圧縮エントリは nullptr)
+    const uint8_t* GetMappedData(const Entry& entry) const;
+    bool IsMapped() const { return m_base_ != nullptr; }
+
+    // ページキャッシュを通さない読み込み。header.alignment が kDirectSector の倍数のアーカイブでは
+    // FILE_FLAG_NO_BUFFERING のハンドルも開き、kDirectReadMin 以上のエントリをセクタ単位の
+    // overlapped 読み込みでページ境界のバッファへ直接読む (大きいストリーミングデータ向け)
+    static constexpr uint64_t kDirectSector = 4096;
+    static constexpr uint64_t kDirectReadMin = 1024 * 1024;
+    bool CanReadDirect(const Entry& entry) const;
+    // 無圧縮エントリ用。outOwner は VirtualAlloc した領域、outData はその中のエントリ先頭
+    bool ReadDirect(const Entry& entry, std::shared_ptr<const void>& outOwner, const uint8_t*& outData) const;
+    bool HasDirectHandle() const { return m_direct_ != INVALID_HANDLE_VALUE; }
+    // false にすると直接読み込みを使わず通常のハンドルだけで読む (計測用)。他のスレッドから読む前に呼ぶこと
+    void SetDirectReads(bool enable) { m_directEnabled_ = enable; }
+
+    // 先読み用。[offset, offset + size) の格納データをまとめて取得する。マップ済みならビュー上を指し、
+    // 範囲のページ読み込みを OS へ一括で要求する。未マップなら 1 回の読み込みで scratch へ読む
+    // (scratch は呼び出し側で使い回す。毎回確保すると範囲全体のページフォルトが読み込みより重い)
+    bool ReadRange(uint64_t offset, uint64_t size, std::vector<uint8_t>& scratch, const uint8_t*& outData) const;
+    // ReadRange で得た格納データ (stored はエントリ先頭) を展開 / 検証して outData へ入れる
+    bool Decode(const Entry& entry, const uint8_t* stored, std::vector<uint8_t>& outData) const;
+
+    // 展開後のデータを 1MB 以下のブロックに分けて sink へ渡す。マップは使わずファイルから読む。
+    // sink が false を返すと中断して false を返す
+    bool Stream(const Entry& entry, const std::function<bool(const uint8_t*, size_t)>& sink) const;
+
+    // 整合性検証。有効にすると各エントリの初回の Read / GetMappedData で CRC32 を確かめ、
+    // 不一致のエントリは以後読み込みに失敗する。エントリ毎の検証状態は初めて有効にした時に確保するので、
+    // Open の後、他のスレッドから読み込む前に呼ぶこと
+    enum class VerifyState : uint8_t { Unchecked, Ok, Corrupt };
+    void SetVerify(bool enable);
+    VerifyState GetVerifyState(const Entry& entry) const;
+    void MarkVerified(const Entry& entry, bool ok) const;
+
+    // パッカーの重複排除で同じ格納データ (offset / storedSize が同じ) を指すエントリは検証状態を共有する。
+    // true なら先に並ぶ別のエントリと同じデータを指している (走査はそちらで済む)。
+    // 対応表は SetVerify(true) の時に作るので、それまでは false / 0 を返す
+    bool IsSharedPayload(const Entry& entry) const;
+    size_t GetSharedPayloadCount() const { return m_sharedCount_; }
+
+    const PakHeader& GetHeader() const { return m_header_; }
+    std::span<const Entry> GetEntries() const { return { m_table_, m_count_ }; }
+    std::string_view GetEntryPath(const Entry& entry) const;
+    const std::string& GetPath() const { return m_path_; }
+
+    // パッカーと同じ規則 (小文字化 / '\\' → '/', 先頭の "./" "/" を除く) でハッシュを作る
+    static uint64_t HashKey(std::string_view logicalName);
+    // 同じ規則で比較する (path はアーカイブ内の正規化済みパス)
+    static bool KeyEquals(std::string_view logicalName, std::string_view path);
+
+private:
+    bool ReadAt(uint64_t offset, void* dst, uint64_t size) const;
+    bool ReadDirectRange(uint64_t offset, uint64_t size, std::shared_ptr<uint8_t>& outBlock, size_t& outSkip) const;
+    bool ReadLZ4(const Entry& entry, std::vector<uint8_t>& outData) const;
+    bool ReadDict(const Entry& entry, std::vector<uint8_t>& outData) const;
+    bool DecodeDict(const Entry& entry, const uint8_t* stored, uint8_t* dst) const;
+    bool LoadDictionary();
+    bool VerifyFirstRead(const Entry& entry, const uint8_t* data, size_t size) const;
+    bool LoadTOCv3();
+    bool ParseLegacyTOC(const std::vector<uint8_t>& toc);
+    void MapView();
+    void BuildPayloadOwners();
+    size_t VerifyIndex(const Entry& entry) const;
+
+private:
+    HANDLE m_file_ = INVALID_HANDLE_VALUE;
+    HANDLE m_direct_ = INVALID_HANDLE_VALUE; // FILE_FLAG_NO_BUFFERING | FILE_FLAG_OVERLAPPED
+    bool m_directEnabled_ = true;
+    uint64_t m_fileSize_ = 0;
+    HANDLE m_mapping_ = nullptr;
+    const uint8_t* m_base_ = nullptr; // アーカイブ全体の読み取り専用ビュー
+    PakHeader m_header_{};
+    std::string m_path_;
+
+    // 検索対象の TOC (pathHash 昇順)。v3 + マップ済みならマップ上を直接指す
+    const Entry* m_table_ = nullptr;
+    size_t m_count_ = 0;
+    const char* m_pool_ = nullptr;
+    uint64_t m_poolSize_ = 0;
+
+    // 未マップ時の v3 TOC / v1・v2 から変換した TOC の実体
+    std::vector<uint8_t> m_tocBuf_;
+    std::vector<Entry> m_legacyEntries_;
+    std::vector<char> m_legacyPool_;
+
+    // LZ4Dict の共有辞書 (AssetFlag_Dictionary のアーカイブのみ。マウント時に 1 回読む)
+    std::vector<uint8_t> m_dict_;
+
+    // エントリ毎の VerifyState (m_table_ と同じ並び, SetVerify(true) までは空)
+    std::atomic<bool> m_verify_{ false };
+    std::unique_ptr<std::atomic<uint8_t>[]> m_verifyState_;
+    // 格納データを共有するエントリ → 検証状態を持つエントリの添字 (共有が無い / 検証しないなら空)
+    std::vector<uint32_t> m_payloadOwner_;
+    size_t m_sharedCount_ = 0;
+};
+
+#endif // PAKARCHIVE_H
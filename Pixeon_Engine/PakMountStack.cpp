@@ -0,0 +1,48 @@
+#include "PakMountStack.h"
+#include "ErrorLog.h"
+
+bool PakMountStack::Build(std::vector<std::shared_ptr<PakArchive>> mounts) {
+    m_mounts_.clear();
+    if (mounts.empty()) return false;
+
+    const PakArchive& base = *mounts.front();
+    if (HasFlag((uint16_t)base.GetHeader().flags, AssetFlag_PatchData)) {
+        ErrorLogger::Instance().LogError("PakMountStack", "Patch archive mounted without base: " + base.GetPath());
+        return false;
+    }
+    for (size_t mi = 1; mi < mounts.size(); ++mi) {
+        const PakArchive& archive = *mounts[mi];
+        if (!HasFlag((uint16_t)archive.GetHeader().flags, AssetFlag_PatchData)) {
+            OutputDebugStringA(("[PakMountStack] Warning: not a patch archive: " + archive.GetPath() + "\n").c_str());
+        }
+    }
+    m_mounts_ = std::move(mounts);
+    return true;
+}
+
+const PakArchive::Entry* PakMountStack::Find(std::string_view logicalName,
+    std::shared_ptr<PakArchive>* outArchive) const {
+    // 通常はベースのみなので 1 回の二分探索で済む。パッチは新しいものから探す
+    for (size_t mi = m_mounts_.size(); mi-- > 0;) {
+        const PakArchive::Entry* entry = m_mounts_[mi]->Find(logicalName);
+        if (!entry) continue;
+        if (outArchive) *outArchive = m_mounts_[mi];
+        return entry;
+    }
+    return nullptr;
+}
+
+std::vector<std::string> PakMountStack::GetEntryNames() const {
+    std::vector<std::string> names;
+    for (size_t mi = 0; mi < m_mounts_.size(); ++mi) {
+        const PakArchive& archive = *m_mounts_[mi];
+        for (const auto& entry : archive.GetEntries()) {
+            std::string_view path = archive.GetEntryPath(entry);
+            bool hidden = false;
+            for (size_t newer = mi + 1; newer < m_mounts_.size() && !hidden; ++newer)
+                hidden = m_mounts_[newer]->Find(path) != nullptr;
+            if (!hidden) names.emplace_back(path);
+        }
+    }
+    return names;
+}
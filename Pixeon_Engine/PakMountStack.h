@@ -0,0 +1,32 @@
+// PakMountStack
+// ベースアーカイブ + パッチアーカイブ (AssetFlag_PatchData) を重ねてマウントした状態を表す。
+// 後からマウントしたものほど優先される。索引は作らず、検索は新しいマウントから順に
+// 各アーカイブの TOC (pathHash 昇順) を二分探索する。構築後は変更しない (差し替えは作り直す)
+
+#ifndef PAKMOUNTSTACK_H
+#define PAKMOUNTSTACK_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "PakArchive.h"
+
+class PakMountStack
+{
+public:
+    // mounts[0] がベース、以降がパッチ (後ろほど優先)
+    bool Build(std::vector<std::shared_ptr<PakArchive>> mounts);
+
+    // 最も新しいマウントのエントリを返す。outArchive にはエントリを持つアーカイブを入れる
+    const PakArchive::Entry* Find(std::string_view logicalName,
+        std::shared_ptr<PakArchive>* outArchive = nullptr) const;
+
+    const std::vector<std::shared_ptr<PakArchive>>& GetMounts() const { return m_mounts_; }
+    // 全マウントを重ねた後のエントリ名 (新しいマウントに隠されたものは含まない)。一覧表示用
+    std::vector<std::string> GetEntryNames() const;
+
+private:
+    std::vector<std::shared_ptr<PakArchive>> m_mounts_;
+};
+
+#endif // PAKMOUNTSTACK_H
@@ -0,0 +1,141 @@
+#include "PakScrubber.h"
+#include "ErrorLog.h"
+#include "HashUtill.h"
+#include <cstring>
+
+PakScrubber::~PakScrubber() {
+    Stop();
+}
+
+void PakScrubber::Start(std::shared_ptr<const PakMountStack> mounts, uint64_t bytesPerSec, std::function<bool()> busy) {
+    Stop();
+    if (!mounts) return;
+    m_bytesPerSec_.store(bytesPerSec);
+    m_busy_ = std::move(busy);
+    {
+        std::lock_guard<std::mutex> lk(m_mtx_);
+        m_stop_ = false;
+    }
+    m_checked_ = 0;
+    m_corrupt_ = 0;
+    m_bytes_ = 0;
+    m_total_ = 0;
+    for (auto& archive : mounts->GetMounts()) m_total_ += archive->GetEntries().size();
+    m_running_ = true;
+    m_thread_ = std::thread(&PakScrubber::Run, this, std::move(mounts));
+}
+
+void PakScrubber::Stop() {
+    {
+        std::lock_guard<std::mutex> lk(m_mtx_);
+        m_stop_ = true;
+    }
+    m_cv_.notify_all();
+    if (m_thread_.joinable()) m_thread_.join();
+    m_running_ = false;
+}
+
+PakScrubber::Stats PakScrubber::GetStats() const {
+    Stats s;
+    s.checked = m_checked_.load();
+    s.total = m_total_.load();
+    s.corrupt = m_corrupt_.load();
+    s.bytes = m_bytes_.load();
+    s.running = m_running_.load();
+    return s;
+}
+
+void PakScrubber::Run(std::shared_ptr<const PakMountStack> mounts) {
+    // CPU と I/O の優先度をまとめて下げる (フォアグラウンドの ReadFile / ページフォルトより後回しになる)
+    SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+
+    m_due_ = std::chrono::steady_clock::now();
+    bool aborted = false;
+    for (auto& archive : mounts->GetMounts()) {
+        for (auto& entry : archive->GetEntries()) {
+            if (!CheckEntry(*archive, entry)) {
+                aborted = true;
+                break;
+            }
+            ++m_checked_;
+        }
+        if (aborted) break;
+    }
+    if (!aborted) {
+        char dbg[128];
+        sprintf_s(dbg, "[PakScrubber] Finished: %zu entries, %zu corrupt\n", m_checked_.load(), m_corrupt_.load());
+        OutputDebugStringA(dbg);
+    }
+    SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_END);
+    m_running_ = false;
+}
+
+// 戻り値 false は中断要求 (照合結果ではない)
+bool PakScrubber::CheckEntry(const PakArchive& archive, const PakArchive::Entry& entry) {
+    if (archive.GetVerifyState(entry) == PakArchive::VerifyState::Corrupt) return true;
+    // 重複排除で共有された格納データは持ち主のエントリで照合する
+    if (archive.IsSharedPayload(entry)) return true;
+    if (!WaitIdle()) return false;
+
+    // 標準 SHA-256 になる前のアーカイブは sha256 を比べられないので CRC32 で照合する
+    const bool useSha = HasFlag((uint16_t)archive.GetHeader().flags, AssetFlag_StdSHA256);
+    HashUtil::SHA256Ctx sha;
+    HashUtil::SHA256Init(sha);
+    uint32_t crc = 0;
+    bool stopped = false;
+    bool readOk = archive.Stream(entry, [&](const uint8_t* data, size_t size) {
+        if (useSha) HashUtil::SHA256Update(sha, data, size);
+        else crc = HashUtil::CalcCRC32(data, size, crc ^ 0xFFFFFFFFu);
+        m_bytes_ += size;
+        if (!Throttle(size)) {
+            stopped = true;
+            return false;
+        }
+        return true;
+    });
+    if (stopped) return false;
+
+    bool ok = readOk;
+    if (ok && useSha) {
+        uint8_t digest[32];
+        HashUtil::SHA256Final(sha, digest);
+        ok = memcmp(digest, entry.sha256, 32) == 0;
+    }
+    else if (ok) {
+        ok = crc == entry.crc32;
+    }
+    archive.MarkVerified(entry, ok);
+    if (!ok) {
+        ++m_corrupt_;
+        ErrorLogger::Instance().LogError("PakScrubber", std::string(useSha ? "SHA-256" : "CRC32") +
+            " mismatch: " + std::string(archive.GetEntryPath(entry)) + " (" + archive.GetPath() + ")");
+    }
+    return true;
+}
+
+// フォアグラウンドが読み込み中なら空くまで待つ
+bool PakScrubber::WaitIdle() {
+    using namespace std::chrono;
+    while (m_busy_ && m_busy_()) {
+        if (!SleepUntil(steady_clock::now() + milliseconds(100))) return false;
+    }
+    return true;
+}
+
+// 読んだ量だけ予定時刻を進め、追いつくまで眠る
+bool PakScrubber::Throttle(size_t bytes) {
+    using namespace std::chrono;
+    if (!WaitIdle()) return false;
+    uint64_t rate = m_bytesPerSec_.load();
+    if (rate == 0) return SleepUntil(steady_clock::now()); // 無制限
+    // 遅れていた分は取り戻さない (まとめ読みでフォアグラウンドと競合しないように)
+    auto now = steady_clock::now();
+    if (m_due_ < now) m_due_ = now;
+    m_due_ += nanoseconds((int64_t)((double)bytes * 1e9 / (double)rate));
+    return SleepUntil(m_due_);
+}
+
+bool PakScrubber::SleepUntil(std::chrono::steady_clock::time_point until) {
+    std::unique_lock<std::mutex> lk(m_mtx_);
+    return !m_cv_.wait_until(lk, until, [this] { return m_stop_; });
+}
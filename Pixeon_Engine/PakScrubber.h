@@ -0,0 +1,66 @@
+// PakScrubber
+// マウント中のアーカイブを低優先度のスレッドで 1 周し、各エントリを TOC の SHA-256 と照合する。
+// 読み込み帯域を制限し、フォアグラウンドの読み込み中 (busy が true の間) は休む。
+// 不一致は ErrorLogger へ報告し、そのエントリを Corrupt にして以後の読み込みを失敗させる
+
+#ifndef PAKSCRUBBER_H
+#define PAKSCRUBBER_H
+
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <chrono>
+#include "PakMountStack.h"
+
+class PakScrubber
+{
+public:
+    struct Stats {
+        size_t   checked = 0;   // 照合を終えたエントリ数
+        size_t   total = 0;
+        size_t   corrupt = 0;
+        uint64_t bytes = 0;     // 照合した展開後のバイト数
+        bool     running = false;
+    };
+
+    PakScrubber() = default;
+    ~PakScrubber();
+    PakScrubber(const PakScrubber&) = delete;
+    PakScrubber& operator=(const PakScrubber&) = delete;
+
+    // 実行中なら止めてから mounts の走査を始める
+    void Start(std::shared_ptr<const PakMountStack> mounts, uint64_t bytesPerSec, std::function<bool()> busy);
+    void Stop();
+    void SetBandwidth(uint64_t bytesPerSec) { m_bytesPerSec_.store(bytesPerSec); }
+    uint64_t GetBandwidth() const { return m_bytesPerSec_.load(); }
+    Stats GetStats() const;
+
+private:
+    void Run(std::shared_ptr<const PakMountStack> mounts);
+    bool CheckEntry(const PakArchive& archive, const PakArchive::Entry& entry);
+    bool WaitIdle();
+    bool Throttle(size_t bytes);
+    bool SleepUntil(std::chrono::steady_clock::time_point until);
+
+private:
+    std::thread m_thread_;
+    std::function<bool()> m_busy_;
+
+    std::mutex m_mtx_;
+    std::condition_variable m_cv_;
+    bool m_stop_ = false;
+
+    std::atomic<uint64_t> m_bytesPerSec_{ 8ull * 1024 * 1024 };
+    std::chrono::steady_clock::time_point m_due_; // 帯域制限上、次の読み込みを始めてよい時刻
+
+    std::atomic<size_t> m_checked_{ 0 };
+    std::atomic<size_t> m_total_{ 0 };
+    std::atomic<size_t> m_corrupt_{ 0 };
+    std::atomic<uint64_t> m_bytes_{ 0 };
+    std::atomic<bool> m_running_{ false };
+};
+
+#endif // PAKSCRUBBER_H
@@ -290,6 +290,32 @@ void Scene::LoadToFile(){
 	}
 }
 
+// QƃAZbg̗ (R|[lg͍Ȃ)
+std::vector<std::string> Scene::CollectAssetReferences(){
+	std::vector<std::string> refs;
+	std::string filePath = SettingManager::GetInstance()->GetSceneFilePath() + "/" + _name + ".scene";
+	std::ifstream inFile(filePath);
+	if (!inFile.is_open()) return refs;
+
+	nlohmann::json sceneData = nlohmann::json::parse(inFile, nullptr, false);
+	if (sceneData.is_discarded() || !sceneData.contains("Objects")) return refs;
+
+	for (const auto& objData : sceneData["Objects"]) {
+		if (!objData.contains("Components")) continue;
+		for (const auto& compData : objData["Components"]) {
+			auto type = static_cast<ComponentManager::COMPONENT_TYPE>(compData["Type"].get<int>());
+			if (type != ComponentManager::COMPONENT_TYPE::MODEL) continue;
+			// ModelRenderComponent::SaveToFile  1 sڂf̃pX
+			std::istringstream iss(compData["Data"].get<std::string>());
+			std::string path;
+			std::getline(iss, path);
+			if (!path.empty() && path.back() == '\r') path.pop_back();
+			if (!path.empty()) refs.push_back(path);
+		}
+	}
+	return refs;
+}
+
 void Scene::RegisterLight(LightComponent* l){
 	if (!l) return;
 	if (std::find(_lights.begin(), _lights.end(), l) == _lights.end())
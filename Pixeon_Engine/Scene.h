@@ -26,6 +26,8 @@ public: // 
 public: // Z[uƃ[h
 	void SaveToFile();
 	void LoadToFile();
+	// .scene t@CQƂAZbg (f) 񋓂BLoadToFile O̐ǂݗp
+	std::vector<std::string> CollectAssetReferences();
 	void AddObjectLocal(Object* obj);
 	void RemoveObject(Object* obj);
 public: // Setter And Getter
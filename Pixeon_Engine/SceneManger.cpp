@@ -1,6 +1,9 @@
 #include "SceneManger.h"
 #include "Scene.h"
 #include "SettingManager.h"
+#include "AssetManager.h"
+#include "ModelManager.h"
+#include <chrono>
 
 SceneManger* SceneManger::instance = nullptr;
 
@@ -48,13 +51,7 @@ void SceneManger::BeginPlay(){
 // XV
 void SceneManger::EditUpdate(){
 	//// V[̐؂ւ
-	if (_nextScene) {
-		if (_currentScene)delete _currentScene;
-		_currentScene = _nextScene;
-		_currentScene->Init();
-		_currentScene->LoadToFile();
-		_nextScene = nullptr;
-	}
+	if (_nextScene) SwapToNextScene();
 	//// XV
 	if (_currentScene)_currentScene->EditUpdate();
 
@@ -70,11 +67,7 @@ void SceneManger::EditUpdate(){
 // XV
 void SceneManger::PlayUpdate(){
 	if (_nextScene) {
-		if (_currentScene)delete _currentScene;
-		_currentScene = _nextScene;
-		_nextScene = nullptr;
-		_currentScene->Init();
-		_currentScene->LoadToFile();
+		SwapToNextScene();
 		_currentScene->BeginPlay();
 	}
 	if (_currentScene)_currentScene->PlayUpdate();
@@ -85,6 +78,53 @@ void SceneManger::Draw(){
 	if (_currentScene)_currentScene->Draw();
 }
 
+// ̃V[ւ̐؂ւ
+// ǂ݂LȂAR|[lgOɎQƃAZbg܂Ƃ߂ēǂݍł
+void SceneManger::SwapToNextScene(){
+	auto t0 = std::chrono::steady_clock::now();
+	if (_currentScene)delete _currentScene;
+	_currentScene = _nextScene;
+	_nextScene = nullptr;
+
+	auto* assets = AssetManager::Instance();
+	assets->MarkLoadTraceScene(_currentScene->GetName());
+
+	AssetManager::PrefetchResult pre;
+	std::vector<std::shared_ptr<ModelSharedResource>> models; // LoadToFile ܂ŉȂ
+	if (SettingManager::GetInstance()->GetScenePrefetch()) {
+		std::vector<std::string> refs = _currentScene->CollectAssetReferences();
+		pre = assets->PrefetchAssets(refs);
+		// eNX`̓fǂނ܂ŕȂ̂ŁAfɍ 2 ڂ̐ǂ݂
+		std::vector<std::string> textures;
+		for (const auto& path : refs) {
+			auto model = ModelManager::Instance()->LoadOrGet(path);
+			if (!model) continue;
+			for (const auto& mat : model->materials) {
+				if (!mat.baseColorTex.empty()) textures.push_back(mat.baseColorTex);
+			}
+			models.push_back(std::move(model));
+		}
+		AssetManager::PrefetchResult tex = assets->PrefetchAssets(textures);
+		pre.assets += tex.assets;
+		pre.reads += tex.reads;
+		pre.bytes += tex.bytes;
+	}
+	auto t1 = std::chrono::steady_clock::now();
+
+	_currentScene->Init();
+	_currentScene->LoadToFile();
+	assets->ClearPrefetched();
+	models.clear();
+	auto t2 = std::chrono::steady_clock::now();
+
+	auto ms = [](auto a, auto b) { return std::chrono::duration<double, std::milli>(b - a).count(); };
+	char dbg[256];
+	sprintf_s(dbg, "[SceneManger] Switch to %s: prefetch %.1f ms (%zu assets, %zu reads, %.2f MB), load %.1f ms, total %.1f ms\n",
+		_currentScene->GetName().c_str(), ms(t0, t1), pre.assets, pre.reads, pre.bytes / (1024.0 * 1024.0),
+		ms(t1, t2), ms(t0, t2));
+	OutputDebugStringA(dbg);
+}
+
 // V[̕ύX
 void SceneManger::ChangeScene(std::string SceneName){
 	auto it = _SceneCreators.find(SceneName);
@@ -38,6 +38,7 @@ public:
 
 private:
 	bool CreateAndRegisterScene(std::string SceneName);
+	void SwapToNextScene();
 	void RegisterScene(std::string Name, std::function<Scene* ()> creator);
 	std::vector<std::string> ListSceneFiles();
 
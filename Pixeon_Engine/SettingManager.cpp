@@ -47,6 +47,9 @@ void SettingManager::LoadConfig(){
 	if (configJson.contains("bZBuffer")) {
 		bZBuffer = configJson["bZBuffer"].get<bool>();
 	}
+	if (configJson.contains("bScenePrefetch")) {
+		bScenePrefetch = configJson["bScenePrefetch"].get<bool>();
+	}
 	if (configJson.contains("AutoSaveInterval")) {
 		AutoSaveInterval = configJson["AutoSaveInterval"].get<int>();
 	}
@@ -69,6 +72,7 @@ void SettingManager::SaveConfig(){
 	configJson["ArchiveFilePath"] = ArchiveFilePath;
 	configJson["SceneFilePath"] = SceneFilePath;
 	configJson["bZBuffer"] = bZBuffer;
+	configJson["bScenePrefetch"] = bScenePrefetch;
 	configJson["AutoSaveInterval"] = AutoSaveInterval;
 	configJson["BackgroundColor"] = { BackgroundColor.x, BackgroundColor.y, BackgroundColor.z, BackgroundColor.w };
 	configJson["ExternelTool"] = ExternelTool;
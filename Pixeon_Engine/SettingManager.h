@@ -30,6 +30,9 @@ public:
 	bool GetZBuffer() const { return bZBuffer; }
 	void SetZBuffer(bool bEnable) { bZBuffer = bEnable; }
 
+	bool GetScenePrefetch() const { return bScenePrefetch; }
+	void SetScenePrefetch(bool bEnable) { bScenePrefetch = bEnable; }
+
 	int GetAutoSaveInterval() const { return AutoSaveInterval; }
 	void SetAutoSaveInterval(int interval) { AutoSaveInterval = interval; }
 
@@ -62,6 +65,7 @@ private:
 	DirectX::XMFLOAT4 BackgroundColor = DirectX::XMFLOAT4(0.1f, 0.1f, 0.1f,1.0f);
 	
 	bool bZBuffer = true;
+	bool bScenePrefetch = true; // V[؂ւɎQƃAZbg܂Ƃ߂Đǂ݂
 	int AutoSaveInterval = 5; // ۑԊuij
 
 	SettingManager() {}
@@ -1,6 +1,7 @@
 #include <d3d11shader.h>
 #include "ShaderManager.h"
 #include "SettingManager.h"
+#include "ErrorLog.h"
 #include <fstream>
 #include <d3dcompiler.h>
 
@@ -262,7 +263,7 @@ bool ShaderManager::ReflectShader(ShaderStage stage, const std::string& shaderNa
     ShaderReflectionData refData;
 
     // cbufferBindPoint̑ΉE߂ɁA\[XoCfBO猟
-    std::unordered_map<std::string, UINT> bindPointByCBufferName;
+    HashUtil::StringMap<UINT> bindPointByCBufferName;
     for (UINT r = 0; r < sdesc.BoundResources; ++r) {
         D3D11_SHADER_INPUT_BIND_DESC bindDesc = {};
         refl->GetResourceBindingDesc(r, &bindDesc);
@@ -292,7 +293,20 @@ bool ShaderManager::ReflectShader(ShaderStage stage, const std::string& shaderNa
             vd.name = vdesc.Name ? vdesc.Name : "";
             vd.offset = vdesc.StartOffset;
             vd.size = vdesc.Size;
-            runtime.varsByName[vd.name] = vd;
+            //  cbuffer ̕ϐ͈ӂȂ̂ŁAID ɂ΃nbV̏Փ
+            auto [itVar, inserted] = runtime.varsById.try_emplace(ToNameId(vd.name), vd);
+            if (!inserted) {
+                ErrorLogger::Instance().LogError("ShaderManager", "NameId collision: " + itVar->second.name + " / " + vd.name + " (" + shaderName + ")");
+                for (auto& c : refData.cbuffers) if (c.gpuBuffer) c.gpuBuffer->Release();
+                refl->Release();
+                return false;
+            }
+        }
+        if (refData.cbufIndexById.count(ToNameId(runtime.name))) {
+            ErrorLogger::Instance().LogError("ShaderManager", "NameId collision: cbuffer " + runtime.name + " (" + shaderName + ")");
+            for (auto& c : refData.cbuffers) if (c.gpuBuffer) c.gpuBuffer->Release();
+            refl->Release();
+            return false;
         }
 
         // GPUobt@쐬
@@ -308,7 +322,7 @@ bool ShaderManager::ReflectShader(ShaderStage stage, const std::string& shaderNa
         runtime.cpuData.resize(runtime.size, 0);
         runtime.dirty = false;
 
-        refData.cbufIndexByName[runtime.name] = (UINT)refData.cbuffers.size();
+        refData.cbufIndexById[ToNameId(runtime.name)] = refData.cbuffers.size();
         refData.cbuffers.push_back(std::move(runtime));
     }
 
@@ -346,18 +360,23 @@ const ShaderManager::ShaderReflectionData* ShaderManager::GetReflection(ShaderSt
 bool ShaderManager::SetCBufferVariable(ShaderStage stage, const std::string& shaderName,
     const std::string& cbName, const std::string& varName,
     const void* data, UINT size)
+{
+    return SetCBufferVariable(stage, shaderName, ToNameId(cbName), ToNameId(varName), data, size);
+}
+
+bool ShaderManager::SetCBufferVariable(ShaderStage stage, const std::string& shaderName,
+    NameId cbId, NameId varId, const void* data, UINT size)
 {
     auto* ref = GetReflection(stage, shaderName);
     if (!ref) return false;
-    auto itCB = ref->cbufIndexByName.find(cbName);
-    if (itCB == ref->cbufIndexByName.end()) return false;
+    auto itCB = ref->cbufIndexById.find(cbId);
+    if (itCB == ref->cbufIndexById.end()) return false;
 
     // const_castōXVi{mutableǗ𕪂݌vYj
-    auto& refMap = (stage == ShaderStage::VS) ? m_vsRef : m_psRef;
-    auto& runtime = refMap[shaderName].cbuffers[itCB->second];
+    auto& runtime = const_cast<ShaderReflectionData*>(ref)->cbuffers[itCB->second];
 
-    auto itVar = runtime.varsByName.find(varName);
-    if (itVar == runtime.varsByName.end()) return false;
+    auto itVar = runtime.varsById.find(varId);
+    if (itVar == runtime.varsById.end()) return false;
 
     const auto& vd = itVar->second;
     const UINT copySize = (size < vd.size) ? size : vd.size;
@@ -370,14 +389,19 @@ bool ShaderManager::SetCBufferVariable(ShaderStage stage, const std::string& sha
 
 bool ShaderManager::SetCBufferRaw(ShaderStage stage, const std::string& shaderName,
     const std::string& cbName, const void* data, UINT size)
+{
+    return SetCBufferRaw(stage, shaderName, ToNameId(cbName), data, size);
+}
+
+bool ShaderManager::SetCBufferRaw(ShaderStage stage, const std::string& shaderName,
+    NameId cbId, const void* data, UINT size)
 {
     auto* ref = GetReflection(stage, shaderName);
     if (!ref) return false;
-    auto itCB = ref->cbufIndexByName.find(cbName);
-    if (itCB == ref->cbufIndexByName.end()) return false;
+    auto itCB = ref->cbufIndexById.find(cbId);
+    if (itCB == ref->cbufIndexById.end()) return false;
 
-    auto& refMap = (stage == ShaderStage::VS) ? m_vsRef : m_psRef;
-    auto& runtime = refMap[shaderName].cbuffers[itCB->second];
+    auto& runtime = const_cast<ShaderReflectionData*>(ref)->cbuffers[itCB->second];
 
     if (size != runtime.size) return false;
     memcpy(runtime.cpuData.data(), data, size);
@@ -5,6 +5,7 @@
 #include <filesystem>
 #include <Windows.h>
 #include <d3d11.h>
+#include "HashUtill.h"
 
 // memo
 // WriteBuffer𔽎ˋ@\Ŏ
@@ -40,6 +41,11 @@ public:
     bool GetVSBytecode(const std::string& name, const void** ppData, size_t* pSize) const;
 
     // ǉ: /CBǗ
+    // cbuffer  / ϐ ID (HashUtil::Hash64)BˎɖOA͂ ID ōsB
+    // t[މӏ HashUtil::Hash64Const  ID RpCɋ߂Ă
+    using NameId = uint64_t;
+    static NameId ToNameId(std::string_view name) { return HashUtil::Hash64(name); }
+
     struct VariableDesc {
         std::string name;
         UINT        offset = 0;
@@ -52,12 +58,12 @@ public:
         ID3D11Buffer* gpuBuffer = nullptr;
         std::vector<uint8_t>            cpuData;
         bool                            dirty = false;
-        std::unordered_map<std::string, VariableDesc> varsByName;
+        HashUtil::IdMap<VariableDesc>   varsById;
     };
     struct ShaderReflectionData {
         std::vector<CBufferRuntime> cbuffers; // ݂
-        // O -> index ̌x
-        std::unordered_map<std::string, size_t> cbufIndexByName;
+        // O ID -> index ̌x
+        HashUtil::IdMap<size_t> cbufIndexById;
     };
 
     // ˏ擾
@@ -69,12 +75,21 @@ public:
         const std::string& cbName,
         const std::string& varName,
         const void* data, UINT size);
+    bool SetCBufferVariable(ShaderStage stage,
+        const std::string& shaderName,
+        NameId cbId,
+        NameId varId,
+        const void* data, UINT size);
 
     // cbufferŜ݁iTCYvɗLj
     bool SetCBufferRaw(ShaderStage stage,
         const std::string& shaderName,
         const std::string& cbName,
         const void* data, UINT size);
+    bool SetCBufferRaw(ShaderStage stage,
+        const std::string& shaderName,
+        NameId cbId,
+        const void* data, UINT size);
 
     // ύX̓cbufferׂUpdateSubresourceAK؂BindPointɃoCh
     bool CommitAndBind(ShaderStage stage, const std::string& shaderName);
@@ -91,21 +106,21 @@ private:
 
     ID3D11Device* m_device = nullptr;
 
-    std::unordered_map<std::string, ID3D11VertexShader*> m_vsShaders;
-    std::unordered_map<std::string, ID3D11PixelShader*>  m_psShaders;
+    HashUtil::StringMap<ID3D11VertexShader*> m_vsShaders;
+    HashUtil::StringMap<ID3D11PixelShader*>  m_psShaders;
 
     // 萔obt@i]̌ŒL[Łj
-    std::unordered_map<std::string, std::vector<ID3D11Buffer*>> m_constantBuffers;
+    HashUtil::StringMap<std::vector<ID3D11Buffer*>> m_constantBuffers;
 
     // VS/PSoCgR[hێi̓CAEgE˂Ɏgpj
-    std::unordered_map<std::string, std::vector<char>> m_vsBytecodes;
-    std::unordered_map<std::string, std::vector<char>> m_psBytecodes;
+    HashUtil::StringMap<std::vector<char>> m_vsBytecodes;
+    HashUtil::StringMap<std::vector<char>> m_psBytecodes;
 
     // ˃f[^
-    std::unordered_map<std::string, ShaderReflectionData> m_vsRef;
-    std::unordered_map<std::string, ShaderReflectionData> m_psRef;
+    HashUtil::StringMap<ShaderReflectionData> m_vsRef;
+    HashUtil::StringMap<ShaderReflectionData> m_psRef;
 
-    std::unordered_map<std::string, FILETIME> m_hlslUpdateTimes;
+    HashUtil::StringMap<FILETIME> m_hlslUpdateTimes;
 
     static ShaderManager* instance;
 };
\ No newline at end of file
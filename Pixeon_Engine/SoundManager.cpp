@@ -50,8 +50,8 @@ std::shared_ptr<SoundResource> SoundManager::LoadOrGet(const std::string& logica
 }
 
 std::shared_ptr<SoundResource> SoundManager::LoadInternal(const std::string& logicalName, bool streaming) {
-    std::vector<uint8_t> data;
-    if (!AssetManager::Instance()->LoadAsset(logicalName, data) || data.empty()) {
+    AssetView data = AssetManager::Instance()->AcquireAsset(logicalName);
+    if (!data || data.empty()) {
         OutputDebugStringA(("[SoundManager] Raw load failed: " + logicalName + "\n").c_str());
         return nullptr;
     }
@@ -59,7 +59,7 @@ std::shared_ptr<SoundResource> SoundManager::LoadInternal(const std::string& log
     snd->name = logicalName;
     if (!streaming) {
         // Ȉ: ̂܂܊i[iۂ WAV p[Xăwb_j
-        snd->pcmData = data;
+        snd->pcmData.assign(data.data(), data.data() + data.size());
     }
     else {
         // Xg[~O: wb_͂s PCM ͓sxǂސ݌v֊g
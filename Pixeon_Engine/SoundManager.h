@@ -4,6 +4,7 @@
 #define SOUND_MANAGER_H
 
 #include "AssetTypes.h"
+#include "HashUtill.h"
 #include <unordered_map>
 #include <memory>
 #include <mutex>
@@ -21,7 +22,7 @@ private:
     std::shared_ptr<SoundResource> LoadInternal(const std::string& logicalName, bool streaming);
 
     struct Entry { std::weak_ptr<SoundResource> weak; uint64_t lastUse = 0; size_t bytes = 0; bool streaming = false; };
-    std::unordered_map<std::string, Entry> m_cache;
+    HashUtil::StringMap<Entry> m_cache;
     uint64_t m_frame = 0;
     std::mutex m_mtx;
 
@@ -118,8 +118,8 @@ bool TextureManager::IsPinned(const std::string& name) {
 
 std::shared_ptr<TextureResource> TextureManager::LoadInternal(const std::string& logicalName) {
     // (1) Raw �ǂݍ���
-    std::vector<uint8_t> data;
-    if (!AssetManager::Instance()->LoadAsset(logicalName, data) || data.empty()) {
+    AssetView data = AssetManager::Instance()->AcquireAsset(logicalName);
+    if (!data || data.empty()) {
         SetFail(logicalName, "RawLoadFailed(size=0 or not found)");
         return nullptr;
     }
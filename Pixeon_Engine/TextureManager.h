@@ -2,6 +2,7 @@
 #define TEXTURE_MANAGER_H
 
 #include "AssetTypes.h"
+#include "HashUtill.h"
 #include <unordered_map>
 #include <memory>
 #include <mutex>
@@ -43,11 +44,11 @@ private:
         uint64_t lastUse = 0;
         size_t   bytes = 0;
     };
-    std::unordered_map<std::string, Entry> m_cache;
-    std::unordered_map<std::string, std::shared_ptr<TextureResource>> m_pinned;
+    HashUtil::StringMap<Entry> m_cache;
+    HashUtil::StringMap<std::shared_ptr<TextureResource>> m_pinned;
 
     // ǉ: O -> sR
-    std::unordered_map<std::string, std::string> m_failReasons;
+    HashUtil::StringMap<std::string> m_failReasons;
 
     size_t    m_budget = 512ull * 1024 * 1024;
     uint64_t  m_frame = 0;
@@ -0,0 +1,578 @@
+#include "VertexPack.h"
+#include <DirectXPackedVector.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+namespace {
+
+    constexpr double kPi = 3.14159265358979323846;
+
+    float Sign(float v) { return v >= 0.0f ? 1.0f : -1.0f; }
+
+    // D3D の snorm → float 変換と同じ (-kMax は -1 に揃える)
+    template <int kMax, class T>
+    void DecodeOct(const T in[2], float n[3]) {
+        float x = std::max((float)in[0] / kMax, -1.0f);
+        float y = std::max((float)in[1] / kMax, -1.0f);
+        float z = 1.0f - std::fabs(x) - std::fabs(y);
+        // 下半球は折り返す (VS_ModelPacked.hlsl の OctDecode と同じ式)
+        float t = std::max(-z, 0.0f);
+        x += x >= 0.0f ? -t : t;
+        y += y >= 0.0f ? -t : t;
+        float len = std::sqrt(x * x + y * y + z * z);
+        n[0] = x / len;
+        n[1] = y / len;
+        n[2] = z / len;
+    }
+
+    template <int kMax, class T>
+    void EncodeOct(const float n[3], T out[2]) {
+        float l1 = std::fabs(n[0]) + std::fabs(n[1]) + std::fabs(n[2]);
+        if (!(l1 > 0.0f) || !std::isfinite(l1)) {
+            out[0] = out[1] = 0;
+            return;
+        }
+        float x = n[0] / l1, y = n[1] / l1;
+        if (n[2] < 0.0f) {
+            float ox = x;
+            x = (1.0f - std::fabs(y)) * Sign(ox);
+            y = (1.0f - std::fabs(ox)) * Sign(y);
+        }
+        // 切り捨て / 切り上げの 4 通りから、戻した向きが元に最も近いものを選ぶ
+        const float inv = 1.0f / std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        const float fx = std::floor(x * kMax), fy = std::floor(y * kMax);
+        float bestDot = -2.0f;
+        for (int dy = 0; dy < 2; ++dy) {
+            for (int dx = 0; dx < 2; ++dx) {
+                T q[2] = { (T)std::clamp(fx + dx, (float)-kMax, (float)kMax), (T)std::clamp(fy + dy, (float)-kMax, (float)kMax) };
+                float d[3];
+                DecodeOct<kMax>(q, d);
+                float dot = (d[0] * n[0] + d[1] * n[1] + d[2] * n[2]) * inv;
+                if (dot > bestDot) {
+                    bestDot = dot;
+                    out[0] = q[0];
+                    out[1] = q[1];
+                }
+            }
+        }
+    }
+
+    uint16_t ToUnorm16(double v) {
+        return (uint16_t)std::clamp(std::lround(v * 65535.0), 0l, 65535l);
+    }
+
+    double AngleDeg(const float a[3], const float b[3]) {
+        double cx = (double)a[1] * b[2] - (double)a[2] * b[1];
+        double cy = (double)a[2] * b[0] - (double)a[0] * b[2];
+        double cz = (double)a[0] * b[1] - (double)a[1] * b[0];
+        double dot = (double)a[0] * b[0] + (double)a[1] * b[1] + (double)a[2] * b[2];
+        return std::atan2(std::sqrt(cx * cx + cy * cy + cz * cz), dot) * 180.0 / kPi;
+    }
+
+    bool Normalize(const float in[3], float out[3]) {
+        double len = std::sqrt((double)in[0] * in[0] + (double)in[1] * in[1] + (double)in[2] * in[2]);
+        if (!(len > 1e-6) || !std::isfinite(len)) return false;
+        for (int i = 0; i < 3; ++i) out[i] = (float)(in[i] / len);
+        return true;
+    }
+
+    // ウェイトを合計で割ってから 1/255 単位に丸める (最大剰余方式で合計を 255 に揃える)
+    void QuantizeWeights(const float w[4], uint8_t out[4]) {
+        double sum = 0.0;
+        for (int i = 0; i < 4; ++i) sum += std::max(w[i], 0.0f);
+        if (!(sum > 0.0)) {
+            memset(out, 0, 4);
+            return;
+        }
+        double frac[4];
+        int total = 0;
+        for (int i = 0; i < 4; ++i) {
+            double v = std::max(w[i], 0.0f) / sum * 255.0;
+            out[i] = (uint8_t)std::floor(v);
+            frac[i] = v - out[i];
+            total += out[i];
+        }
+        for (; total < 255; ++total) {
+            int best = 0;
+            for (int i = 1; i < 4; ++i) if (frac[i] > frac[best]) best = i;
+            out[best]++;
+            frac[best] = -1.0;
+        }
+    }
+
+    // サブメッシュの頂点範囲が重ならず、インデックスがその中に収まっているか
+    bool RangesUsable(const std::vector<uint32_t>& indices, const std::vector<SubMesh>& submeshes, uint32_t vertexCount) {
+        if (submeshes.empty()) return false;
+        std::vector<std::pair<uint32_t, uint32_t>> ranges;
+        ranges.reserve(submeshes.size());
+        for (const SubMesh& sm : submeshes) {
+            if (sm.vertexCount == 0 || (uint64_t)sm.vertexOffset + sm.vertexCount > vertexCount) return false;
+            if ((uint64_t)sm.indexOffset + sm.indexCount > indices.size()) return false;
+            for (uint32_t i = 0; i < sm.indexCount; ++i) {
+                uint32_t v = indices[sm.indexOffset + i];
+                if (v < sm.vertexOffset || v - sm.vertexOffset >= sm.vertexCount) return false;
+            }
+            ranges.emplace_back(sm.vertexOffset, sm.vertexOffset + sm.vertexCount);
+        }
+        std::sort(ranges.begin(), ranges.end());
+        for (size_t i = 1; i < ranges.size(); ++i) {
+            if (ranges[i].first < ranges[i - 1].second) return false;
+        }
+        return true;
+    }
+
+    // 頂点毎に逆量子化に使うサブメッシュ (範囲外の頂点は 0 番と同じ値を使う)
+    std::vector<uint32_t> DequantOwners(const std::vector<SubMesh>& submeshes, uint32_t vertexCount) {
+        std::vector<uint32_t> owner(vertexCount, 0);
+        for (uint32_t s = 0; s < (uint32_t)submeshes.size(); ++s) {
+            const SubMesh& sm = submeshes[s];
+            if ((uint64_t)sm.vertexOffset + sm.vertexCount > vertexCount) continue;
+            for (uint32_t v = 0; v < sm.vertexCount; ++v) owner[sm.vertexOffset + v] = s;
+        }
+        return owner;
+    }
+
+    void Bounds(const std::vector<ModelVertex>& vertices, uint32_t begin, uint32_t end, float scale[3], float bias[3]) {
+        float lo[3] = { INFINITY, INFINITY, INFINITY };
+        float hi[3] = { -INFINITY, -INFINITY, -INFINITY };
+        for (uint32_t v = begin; v < end; ++v) {
+            for (int a = 0; a < 3; ++a) {
+                lo[a] = std::min(lo[a], vertices[v].position[a]);
+                hi[a] = std::max(hi[a], vertices[v].position[a]);
+            }
+        }
+        for (int a = 0; a < 3; ++a) {
+            if (begin == end) { lo[a] = hi[a] = 0.0f; }
+            bias[a] = lo[a];
+            scale[a] = hi[a] - lo[a];
+        }
+    }
+
+    // 位置 / 法線 / 接線 / UV の共通部分 (PackedVertexFloatPos / PackedVertexQuantPos)
+    template <class V>
+    void EncodeAttributes(const ModelVertex& src, bool uvUnorm, V& dst) {
+        VertexPack::EncodeOct16(src.normal, dst.normal);
+        int8_t t[2];
+        VertexPack::EncodeOct8(src.tangent, t);
+        dst.tangent[0] = t[0];
+        dst.tangent[1] = t[1];
+        dst.tangent[2] = src.tangent[3] < 0.0f ? -127 : 127;
+        dst.tangent[3] = 0;
+        for (int i = 0; i < 2; ++i) {
+            dst.uv[i] = uvUnorm ? ToUnorm16(src.uv[i]) : DirectX::PackedVector::XMConvertFloatToHalf(src.uv[i]);
+        }
+    }
+
+    template <class V>
+    void DecodeAttributes(const V& src, bool uvUnorm, ModelVertex& dst) {
+        VertexPack::DecodeOct16(src.normal, dst.normal);
+        VertexPack::DecodeOct8(src.tangent, dst.tangent);
+        dst.tangent[3] = src.tangent[2] < 0 ? -1.0f : 1.0f;
+        for (int i = 0; i < 2; ++i) {
+            dst.uv[i] = uvUnorm ? src.uv[i] / 65535.0f : DirectX::PackedVector::XMConvertHalfToFloat(src.uv[i]);
+        }
+    }
+
+} // namespace
+
+namespace VertexPack {
+
+    void EncodeOct16(const float n[3], int16_t out[2]) { EncodeOct<32767>(n, out); }
+    void DecodeOct16(const int16_t in[2], float n[3]) { DecodeOct<32767>(in, n); }
+    void EncodeOct8(const float n[3], int8_t out[2]) { EncodeOct<127>(n, out); }
+    void DecodeOct8(const int8_t in[2], float n[3]) { DecodeOct<127>(in, n); }
+
+    bool Pack(const std::vector<ModelVertex>& vertices, const std::vector<uint32_t>& indices,
+        std::vector<SubMesh>& submeshes, bool hasSkin, bool quantizePositions, bool splitPosition,
+        PackedVertices& out, std::string& error) {
+
+        out = PackedVertices{};
+        const uint32_t count = (uint32_t)vertices.size();
+
+        bool uvUnorm = true;
+        for (const ModelVertex& v : vertices) {
+            for (int i = 0; i < 3; ++i) {
+                if (!std::isfinite(v.position[i])) {
+                    error = "non-finite position";
+                    return false;
+                }
+            }
+            for (int i = 0; i < 2; ++i) {
+                if (!std::isfinite(v.uv[i]) || std::fabs(v.uv[i]) > 65504.0f) {
+                    error = "UV out of half range";
+                    return false;
+                }
+                if (v.uv[i] < 0.0f || v.uv[i] > 1.0f) uvUnorm = false;
+            }
+            if (hasSkin) {
+                for (int i = 0; i < 4; ++i) {
+                    if (v.boneIndices[i] > 255) {
+                        error = "bone index > 255";
+                        return false;
+                    }
+                }
+            }
+        }
+        // サブメッシュが無いと逆量子化の値を置く場所が無い
+        if (submeshes.empty()) quantizePositions = false;
+
+        std::vector<float> scale(submeshes.size() * 3, 1.0f);
+        std::vector<float> bias(submeshes.size() * 3, 0.0f);
+        if (quantizePositions) {
+            if (RangesUsable(indices, submeshes, count)) {
+                for (size_t s = 0; s < submeshes.size(); ++s) {
+                    const SubMesh& sm = submeshes[s];
+                    Bounds(vertices, sm.vertexOffset, sm.vertexOffset + sm.vertexCount, &scale[s * 3], &bias[s * 3]);
+                }
+            }
+            else {
+                float ms[3], mb[3];
+                Bounds(vertices, 0, count, ms, mb);
+                for (size_t s = 0; s < submeshes.size(); ++s) {
+                    memcpy(&scale[s * 3], ms, sizeof(ms));
+                    memcpy(&bias[s * 3], mb, sizeof(mb));
+                }
+            }
+        }
+
+        PackedVertexLayout& layout = out.layout;
+        layout.flags = (quantizePositions ? VertexPack_QuantizedPosition : 0) |
+            (uvUnorm ? VertexPack_UVUnorm16 : 0) |
+            (hasSkin ? VertexPack_Skinned : 0);
+        layout.baseStride = quantizePositions ? (uint32_t)sizeof(PackedVertexQuantPos) : (uint32_t)sizeof(PackedVertexFloatPos);
+        layout.skinStride = hasSkin ? (uint32_t)sizeof(PackedSkin) : 0;
+        out.base.resize((size_t)count * layout.baseStride);
+        out.skin.resize((size_t)count * layout.skinStride);
+
+        const std::vector<uint32_t> owner = quantizePositions ? DequantOwners(submeshes, count) : std::vector<uint32_t>();
+        for (uint32_t i = 0; i < count; ++i) {
+            const ModelVertex& src = vertices[i];
+            if (quantizePositions) {
+                PackedVertexQuantPos v{};
+                const float* s = &scale[owner[i] * 3];
+                const float* b = &bias[owner[i] * 3];
+                for (int a = 0; a < 3; ++a) {
+                    v.position[a] = s[a] > 0.0f ? ToUnorm16(((double)src.position[a] - b[a]) / s[a]) : 0;
+                }
+                EncodeAttributes(src, uvUnorm, v);
+                memcpy(&out.base[(size_t)i * sizeof(v)], &v, sizeof(v));
+            }
+            else {
+                PackedVertexFloatPos v{};
+                memcpy(v.position, src.position, sizeof(v.position));
+                EncodeAttributes(src, uvUnorm, v);
+                memcpy(&out.base[(size_t)i * sizeof(v)], &v, sizeof(v));
+            }
+            if (hasSkin) {
+                PackedSkin k{};
+                for (int j = 0; j < 4; ++j) k.boneIndices[j] = (uint8_t)src.boneIndices[j];
+                QuantizeWeights(src.boneWeights, k.boneWeights);
+                memcpy(&out.skin[(size_t)i * sizeof(k)], &k, sizeof(k));
+            }
+        }
+
+        if (splitPosition) {
+            std::vector<uint8_t> interleaved = std::move(out.base);
+            SetSplitPosition(layout, interleaved.data(), count, true, out.layout, out.base);
+        }
+
+        for (size_t s = 0; s < submeshes.size(); ++s) {
+            memcpy(submeshes[s].posScale, &scale[s * 3], sizeof(submeshes[s].posScale));
+            memcpy(submeshes[s].posBias, &bias[s * 3], sizeof(submeshes[s].posBias));
+        }
+        return true;
+    }
+
+    void SetSplitPosition(const PackedVertexLayout& layout, const uint8_t* base, uint32_t vertexCount, bool split,
+        PackedVertexLayout& outLayout, std::vector<uint8_t>& outBase) {
+
+        const bool isSplit = (layout.flags & VertexPack_SplitPosition) != 0;
+        const size_t stride = layout.baseStride;
+        const size_t posStride = PositionStride(layout);
+        outLayout = layout;
+        outLayout.flags = split ? (layout.flags | VertexPack_SplitPosition) : (layout.flags & ~VertexPack_SplitPosition);
+        outBase.resize((size_t)vertexCount * stride);
+        if (isSplit == split) {
+            if (!outBase.empty()) memcpy(outBase.data(), base, outBase.size());
+            return;
+        }
+        const size_t attrStride = stride - posStride;
+        const size_t attrPlane = (size_t)vertexCount * posStride;
+        for (size_t i = 0; i < vertexCount; ++i) {
+            uint8_t* dst = outBase.data();
+            if (split) {
+                memcpy(dst + i * posStride, base + i * stride, posStride);
+                memcpy(dst + attrPlane + i * attrStride, base + i * stride + posStride, attrStride);
+            }
+            else {
+                memcpy(dst + i * stride, base + i * posStride, posStride);
+                memcpy(dst + i * stride + posStride, base + attrPlane + i * attrStride, attrStride);
+            }
+        }
+    }
+
+    void Unpack(const PackedVertexLayout& layout, const uint8_t* base, const uint8_t* skin, uint32_t vertexCount,
+        const std::vector<SubMesh>& submeshes, std::vector<ModelVertex>& out) {
+
+        out.assign(vertexCount, ModelVertex{});
+        std::vector<uint8_t> interleaved;
+        if (layout.flags & VertexPack_SplitPosition) {
+            PackedVertexLayout tmp;
+            SetSplitPosition(layout, base, vertexCount, false, tmp, interleaved);
+            base = interleaved.data();
+        }
+        const bool quantized = (layout.flags & VertexPack_QuantizedPosition) != 0;
+        const bool uvUnorm = (layout.flags & VertexPack_UVUnorm16) != 0;
+        const std::vector<uint32_t> owner = quantized ? DequantOwners(submeshes, vertexCount) : std::vector<uint32_t>();
+        static const SubMesh kIdentity;
+
+        for (uint32_t i = 0; i < vertexCount; ++i) {
+            ModelVertex& dst = out[i];
+            if (quantized) {
+                PackedVertexQuantPos v;
+                memcpy(&v, base + (size_t)i * sizeof(v), sizeof(v));
+                const SubMesh& sm = submeshes.empty() ? kIdentity : submeshes[owner[i]];
+                for (int a = 0; a < 3; ++a) dst.position[a] = sm.posBias[a] + sm.posScale[a] * (v.position[a] / 65535.0f);
+                DecodeAttributes(v, uvUnorm, dst);
+            }
+            else {
+                PackedVertexFloatPos v;
+                memcpy(&v, base + (size_t)i * sizeof(v), sizeof(v));
+                memcpy(dst.position, v.position, sizeof(v.position));
+                DecodeAttributes(v, uvUnorm, dst);
+            }
+            if (skin && layout.skinStride) {
+                PackedSkin k;
+                memcpy(&k, skin + (size_t)i * sizeof(k), sizeof(k));
+                for (int j = 0; j < 4; ++j) {
+                    dst.boneIndices[j] = k.boneIndices[j];
+                    dst.boneWeights[j] = k.boneWeights[j] / 255.0f;
+                }
+            }
+        }
+    }
+
+    bool Validate(const std::vector<ModelVertex>& original, const std::vector<SubMesh>& submeshes,
+        const PackedVertices& packed, VertexPackReport& report) {
+
+        report = VertexPackReport{};
+        const PackedVertexLayout& layout = packed.layout;
+        const uint32_t count = (uint32_t)original.size();
+        report.layout = layout;
+        report.vertexCount = count;
+        report.fullBytes = (size_t)count * sizeof(ModelVertex);
+        report.packedBytes = packed.base.size() + packed.skin.size();
+        if (packed.base.size() != (size_t)count * layout.baseStride ||
+            packed.skin.size() != (size_t)count * layout.skinStride) {
+            report.passed = false;
+            report.failure = "stream size mismatch";
+            return false;
+        }
+
+        std::vector<ModelVertex> decoded;
+        Unpack(layout, packed.base.data(), packed.skin.empty() ? nullptr : packed.skin.data(), count, submeshes, decoded);
+
+        const bool quantized = (layout.flags & VertexPack_QuantizedPosition) != 0;
+        const bool uvUnorm = (layout.flags & VertexPack_UVUnorm16) != 0;
+        const std::vector<uint32_t> owner = quantized ? DequantOwners(submeshes, count) : std::vector<uint32_t>();
+        auto fail = [&](const std::string& what) {
+            if (report.passed) report.failure = what;
+            report.passed = false;
+        };
+
+        for (uint32_t i = 0; i < count; ++i) {
+            const ModelVertex& a = original[i];
+            const ModelVertex& b = decoded[i];
+
+            // 位置: float はそのまま, unorm16 は軸毎に範囲の 1/131070 (+ float の丸め)
+            double dist2 = 0.0, extent = 0.0;
+            for (int k = 0; k < 3; ++k) {
+                double d = std::fabs((double)a.position[k] - b.position[k]);
+                dist2 += d * d;
+                double bound = 0.0;
+                if (quantized) {
+                    const SubMesh& sm = submeshes[owner[i]];
+                    extent = std::max(extent, (double)sm.posScale[k]);
+                    bound = sm.posScale[k] * (0.5 / 65535.0) + 1e-6 * (std::fabs(sm.posBias[k]) + std::fabs(sm.posScale[k])) + 1e-30;
+                }
+                if (d > bound) fail("position axis " + std::to_string(k) + " at vertex " + std::to_string(i));
+            }
+            double dist = std::sqrt(dist2);
+            report.maxPositionError = std::max(report.maxPositionError, dist);
+            if (extent > 0.0) report.maxPositionErrorRel = std::max(report.maxPositionErrorRel, dist / extent);
+
+            float na[3];
+            if (Normalize(a.normal, na)) {
+                double deg = AngleDeg(na, b.normal);
+                report.maxNormalDeg = std::max(report.maxNormalDeg, deg);
+                if (deg > kMaxNormalDeg) fail("normal at vertex " + std::to_string(i));
+            }
+            float ta[3];
+            if (Normalize(a.tangent, ta)) {
+                double deg = AngleDeg(ta, b.tangent);
+                report.maxTangentDeg = std::max(report.maxTangentDeg, deg);
+                if (deg > kMaxTangentDeg) fail("tangent at vertex " + std::to_string(i));
+                if ((a.tangent[3] < 0.0f) != (b.tangent[3] < 0.0f)) {
+                    report.tangentSignErrors++;
+                    fail("tangent sign at vertex " + std::to_string(i));
+                }
+            }
+
+            for (int k = 0; k < 2; ++k) {
+                double d = std::fabs((double)a.uv[k] - b.uv[k]);
+                report.maxUVError = std::max(report.maxUVError, d);
+                // half は仮数 10 ビットなので値の 2^-11 (非正規化数は 2^-25) まで
+                double bound = uvUnorm ? 0.5 / 65535.0 + 1e-7 : std::max(std::fabs((double)a.uv[k]) * (1.0 / 2048.0), 1.0 / 33554432.0);
+                if (d > bound) fail("uv at vertex " + std::to_string(i));
+            }
+
+            if (layout.skinStride) {
+                double sum = 0.0;
+                for (int k = 0; k < 4; ++k) sum += std::max(a.boneWeights[k], 0.0f);
+                for (int k = 0; k < 4; ++k) {
+                    double expect = sum > 0.0 ? std::max(a.boneWeights[k], 0.0f) / sum : 0.0;
+                    double d = std::fabs(expect - b.boneWeights[k]);
+                    report.maxWeightError = std::max(report.maxWeightError, d);
+                    if (d > kMaxWeightError + 1e-9) fail("weight at vertex " + std::to_string(i));
+                    if (a.boneIndices[k] != b.boneIndices[k]) {
+                        report.boneIndexErrors++;
+                        fail("bone index at vertex " + std::to_string(i));
+                    }
+                }
+            }
+        }
+        return report.passed;
+    }
+
+    bool SelfTest(std::string& log) {
+        std::mt19937 rng(12345);
+        std::normal_distribution<float> gauss(0.0f, 1.0f);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        // 3 つのサブメッシュ: 原点から離れた小さな範囲 / 広い範囲 / 1 軸が平ら
+        const uint32_t perSubmesh = 6000;
+        std::vector<ModelVertex> vertices;
+        std::vector<uint32_t> indices;
+        std::vector<SubMesh> submeshes;
+        std::vector<std::vector<float>> dirs = {
+            { 1,0,0 }, { -1,0,0 }, { 0,1,0 }, { 0,-1,0 }, { 0,0,1 }, { 0,0,-1 },
+            { 1,1,1 }, { -1,1,-1 }, { 1,-1,-1 }, { -1,-1,1 },
+            { 1e-4f, 1e-4f, -1 }, { 0.5f, 0.5f, -1e-5f }, { -0.5f, 0.5f, 1e-5f }, { 0.7f, -0.0f, -0.7f },
+        };
+        for (uint32_t s = 0; s < 3; ++s) {
+            SubMesh sm;
+            sm.vertexOffset = (uint32_t)vertices.size();
+            sm.vertexCount = perSubmesh;
+            sm.indexOffset = (uint32_t)indices.size();
+            for (uint32_t i = 0; i < perSubmesh; ++i) {
+                ModelVertex v{};
+                for (int a = 0; a < 3; ++a) {
+                    if (s == 0) v.position[a] = 1000.0f + unit(rng) * 0.01f;
+                    else if (s == 1) v.position[a] = (unit(rng) - 0.5f) * 100.0f;
+                    else v.position[a] = a == 2 ? -3.0f : unit(rng) * 5.0f;
+                }
+                const size_t d = (size_t)s * perSubmesh + i;
+                if (d < dirs.size()) {
+                    for (int a = 0; a < 3; ++a) v.normal[a] = v.tangent[a] = dirs[d][a];
+                }
+                else {
+                    for (int a = 0; a < 3; ++a) {
+                        v.normal[a] = gauss(rng);
+                        v.tangent[a] = gauss(rng);
+                    }
+                }
+                v.tangent[3] = (i & 1) ? -1.0f : 1.0f;
+                v.uv[0] = (i == 0) ? 0.0f : (i == 1) ? 1.0f : unit(rng);
+                v.uv[1] = (i == 0) ? 1.0f : (i == 1) ? 0.0f : unit(rng);
+                for (int k = 0; k < 4; ++k) v.boneIndices[k] = rng() % 256;
+                switch (i % 5) {
+                case 0: v.boneWeights[0] = 1.0f; break;
+                case 1: for (float& w : v.boneWeights) w = 0.25f; break;
+                case 2: v.boneWeights[0] = v.boneWeights[1] = v.boneWeights[2] = 1.0f / 3.0f; break;
+                case 3: break; // ウェイト無し
+                default: for (float& w : v.boneWeights) w = unit(rng); break;
+                }
+                vertices.push_back(v);
+            }
+            for (uint32_t i = 0; i + 2 < perSubmesh; i += 3) {
+                indices.push_back(sm.vertexOffset + i);
+                indices.push_back(sm.vertexOffset + i + 1);
+                indices.push_back(sm.vertexOffset + i + 2);
+            }
+            sm.indexCount = (uint32_t)indices.size() - sm.indexOffset;
+            submeshes.push_back(sm);
+        }
+        // [0,1] を超える UV (half になる)
+        std::vector<ModelVertex> tiled = vertices;
+        for (ModelVertex& v : tiled) {
+            v.uv[0] = v.uv[0] * 8.0f - 3.0f;
+            v.uv[1] = v.uv[1] * 2.0f;
+        }
+
+        bool ok = true;
+        char line[256];
+        for (int uvCase = 0; uvCase < 2; ++uvCase) {
+            for (int skin = 0; skin < 2; ++skin) {
+                for (int quant = 0; quant < 4; ++quant) {
+                    const std::vector<ModelVertex>& src = uvCase ? tiled : vertices;
+                    std::vector<SubMesh> sms = submeshes;
+                    PackedVertices packed;
+                    VertexPackReport r;
+                    std::string error;
+                    bool packedOk = Pack(src, indices, sms, skin != 0, (quant & 1) != 0, (quant & 2) != 0, packed, error);
+                    bool valid = packedOk && Validate(src, sms, packed, r);
+                    ok = ok && valid;
+                    snprintf(line, sizeof(line),
+                        "%-32s %2u+%u B  pos=%.2e (rel %.2e) n=%.4f deg t=%.3f deg uv=%.2e w=%.2e  %s %s\n",
+                        LayoutName(packed.layout).c_str(), packed.layout.baseStride, packed.layout.skinStride,
+                        r.maxPositionError, r.maxPositionErrorRel, r.maxNormalDeg, r.maxTangentDeg, r.maxUVError, r.maxWeightError,
+                        valid ? "PASS" : "FAIL", packedOk ? r.failure.c_str() : error.c_str());
+                    log += line;
+                }
+            }
+        }
+
+        // 255 を超えるボーン番号は詰めずに断る
+        {
+            std::vector<ModelVertex> bad = vertices;
+            bad[7].boneIndices[2] = 256;
+            std::vector<SubMesh> sms = submeshes;
+            PackedVertices packed;
+            std::string error;
+            bool rejected = !Pack(bad, indices, sms, true, false, false, packed, error);
+            ok = ok && rejected;
+            log += std::string("bone index 256 rejected: ") + (rejected ? "PASS" : "FAIL") + "\n";
+        }
+        return ok;
+    }
+
+    std::string LayoutName(const PackedVertexLayout& layout) {
+        if (layout.baseStride == 0) return "ModelVertex (float)";
+        std::string name = (layout.flags & VertexPack_QuantizedPosition) ? "pos16" : "pos32";
+        name += " n16 t8 ";
+        name += (layout.flags & VertexPack_UVUnorm16) ? "uv16" : "uvh";
+        if (layout.flags & VertexPack_Skinned) name += " skin8";
+        if (layout.flags & VertexPack_SplitPosition) name += " split";
+        return name;
+    }
+
+    std::string StreamsName(const ModelSharedResource& model) {
+        std::string name;
+        for (const VertexStream& stream : model.streams) {
+            const char* kind = "full";
+            switch (stream.kind) {
+            case VertexStreamKind::Full:       kind = "full"; break;
+            case VertexStreamKind::Packed:     kind = "packed"; break;
+            case VertexStreamKind::Position:   kind = "pos"; break;
+            case VertexStreamKind::Attributes: kind = "attr"; break;
+            case VertexStreamKind::Skin:       kind = "skin"; break;
+            }
+            if (!name.empty()) name += " + ";
+            name += kind + std::to_string(stream.stride);
+        }
+        return name;
+    }
+
+} // namespace VertexPack
@@ -0,0 +1,125 @@
+// VertexPack
+// ModelVertex (88 バイト) を GPU 向けに詰めた頂点へ変換する / 元へ戻す。
+//   位置   : float3 (12) または unorm16x4 (8, サブメッシュ毎の範囲 SubMesh::posScale / posBias で逆量子化)
+//   法線   : 八面体写像 snorm16x2 (4)
+//   接線   : 八面体写像 snorm8x2 + 従法線の向き snorm8 (4)
+//   UV     : unorm16x2 (全 UV が [0,1] の時) または half2 (4)
+//   スキン : ボーン番号 uint8x4 + ウェイト unorm8x4 (8, 別ストリーム)
+// スキン無しのメッシュは 24 バイト (位置を量子化すると 20 バイト) になる。
+// VertexPack_SplitPosition では位置だけを先にまとめ、その後ろに法線 / 接線 / UV (12 バイト) を並べる
+// (深度だけの描画で位置のストリームだけを読めるように)。
+// 復号は入力レイアウトの形式変換と VS_ModelPacked.hlsl で行う
+
+#ifndef VERTEXPACK_H
+#define VERTEXPACK_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "AssetTypes.h"
+
+enum VertexPackFlags : uint32_t {
+    VertexPack_QuantizedPosition = 1 << 0,
+    VertexPack_UVUnorm16 = 1 << 1,   // 無ければ half2
+    VertexPack_Skinned = 1 << 2,
+    VertexPack_SplitPosition = 1 << 3, // base は [位置 * 頂点数][法線 / 接線 / UV * 頂点数] の順
+};
+
+#pragma pack(push,1)
+struct PackedVertexFloatPos {
+    float    position[3];
+    int16_t  normal[2];     // 八面体写像
+    int8_t   tangent[4];    // x, y: 八面体写像, z: 従法線の向き (±127), w: 0
+    uint16_t uv[2];         // unorm16 または half
+};
+static_assert(sizeof(PackedVertexFloatPos) == 24, "PackedVertexFloatPos size");
+
+struct PackedVertexQuantPos {
+    uint16_t position[4];   // unorm16 (w は 0)
+    int16_t  normal[2];
+    int8_t   tangent[4];
+    uint16_t uv[2];
+};
+static_assert(sizeof(PackedVertexQuantPos) == 20, "PackedVertexQuantPos size");
+
+struct PackedSkin {
+    uint8_t boneIndices[4];
+    uint8_t boneWeights[4]; // unorm8 (合計は 255 ちょうど, ウェイトの無い頂点は 0)
+};
+static_assert(sizeof(PackedSkin) == 8, "PackedSkin size");
+#pragma pack(pop)
+
+struct PackedVertices {
+    PackedVertexLayout layout;
+    std::vector<uint8_t> base; // layout.baseStride * 頂点数 (VertexPack_SplitPosition なら 2 面に分かれる)
+    std::vector<uint8_t> skin; // layout.skinStride * 頂点数
+};
+
+// 元の頂点と、詰めて戻した頂点の差 (Validate)
+struct VertexPackReport {
+    PackedVertexLayout layout;
+    uint32_t vertexCount = 0;
+    size_t fullBytes = 0;               // ModelVertex のままの頂点バッファ
+    size_t packedBytes = 0;
+    double maxPositionError = 0.0;      // モデル空間の距離
+    double maxPositionErrorRel = 0.0;   // サブメッシュの範囲 (最も長い辺) に対する比
+    double maxNormalDeg = 0.0;
+    double maxTangentDeg = 0.0;
+    double maxUVError = 0.0;
+    double maxWeightError = 0.0;
+    uint32_t tangentSignErrors = 0;
+    uint32_t boneIndexErrors = 0;
+    bool passed = true;
+    std::string failure;                // 許容誤差を最初に超えた項目
+};
+
+namespace VertexPack {
+
+    // Validate の許容誤差 (位置と UV は形式毎の丸め幅から求める)
+    constexpr double kMaxNormalDeg = 0.01;
+    constexpr double kMaxTangentDeg = 1.0;
+    constexpr double kMaxWeightError = 1.0 / 255.0;
+
+    // 位置を除いた部分 (法線 snorm16x2 + 接線 snorm8x4 + UV 16x2) のバイト数
+    constexpr uint32_t kAttributeStride = 12;
+    inline uint32_t PositionStride(const PackedVertexLayout& layout) {
+        return (layout.flags & VertexPack_QuantizedPosition) ? 8u : 12u;
+    }
+
+    void EncodeOct16(const float n[3], int16_t out[2]);
+    void DecodeOct16(const int16_t in[2], float n[3]);
+    void EncodeOct8(const float n[3], int8_t out[2]);
+    void DecodeOct8(const int8_t in[2], float n[3]);
+
+    // 頂点を詰める。サブメッシュの頂点範囲 (vertexOffset / vertexCount) が重ならず、
+    // インデックスがその中に収まっていればサブメッシュ毎に位置を量子化し、そうでなければモデル全体の範囲を使う。
+    // 成功時だけ submeshes の posScale / posBias を書き換える。
+    // ボーン番号が 255 を超える等で詰められない場合は false (ModelVertex のまま使う)
+    bool Pack(const std::vector<ModelVertex>& vertices, const std::vector<uint32_t>& indices,
+        std::vector<SubMesh>& submeshes, bool hasSkin, bool quantizePositions, bool splitPosition,
+        PackedVertices& out, std::string& error);
+
+    // 位置を分けた並びと交互の並びを相互に変換する (既に split の通りならコピーするだけ)
+    void SetSplitPosition(const PackedVertexLayout& layout, const uint8_t* base, uint32_t vertexCount, bool split,
+        PackedVertexLayout& outLayout, std::vector<uint8_t>& outBase);
+
+    // 詰めた頂点を ModelVertex へ戻す (tangent.w は ±1, スキン無しはボーン番号 / ウェイト 0)
+    void Unpack(const PackedVertexLayout& layout, const uint8_t* base, const uint8_t* skin, uint32_t vertexCount,
+        const std::vector<SubMesh>& submeshes, std::vector<ModelVertex>& out);
+
+    // 詰めた頂点を戻して元の頂点と比べ、誤差とバイト数を report へ書く。許容誤差内なら true
+    bool Validate(const std::vector<ModelVertex>& original, const std::vector<SubMesh>& submeshes,
+        const PackedVertices& packed, VertexPackReport& report);
+
+    // 境界値 (軸方向 / 八面体の折り返し付近 / UV の端 / ウェイトの丸め / 離れた位置の小さな範囲) と
+    // 乱数の頂点を全形式で Pack → Validate する。結果を 1 形式 1 行で log へ書く
+    bool SelfTest(std::string& log);
+
+    // "pos16 n16 t8 uv16 skin8 split" のような表示名
+    std::string LayoutName(const PackedVertexLayout& layout);
+    // "pos12 + attr12 + skin8" のような頂点ストリームの表示名
+    std::string StreamsName(const ModelSharedResource& model);
+
+} // namespace VertexPack
+
+#endif // VERTEXPACK_H
@@ -1,7 +1,12 @@
+#ifdef _WIN32
 #include <windows.h>
+#endif
 #include <iostream>
+#include <string>
+#include "HashUtill.h"
+#include "PakInspect.h"
 
-
+#ifdef _WIN32
 bool CallAssetPacker(const std::string& toolPath, const std::string& assetDir, const std::string& outputPak) {
     std::string cmd = "\"" + toolPath + "\" \"" + assetDir + "\" \"" + outputPak + "\"";
     STARTUPINFOA si = { sizeof(si) };
@@ -23,8 +28,55 @@ bool CallAssetPacker(const std::string& toolPath, const std::string& assetDir, c
 
     return (exitCode == 0);
 }
+#endif
+
+static void PrintUsage()
+{
+    std::cout << "gp@: cmd <command> ...\n";
+    std::cout << "  list <a.PixAssets> [--filter S] [--hash]   : Gg̈ꗗ (k / TCY / ItZbg)\n";
+    std::cout << "  cat <a.PixAssets> <path>                   : GgWJĕWo͂֏\n";
+    std::cout << "  extract <a.PixAssets> <out_dir> [--filter S] [--jobs N] : Ggt@C֓WJ\n";
+    std::cout << "  verify <a.PixAssets> [--jobs N] [--crc-only] : SGgWJ CRC32 / SHA-256 ƍ\n";
+    std::cout << "  diff <a.PixAssets> <b.PixAssets> [--summary] : ǉ / 폜 / ύXꂽGgƊi[TCY̑\n";
+#ifdef _WIN32
+    std::cout << "  pack [packer.exe] [input_dir] [output]     : pbJ[Ăяo (: Asset packaging tool.exe Assets assets.PixAssets)\n";
+#endif
+}
 
-int main()
+int main(int argc, char* argv[])
 {
-	CallAssetPacker("Asset packaging tool.exe", "Assets", "assets.PixAssets");
-}
\ No newline at end of file
+#ifdef _WIN32
+    SetConsoleOutputCP(CP_UTF8);
+#endif
+    if (argc < 2) {
+        PrintUsage();
+        return 1;
+    }
+    const std::string command = argv[1];
+    InspectOptions opt;
+    std::vector<std::string> args;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) opt.filter = argv[++i];
+        else if (arg == "--jobs" && i + 1 < argc) opt.jobs = (unsigned)std::stoul(argv[++i]);
+        else if (arg == "--hash") opt.showHash = true;
+        else if (arg == "--crc-only") opt.crcOnly = true;
+        else if (arg == "--summary") opt.summaryOnly = true;
+        else args.push_back(arg);
+    }
+    HashUtil::InitCRC32();
+
+    if (command == "list" && args.size() == 1) return PakList(args[0], opt);
+    if (command == "cat" && args.size() == 2) return PakCat(args[0], args[1]);
+    if (command == "extract" && args.size() == 2) return PakExtract(args[0], args[1], opt);
+    if (command == "verify" && args.size() == 1) return PakVerify(args[0], opt);
+    if (command == "diff" && args.size() == 2) return PakDiff(args[0], args[1], opt);
+#ifdef _WIN32
+    if (command == "pack" && args.size() <= 3) {
+        return CallAssetPacker(args.size() > 0 ? args[0] : "Asset packaging tool.exe",
+            args.size() > 1 ? args[1] : "Assets", args.size() > 2 ? args[2] : "assets.PixAssets") ? 0 : 1;
+    }
+#endif
+    PrintUsage();
+    return 1;
+}
@@ -0,0 +1,452 @@
+#include "PakInspect.h"
+#include "ArchiveFormat.h"
+#include "HashUtill.h"
+#include "LZ4Util.h"
+#include "PakToc.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <unordered_map>
+#include <sstream>
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct PakFile {
+    fs::path path;
+    PakHeader header{};
+    std::vector<TempFileEntry> entries;
+    std::vector<uint8_t> dict;
+    bool stdSha = false; // TOC の sha256 が標準の SHA-256 (v2 以前の非標準の値とは照合できない)
+    uint64_t fileSize = 0;
+};
+
+bool OpenPak(const fs::path& path, PakFile& pak) {
+    std::string err;
+    pak.path = path;
+    if (!ReadPakTOC(path, pak.header, pak.entries, err) || !ReadPakDictionary(path, pak.header, pak.dict, err)) {
+        std::cout << err << "\n";
+        return false;
+    }
+    pak.stdSha = pak.header.version >= 2 && HasFlag((uint16_t)pak.header.flags, AssetFlag_StdSHA256);
+    std::error_code ec;
+    pak.fileSize = (uint64_t)fs::file_size(path, ec);
+    return true;
+}
+
+const char* CompressionName(uint8_t c) {
+    switch ((AssetCompression)c) {
+    case AssetCompression::None: return "none";
+    case AssetCompression::LZ4: return "lz4";
+    case AssetCompression::LZ4Dict: return "lz4d";
+    }
+    return "?";
+}
+
+std::string ToHex(const uint8_t* bytes, size_t n) {
+    static const char* digits = "0123456789abcdef";
+    std::string s;
+    s.reserve(n * 2);
+    for (size_t i = 0; i < n; ++i) {
+        s += digits[bytes[i] >> 4];
+        s += digits[bytes[i] & 15];
+    }
+    return s;
+}
+
+// パッカーと同じく '\\' → '/' と ASCII 小文字化 (TOC のパスはこの形で格納されている)
+std::string NormalizeName(const std::string& name) {
+    std::string s = name;
+    for (auto& c : s) {
+        if (c == '\\') c = '/';
+        else if (c >= 'A' && c <= 'Z') c = (char)(c - 'A' + 'a');
+    }
+    return s;
+}
+
+double MB(uint64_t bytes) { return bytes / (1024.0 * 1024.0); }
+
+// 符号付きのバイト差分 (+1.25 MB / -512 B など)
+std::string FormatDelta(int64_t delta) {
+    std::ostringstream os;
+    os << (delta >= 0 ? "+" : "-");
+    uint64_t a = (uint64_t)(delta >= 0 ? delta : -delta);
+    if (a >= 1024 * 1024) os << std::fixed << std::setprecision(2) << MB(a) << " MB";
+    else if (a >= 1024) os << std::fixed << std::setprecision(1) << a / 1024.0 << " KB";
+    else os << a << " B";
+    return os.str();
+}
+
+// ワーカー毎の読み込み状態 (ファイルハンドルと使い回すバッファ)
+struct Reader {
+    std::ifstream in;
+    std::vector<uint8_t> stored;
+    std::vector<uint8_t> decoded;
+};
+
+bool ReadStored(Reader& r, const TempFileEntry& e) {
+    r.stored.resize((size_t)e.storedSize);
+    if (e.storedSize == 0) return true;
+    r.in.clear();
+    r.in.seekg((std::streamoff)e.offset, std::ios::beg);
+    return (bool)r.in.read(reinterpret_cast<char*>(r.stored.data()), (std::streamsize)e.storedSize);
+}
+
+// r.stored を展開する。非圧縮なら r.stored をそのまま指す
+bool Decode(const PakFile& pak, const TempFileEntry& e, Reader& r, const uint8_t*& data, std::string& err) {
+    switch ((AssetCompression)e.compression) {
+    case AssetCompression::None:
+        if (e.storedSize != e.originalSize) {
+            err = "格納サイズが元のサイズと違います";
+            return false;
+        }
+        data = r.stored.data();
+        return true;
+    case AssetCompression::LZ4:
+        r.decoded.resize((size_t)e.originalSize);
+        if (!LZ4Util::DecompressChunked(r.stored.data(), r.stored.size(), r.decoded.data(), r.decoded.size())) {
+            err = "LZ4 展開失敗";
+            return false;
+        }
+        data = r.decoded.data();
+        return true;
+    case AssetCompression::LZ4Dict:
+        if (pak.dict.empty()) {
+            err = "LZ4Dict ですが辞書がありません";
+            return false;
+        }
+        r.decoded.resize((size_t)e.originalSize);
+        if (!LZ4Util::DecompressBlockDict(pak.dict.data(), pak.dict.size(), r.stored.data(), r.stored.size(),
+            r.decoded.data(), r.decoded.size())) {
+            err = "LZ4Dict 展開失敗";
+            return false;
+        }
+        data = r.decoded.data();
+        return true;
+    }
+    err = "未対応の圧縮種別 " + std::to_string(e.compression);
+    return false;
+}
+
+// [0, count) を jobs 個のワーカーで処理する。items は呼び出し側でオフセット順に並べておき、
+// 先頭から順に取り合うのでワーカー全体としてはファイルを前から読むことになる
+template <class F>
+void ParallelFor(const fs::path& path, size_t count, unsigned jobs, F&& body) {
+    if (jobs == 0) jobs = std::max(1u, std::thread::hardware_concurrency());
+    jobs = (unsigned)std::min<size_t>(jobs, std::max<size_t>(count, 1));
+    std::atomic<size_t> next{ 0 };
+    auto worker = [&] {
+        Reader r;
+        r.in.open(path, std::ios::binary);
+        for (size_t i; (i = next.fetch_add(1)) < count;) body(i, r);
+    };
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < jobs; ++t) threads.emplace_back(worker);
+    worker();
+    for (auto& t : threads) t.join();
+}
+
+double ElapsedSec(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// パス → エントリ (TOC の順は v3 ではパスハッシュ順なので、表示用に名前順へ並べ直す)
+std::vector<const TempFileEntry*> SortedByName(const PakFile& pak) {
+    std::vector<const TempFileEntry*> v;
+    v.reserve(pak.entries.size());
+    for (const auto& e : pak.entries) v.push_back(&e);
+    std::sort(v.begin(), v.end(), [](const TempFileEntry* a, const TempFileEntry* b) {
+        return a->relativePath < b->relativePath;
+    });
+    return v;
+}
+
+} // namespace
+
+int PakList(const fs::path& path, const InspectOptions& opt) {
+    PakFile pak;
+    if (!OpenPak(path, pak)) return 1;
+
+    // 格納データを共有しているエントリ (重複排除) は 2 つ目以降に '=' を付ける
+    std::map<std::pair<uint64_t, uint64_t>, size_t> payloads;
+    uint64_t original = 0, stored = 0, shared = 0;
+    size_t shown = 0;
+    std::cout << std::setw(5) << "comp" << std::setw(14) << "original" << std::setw(14) << "stored"
+        << std::setw(8) << "ratio" << std::setw(14) << "offset" << "  path\n";
+    for (const TempFileEntry* e : SortedByName(pak)) {
+        bool alias = ++payloads[{ e->offset, e->storedSize }] > 1 && e->storedSize > 0;
+        if (!opt.filter.empty() && e->relativePath.find(opt.filter) == std::string::npos) continue;
+        ++shown;
+        original += e->originalSize;
+        if (alias) shared += e->storedSize;
+        else stored += e->storedSize;
+        std::cout << std::setw(5) << CompressionName(e->compression)
+            << std::setw(14) << e->originalSize << std::setw(14) << e->storedSize
+            << std::setw(7) << std::fixed << std::setprecision(1)
+            << (e->originalSize ? e->storedSize * 100.0 / e->originalSize : 100.0) << "%"
+            << std::setw(14) << e->offset << (alias ? " =" : "  ") << e->relativePath;
+        if (opt.showHash) {
+            std::cout << "  crc=" << std::hex << std::setw(8) << std::setfill('0') << e->crc32
+                << std::dec << std::setfill(' ') << " sha=" << ToHex(e->sha256.data(), 32);
+        }
+        std::cout << "\n";
+    }
+    std::cout << "-- " << shown << " / " << pak.entries.size() << " entries, original " << std::fixed
+        << std::setprecision(2) << MB(original) << " MB, stored " << MB(stored) << " MB";
+    if (shared) std::cout << " (+" << MB(shared) << " MB shared)";
+    std::cout << "\n-- v" << pak.header.version << ", align=" << pak.header.alignment
+        << ", flags=0x" << std::hex << pak.header.flags << std::dec
+        << ", dict=" << pak.dict.size() << " B, file " << MB(pak.fileSize) << " MB\n";
+    return 0;
+}
+
+int PakCat(const fs::path& path, const std::string& name) {
+    PakFile pak;
+    if (!OpenPak(path, pak)) return 1;
+    const std::string norm = NormalizeName(name);
+    auto it = std::find_if(pak.entries.begin(), pak.entries.end(),
+        [&](const TempFileEntry& e) { return e.relativePath == norm; });
+    if (it == pak.entries.end()) {
+        std::cerr << "エントリがありません: " << name << "\n";
+        return 1;
+    }
+    Reader r;
+    r.in.open(path, std::ios::binary);
+    const uint8_t* data = nullptr;
+    std::string err;
+    if (!ReadStored(r, *it)) err = "読込失敗";
+    if (!err.empty() || !Decode(pak, *it, r, data, err)) {
+        std::cerr << err << ": " << name << "\n";
+        return 1;
+    }
+#ifdef _WIN32
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    if (it->originalSize && fwrite(data, 1, (size_t)it->originalSize, stdout) != it->originalSize) return 1;
+    fflush(stdout);
+    return 0;
+}
+
+int PakExtract(const fs::path& path, const fs::path& outDir, const InspectOptions& opt) {
+    PakFile pak;
+    if (!OpenPak(path, pak)) return 1;
+
+    std::vector<const TempFileEntry*> items;
+    for (const auto& e : pak.entries) {
+        if (!opt.filter.empty() && e.relativePath.find(opt.filter) == std::string::npos) continue;
+        // アーカイブの外へ書き出すパス (絶対パス / "..") は展開しない
+        fs::path rel(e.relativePath);
+        bool unsafe = rel.is_absolute() || rel.has_root_name() || rel.has_root_directory();
+        for (const auto& part : rel) unsafe |= part == "..";
+        if (unsafe) {
+            std::cout << "展開しません (不正なパス): " << e.relativePath << "\n";
+            continue;
+        }
+        items.push_back(&e);
+    }
+    std::sort(items.begin(), items.end(),
+        [](const TempFileEntry* a, const TempFileEntry* b) { return a->offset < b->offset; });
+
+    // フォルダはワーカーが取り合わないよう先に作る
+    std::error_code ec;
+    for (const TempFileEntry* e : items) fs::create_directories((outDir / e->relativePath).parent_path(), ec);
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::mutex outMtx;
+    std::atomic<uint64_t> written{ 0 };
+    std::atomic<size_t> failed{ 0 };
+    ParallelFor(path, items.size(), opt.jobs, [&](size_t i, Reader& r) {
+        const TempFileEntry& e = *items[i];
+        const uint8_t* data = nullptr;
+        std::string err;
+        if (!ReadStored(r, e)) err = "読込失敗";
+        else if (Decode(pak, e, r, data, err)) {
+            std::ofstream ofs(outDir / e.relativePath, std::ios::binary | std::ios::trunc);
+            if (!ofs || (e.originalSize && !ofs.write(reinterpret_cast<const char*>(data), (std::streamsize)e.originalSize)))
+                err = "書込失敗";
+        }
+        if (!err.empty()) {
+            ++failed;
+            std::lock_guard<std::mutex> lk(outMtx);
+            std::cout << err << ": " << e.relativePath << "\n";
+            return;
+        }
+        written += e.originalSize;
+    });
+    double sec = ElapsedSec(t0);
+    std::cout << "展開: " << items.size() - failed << " / " << items.size() << " files, " << std::fixed
+        << std::setprecision(2) << MB(written) << " MB in " << sec << " s ("
+        << std::setprecision(1) << (sec > 0 ? MB(written) / sec : 0.0) << " MB/s) -> " << outDir.string() << "\n";
+    return failed ? 1 : 0;
+}
+
+int PakVerify(const fs::path& path, const InspectOptions& opt) {
+    PakFile pak;
+    if (!OpenPak(path, pak)) return 1;
+    const bool checkSha = pak.stdSha && !opt.crcOnly;
+
+    // 格納データを共有するエントリは 1 度だけ読み、残りは TOC のハッシュが同じかだけ見る
+    std::vector<const TempFileEntry*> items;
+    std::map<std::pair<uint64_t, uint64_t>, const TempFileEntry*> owners;
+    std::vector<std::string> failures;
+    for (const auto& e : pak.entries) {
+        auto ins = owners.emplace(std::make_pair(e.offset, e.storedSize), &e);
+        if (ins.second || e.storedSize == 0) {
+            items.push_back(&e);
+            continue;
+        }
+        const TempFileEntry& o = *ins.first->second;
+        if (o.crc32 != e.crc32 || o.originalSize != e.originalSize || o.compression != e.compression ||
+            (pak.stdSha && o.sha256 != e.sha256))
+            failures.push_back("共有先とハッシュが違います: " + e.relativePath + " (" + o.relativePath + ")");
+    }
+    const size_t aliases = pak.entries.size() - items.size();
+    std::sort(items.begin(), items.end(),
+        [](const TempFileEntry* a, const TempFileEntry* b) { return a->offset < b->offset; });
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::mutex failMtx;
+    std::atomic<uint64_t> readBytes{ 0 }, hashedBytes{ 0 };
+    ParallelFor(path, items.size(), opt.jobs, [&](size_t i, Reader& r) {
+        const TempFileEntry& e = *items[i];
+        const uint8_t* data = nullptr;
+        std::string err;
+        if (!ReadStored(r, e)) err = "読込失敗";
+        else if (Decode(pak, e, r, data, err)) {
+            readBytes += e.storedSize;
+            hashedBytes += e.originalSize;
+            size_t n = (size_t)e.originalSize;
+            if (HashUtil::CalcCRC32(data, n) != e.crc32) err = "CRC32 不一致";
+            else if (checkSha && HashUtil::SHA256(data, n) != e.sha256) err = "SHA-256 不一致";
+        }
+        if (!err.empty()) {
+            std::lock_guard<std::mutex> lk(failMtx);
+            failures.push_back(err + ": " + e.relativePath);
+        }
+    });
+    double sec = ElapsedSec(t0);
+
+    std::sort(failures.begin(), failures.end());
+    for (const auto& f : failures) std::cout << f << "\n";
+    std::cout << "検証: " << pak.entries.size() << " entries (" << items.size() << " payloads, "
+        << aliases << " shared), " << (checkSha ? "CRC32 + SHA-256" : "CRC32") << "\n";
+    if (!checkSha && !opt.crcOnly) std::cout << "  (標準 SHA-256 の無いアーカイブなので CRC32 のみ)\n";
+    std::cout << "  read " << std::fixed << std::setprecision(2) << MB(readBytes) << " MB, hashed "
+        << MB(hashedBytes) << " MB in " << sec << " s (" << std::setprecision(1)
+        << (sec > 0 ? MB(hashedBytes) / sec : 0.0) << " MB/s, " << HashUtil::GetCRC32ImplName();
+    if (checkSha) std::cout << " / " << HashUtil::GetSHA256ImplName();
+    std::cout << ")\n";
+    std::cout << (failures.empty() ? "OK" : "NG: " + std::to_string(failures.size()) + " errors") << "\n";
+    return failures.empty() ? 0 : 1;
+}
+
+int PakDiff(const fs::path& pathA, const fs::path& pathB, const InspectOptions& opt) {
+    PakFile a, b;
+    if (!OpenPak(pathA, a) || !OpenPak(pathB, b)) return 1;
+    // 両方が標準 SHA-256 なら SHA-256、そうでなければ CRC32 + サイズで内容を比べる
+    const bool bySha = a.stdSha && b.stdSha;
+    auto contentKey = [&](const TempFileEntry& e) {
+        if (bySha) return ToHex(e.sha256.data(), 32);
+        return std::to_string(e.crc32) + ":" + std::to_string(e.originalSize);
+    };
+
+    HashUtil::StringMap<const TempFileEntry*> mapA, mapB;
+    for (const auto& e : a.entries) mapA.emplace(e.relativePath, &e);
+    for (const auto& e : b.entries) mapB.emplace(e.relativePath, &e);
+
+    struct Line { std::string path; char mark; std::string text; };
+    std::vector<Line> lines;
+    std::vector<const TempFileEntry*> added, removed;
+    size_t changed = 0, recompressed = 0, unchanged = 0, renamed = 0;
+    int64_t changedDelta = 0, recompressedDelta = 0, patchBytes = 0;
+    auto sizes = [](const TempFileEntry& e) {
+        return std::to_string(e.originalSize) + " B (stored " + std::to_string(e.storedSize) + " B, " +
+            CompressionName(e.compression) + ")";
+    };
+
+    for (const auto& e : b.entries) {
+        auto it = mapA.find(e.relativePath);
+        if (it == mapA.end()) {
+            added.push_back(&e);
+            continue;
+        }
+        const TempFileEntry& o = *it->second;
+        int64_t storedDelta = (int64_t)e.storedSize - (int64_t)o.storedSize;
+        if (contentKey(o) == contentKey(e)) {
+            // 内容は同じで格納形式だけ変わったもの (圧縮設定や辞書の違い)
+            if (o.storedSize != e.storedSize || o.compression != e.compression) {
+                ++recompressed;
+                recompressedDelta += storedDelta;
+                lines.push_back({ e.relativePath, '~', "stored " + std::to_string(o.storedSize) + " -> " +
+                    std::to_string(e.storedSize) + " (" + FormatDelta(storedDelta) + ", " +
+                    CompressionName(o.compression) + " -> " + CompressionName(e.compression) + ")" });
+            }
+            else ++unchanged;
+            continue;
+        }
+        ++changed;
+        changedDelta += storedDelta;
+        patchBytes += (int64_t)e.storedSize;
+        lines.push_back({ e.relativePath, 'M', "original " + std::to_string(o.originalSize) + " -> " +
+            std::to_string(e.originalSize) + " (" + FormatDelta((int64_t)e.originalSize - (int64_t)o.originalSize) +
+            "), stored " + std::to_string(o.storedSize) + " -> " + std::to_string(e.storedSize) +
+            " (" + FormatDelta(storedDelta) + ")" });
+    }
+    for (const auto& e : a.entries) {
+        if (mapB.find(e.relativePath) == mapB.end()) removed.push_back(&e);
+    }
+
+    // 削除と追加で内容が同じものは名前の変更として表示する (パッチには格納データが必要)
+    std::unordered_map<std::string, std::vector<const TempFileEntry*>> removedByContent;
+    for (const TempFileEntry* e : removed) removedByContent[contentKey(*e)].push_back(e);
+    int64_t addedBytes = 0, removedBytes = 0;
+    for (const TempFileEntry* e : added) {
+        patchBytes += (int64_t)e->storedSize;
+        auto it = removedByContent.find(contentKey(*e));
+        if (it != removedByContent.end() && !it->second.empty()) {
+            const TempFileEntry* from = it->second.back();
+            it->second.pop_back();
+            ++renamed;
+            lines.push_back({ e->relativePath, 'R', "<- " + from->relativePath + ", " + sizes(*e) });
+            continue;
+        }
+        addedBytes += (int64_t)e->storedSize;
+        lines.push_back({ e->relativePath, '+', sizes(*e) });
+    }
+    size_t removedCount = 0;
+    for (auto& kv : removedByContent) {
+        for (const TempFileEntry* e : kv.second) {
+            ++removedCount;
+            removedBytes += (int64_t)e->storedSize;
+            lines.push_back({ e->relativePath, '-', sizes(*e) });
+        }
+    }
+
+    if (!opt.summaryOnly) {
+        std::sort(lines.begin(), lines.end(), [](const Line& x, const Line& y) { return x.path < y.path; });
+        for (const auto& l : lines) std::cout << l.mark << " " << l.path << "  " << l.text << "\n";
+    }
+    std::cout << "-- " << pathA.string() << " (" << a.entries.size() << " entries) -> " << pathB.string()
+        << " (" << b.entries.size() << " entries), compared by " << (bySha ? "SHA-256" : "CRC32 + size") << "\n";
+    std::cout << "   added:        " << std::setw(6) << added.size() - renamed << "  " << FormatDelta(addedBytes) << "\n";
+    std::cout << "   removed:      " << std::setw(6) << removedCount << "  " << FormatDelta(-removedBytes) << "\n";
+    std::cout << "   changed:      " << std::setw(6) << changed << "  " << FormatDelta(changedDelta) << "\n";
+    std::cout << "   renamed:      " << std::setw(6) << renamed << "\n";
+    std::cout << "   recompressed: " << std::setw(6) << recompressed << "  " << FormatDelta(recompressedDelta) << "\n";
+    std::cout << "   unchanged:    " << std::setw(6) << unchanged << "\n";
+    std::cout << "   file size: " << FormatDelta((int64_t)b.fileSize - (int64_t)a.fileSize)
+        << ", patch (added + changed stored): " << std::fixed << std::setprecision(2) << MB((uint64_t)patchBytes) << " MB\n";
+    return 0;
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <filesystem>
+#include <string>
+
+// .PixAssets (PIXPAK v1-v3) の中身を調べるサブコマンド。
+// ArchiveFormat.h / PakToc / HashUtill / LZ4Util はパッカーのソースをそのまま使う。
+// 標準ライブラリだけで書いているので Windows 以外でもビルドできる。戻り値は終了コード
+
+struct InspectOptions {
+    unsigned jobs = 0;        // verify / extract のワーカー数 (0: 論理コア数)
+    std::string filter;       // list / extract: パスにこの文字列を含むエントリだけ
+    bool showHash = false;    // list: CRC32 / SHA-256 も表示する
+    bool crcOnly = false;     // verify: SHA-256 を省いて CRC32 だけ確かめる
+    bool summaryOnly = false; // diff: エントリ毎の行を出さず集計だけ表示する
+};
+
+int PakList(const std::filesystem::path& pak, const InspectOptions& opt);
+// name のエントリを展開して標準出力へ書く
+int PakCat(const std::filesystem::path& pak, const std::string& name);
+int PakExtract(const std::filesystem::path& pak, const std::filesystem::path& outDir, const InspectOptions& opt);
+// 全エントリを並列に読んで展開し、TOC の CRC32 / SHA-256 と照合する
+int PakVerify(const std::filesystem::path& pak, const InspectOptions& opt);
+// a → b で追加 / 削除 / 変更 (内容のハッシュで判定) されたエントリと格納サイズの増減を表示する
+int PakDiff(const std::filesystem::path& a, const std::filesystem::path& b, const InspectOptions& opt);